@@ -0,0 +1,141 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Cached Object Allocator
+ * ----------------------------------------------------------------------------
+ * File       : CacheAllocator.h
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Allocator which recycles fixed size objects through per thread magazines
+ * backed by a lock free global free list. Intended for use with
+ * std::allocate_shared for frequently created control objects.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_CACHE_ALLOCATOR_H__
+#define __ROGUE_CACHE_ALLOCATOR_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <new>
+
+#include "rogue/RingQueue.h"
+
+namespace rogue {
+
+//! Object cache for blocks of a fixed size
+/** Each thread keeps a small magazine of free blocks. Allocation and release
+ * are served from the magazine without any shared state. An empty magazine is
+ * refilled from, and a full magazine is drained to, a lock free global free
+ * list so that blocks released by a consumer thread are returned to producers.
+ * Blocks which do not fit in the global list are returned to the heap.
+ */
+template <std::size_t Size>
+class ObjectCache {
+    static const uint32_t MagazineSize = 64;
+    static const uint32_t DepotSize    = 8192;
+
+    struct Magazine {
+        bool valid;
+        uint32_t count;
+        void* items[MagazineSize];
+
+        Magazine() : valid(true), count(0) {}
+
+        // Blocks released after thread exit go straight to the global list
+        ~Magazine() {
+            valid = false;
+            while (count > 0) release(items[--count]);
+        }
+    };
+
+    // Global list is never destroyed so that blocks released during static destruction are safe
+    static rogue::RingQueue<void*>& depot() {
+        static rogue::RingQueue<void*>* depot = new rogue::RingQueue<void*>(DepotSize);
+        return *depot;
+    }
+
+    static Magazine& local() {
+        static thread_local Magazine mag;
+        return mag;
+    }
+
+    static void release(void* ptr) {
+        if (!depot().tryPush(ptr)) ::operator delete(ptr);
+    }
+
+  public:
+    //! Get a free block
+    static void* get() {
+        Magazine& mag = local();
+        void* ptr;
+
+        if (mag.valid) {
+            while (mag.count < MagazineSize / 2 && depot().tryPop(ptr)) mag.items[mag.count++] = ptr;
+            if (mag.count > 0) return mag.items[--mag.count];
+        } else if (depot().tryPop(ptr)) {
+            return ptr;
+        }
+        return ::operator new(Size);
+    }
+
+    //! Return a block to the cache
+    static void put(void* ptr) {
+        Magazine& mag = local();
+
+        if (!mag.valid) {
+            release(ptr);
+            return;
+        }
+
+        if (mag.count == MagazineSize)
+            while (mag.count > MagazineSize / 2) release(mag.items[--mag.count]);
+
+        mag.items[mag.count++] = ptr;
+    }
+};
+
+//! Allocator for use with std::allocate_shared which recycles objects through an ObjectCache
+template <typename T>
+class CacheAllocator {
+  public:
+    typedef T value_type;
+
+    CacheAllocator() {}
+
+    template <typename U>
+    CacheAllocator(const CacheAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        if (n != 1) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(rogue::ObjectCache<sizeof(T)>::get());
+    }
+
+    void deallocate(T* ptr, std::size_t n) {
+        if (n != 1)
+            ::operator delete(ptr);
+        else
+            rogue::ObjectCache<sizeof(T)>::put(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const CacheAllocator<U>&) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const CacheAllocator<U>&) const {
+        return false;
+    }
+};
+}  // namespace rogue
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <exception>
 #include <memory>
 #include <mutex>
@@ -55,10 +56,19 @@ class Logging {
     //! List of filters
     static std::vector<rogue::LogFilter*> filters_;
 
+    //! Incremented when the global level or filters change
+    static std::atomic<uint32_t> config_;
+
     void intLog(uint32_t level, const char* format, va_list args);
 
+    //! Compute local level from global level and filters, lock must be held
+    void intLevel();
+
     //! Local logging level
-    uint32_t level_;
+    std::atomic<uint32_t> level_;
+
+    //! Configuration the local level was computed from
+    std::atomic<uint32_t> localConfig_;
 
     //! Logger name
     std::string name_;
@@ -79,6 +89,11 @@ class Logging {
     static void setLevel(uint32_t level);
     static void setFilter(std::string filter, uint32_t level);
 
+    //! Recompute the local level if the global level or filters have changed
+    /** Used by long lived loggers which are shared between many objects.
+     */
+    void refreshLevel();
+
     void log(uint32_t level, const char* fmt, ...);
     void critical(const char* fmt, ...);
     void error(const char* fmt, ...);
@@ -93,6 +93,16 @@ class Queue {
         pushCond_.notify_all();
     }
 
+    bool tryPop(T& data) {
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (queue_.empty()) return false;
+        data = queue_.front();
+        queue_.pop();
+        busy_ = (thold_ > 0 && queue_.size() >= thold_);
+        pushCond_.notify_all();
+        return true;
+    }
+
     T pop() {
         T ret;
         std::unique_lock<std::mutex> lock(mtx_);
@@ -0,0 +1,278 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Lock Free Ring Queue
+ * ----------------------------------------------------------------------------
+ * File       : RingQueue.h
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Bounded lock free ring buffer queue for Rogue. Provides the same interface
+ * as rogue::Queue so it can be used as a drop in replacement on hot paths.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_RING_QUEUE_H__
+#define __ROGUE_RING_QUEUE_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rogue {
+
+//! Bounded lock free ring queue
+/** Each slot carries a sequence number which is used to hand the slot between
+ * producers and consumers without a lock. With MultiProducer set to false the
+ * push side assumes a single producer thread (SPSC) and skips the compare and
+ * swap on the tail index. The pop side always supports concurrent callers so
+ * that reset() can be called from any thread.
+ *
+ * Threads which find the queue full or empty spin briefly, then yield, and
+ * finally block on a condition variable. The mutex is only taken on this slow
+ * path and by the opposite side when a waiter is registered.
+ */
+template <typename T, bool MultiProducer = true>
+class RingQueue {
+  public:
+    //! Default number of slots
+    static const uint32_t DefaultCapacity = 4096;
+
+  private:
+    // Number of spin and yield iterations before blocking
+    static const uint32_t SpinCount  = 128;
+    static const uint32_t YieldCount = 16;
+
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        T data;
+    };
+
+    std::vector<Slot> ring_;
+    uint64_t mask_;
+
+    // Producer and consumer indexes padded onto separate cache lines
+    uint8_t pad0_[64];
+    std::atomic<uint64_t> tail_;
+    uint8_t pad1_[64];
+    std::atomic<uint64_t> head_;
+    uint8_t pad2_[64];
+
+    std::atomic<uint32_t> pushWaiters_;
+    std::atomic<uint32_t> popWaiters_;
+    std::mutex mtx_;
+    std::condition_variable pushCond_;
+    std::condition_variable popCond_;
+
+    std::atomic<uint32_t> max_;
+    std::atomic<uint32_t> thold_;
+    std::atomic<bool> busy_;
+    std::atomic<bool> run_;
+
+    void updateBusy() {
+        uint32_t thold = thold_.load(std::memory_order_relaxed);
+        busy_.store(thold > 0 && size() >= thold, std::memory_order_relaxed);
+    }
+
+    // Wake the other side if it has registered as a waiter
+    void wake(std::atomic<uint32_t>& waiters, std::condition_variable& cond) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            cond.notify_all();
+        }
+    }
+
+    static uint64_t roundCapacity(uint32_t capacity) {
+        uint64_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    bool full() {
+        uint32_t max = max_.load(std::memory_order_relaxed);
+        return (max > 0 && size() >= max);
+    }
+
+  public:
+    //! Create a queue, capacity is rounded up to the next power of two
+    explicit RingQueue(uint32_t capacity = DefaultCapacity) : ring_(roundCapacity(capacity)) {
+        uint64_t x;
+
+        mask_ = ring_.size() - 1;
+
+        for (x = 0; x <= mask_; x++) ring_[x].seq.store(x, std::memory_order_relaxed);
+
+        tail_        = 0;
+        head_        = 0;
+        pushWaiters_ = 0;
+        popWaiters_  = 0;
+        max_         = 0;
+        thold_       = 0;
+        busy_        = false;
+        run_         = true;
+    }
+
+    //! Return the number of slots
+    uint32_t capacity() {
+        return mask_ + 1;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        run_ = false;
+        pushCond_.notify_all();
+        popCond_.notify_all();
+    }
+
+    void setMax(uint32_t max) {
+        max_ = max;
+    }
+
+    void setThold(uint32_t thold) {
+        thold_ = thold;
+    }
+
+    //! Attempt to add an entry without blocking, returns false if full
+    bool tryPush(T const& data) {
+        uint64_t pos;
+        int64_t diff;
+        Slot* slot;
+
+        if (full()) return false;
+
+        pos = tail_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            slot = &ring_[pos & mask_];
+            diff = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)pos;
+
+            if (diff < 0) return false;
+
+            if (diff == 0) {
+                if (!MultiProducer) {
+                    tail_.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data = data;
+        slot->seq.store(pos + 1, std::memory_order_release);
+
+        updateBusy();
+        wake(popWaiters_, popCond_);
+        return true;
+    }
+
+    //! Attempt to remove an entry without blocking, returns false if empty
+    bool tryPop(T& data) {
+        uint64_t pos;
+        int64_t diff;
+        Slot* slot;
+
+        pos = head_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            slot = &ring_[pos & mask_];
+            diff = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)(pos + 1);
+
+            if (diff < 0) return false;
+
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        data       = slot->data;
+        slot->data = T();
+        slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+
+        updateBusy();
+        wake(pushWaiters_, pushCond_);
+        return true;
+    }
+
+    void push(T const& data) {
+        uint32_t x = 0;
+
+        while (run_.load(std::memory_order_relaxed)) {
+            if (tryPush(data)) return;
+
+            if (x < SpinCount) {
+                ++x;
+            } else if (x < SpinCount + YieldCount) {
+                ++x;
+                std::this_thread::yield();
+            } else {
+                std::unique_lock<std::mutex> lock(mtx_);
+                pushWaiters_.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (run_ && (full() || size() > mask_)) pushCond_.wait_for(lock, std::chrono::milliseconds(1));
+                pushWaiters_.fetch_sub(1);
+            }
+        }
+    }
+
+    bool empty() {
+        return size() == 0;
+    }
+
+    uint32_t size() {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        return (tail > head) ? (tail - head) : 0;
+    }
+
+    bool busy() {
+        return busy_.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        T data;
+        while (tryPop(data)) continue;
+        busy_ = false;
+    }
+
+    T pop() {
+        T ret;
+        uint32_t x = 0;
+
+        while (run_.load(std::memory_order_relaxed)) {
+            if (tryPop(ret)) return ret;
+
+            if (x < SpinCount) {
+                ++x;
+            } else if (x < SpinCount + YieldCount) {
+                ++x;
+                std::this_thread::yield();
+            } else {
+                std::unique_lock<std::mutex> lock(mtx_);
+                popWaiters_.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (run_ && empty()) popCond_.wait_for(lock, std::chrono::milliseconds(1));
+                popWaiters_.fetch_sub(1);
+            }
+        }
+        return ret;
+    }
+};
+}  // namespace rogue
+
+#endif
@@ -20,12 +20,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <thread>
 
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
+#include "rogue/hardware/MemWorkerPool.h"
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
@@ -37,6 +37,13 @@ namespace hardware {
 //! Raw Memory Map Class
 /** This class provides a bridge between the Rogue memory interface and
  * a standard Linux /dev/map interface.
+ *
+ * Register space is accessed with 32-bit words by default. Devices which
+ * accept wider accesses can enable 64-bit or 128-bit accesses with
+ * setAccessWidth(), which are used for the aligned portion of each
+ * transaction. A memory fence orders each transaction with the next.
+ *
+ * Transactions are serviced by a MemWorkerPool, returned by getWorkers().
  */
 class MemMap : public rogue::interfaces::memory::Slave {
     //! MemMap file descriptor
@@ -48,17 +55,24 @@ class MemMap : public rogue::interfaces::memory::Slave {
     //! Memory Mapped Pointer
     volatile uint8_t* map_;
 
+    //! Max register access width in bytes
+    std::atomic<uint32_t> width_;
+
+    //! Transaction statistics
+    std::atomic<uint64_t> tranCount_;
+    std::atomic<uint64_t> byteCount_;
+    std::atomic<uint64_t> tranTime_;
+
     // Logging
     std::shared_ptr<rogue::Logging> log_;
 
-    std::thread* thread_;
     bool threadEn_;
 
-    //! Thread background
-    void runThread();
+    //! Transaction workers
+    std::shared_ptr<rogue::hardware::MemWorkerPool> workers_;
 
-    // Queue
-    rogue::Queue<std::shared_ptr<rogue::interfaces::memory::Transaction>> queue_;
+    //! Service a transaction, called by the workers
+    void processTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
 
   public:
     //! Class factory which returns a MemMapPtr to a newly created MemMap object
@@ -83,6 +97,45 @@ class MemMap : public rogue::interfaces::memory::Slave {
 
     // Accept as transaction from the memory Master as defined in the Slave class.
     void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+    //! Get the transaction worker pool
+    std::shared_ptr<rogue::hardware::MemWorkerPool> getWorkers();
+
+    //! Set the max register access width
+    /** Exposed to Python as setAccessWidth()
+     * @param width Access width in bytes, 4, 8 or 16
+     */
+    void setAccessWidth(uint32_t width);
+
+    //! Get the max register access width in bytes
+    uint32_t getAccessWidth();
+
+    //! Get number of completed transactions
+    uint64_t getTranCount();
+
+    //! Get number of bytes transferred by completed transactions
+    uint64_t getByteCount();
+
+    //! Get time spent in register accesses in seconds
+    double getTranTime();
+
+    //! Get register access rate in bytes per second
+    double getTranRate();
+
+    //! Reset the transaction statistics
+    void resetStats();
+
+    //! Copy between mapped register space and memory
+    /** Register accesses use the widest access up to width which the register
+     * address alignment and the remaining size allow, down to 32 bits. The
+     * memory side may have any alignment. A memory fence follows the copy.
+     * @param reg Pointer to register space
+     * @param data Pointer to memory
+     * @param size Copy size in bytes, a multiple of 4, other sizes throw a GeneralError
+     * @param width Max access width in bytes, 4, 8 or 16
+     * @param write True to copy from memory to register space
+     */
+    static void regCopy(volatile uint8_t* reg, uint8_t* data, uint32_t size, uint32_t width, bool write);
 };
 
 //! Alias for using shared pointer as TcpClientPtr
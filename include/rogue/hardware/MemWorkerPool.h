@@ -0,0 +1,175 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Memory Transaction Worker Pool
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_HARDWARE_MEM_WORKER_POOL_H__
+#define __ROGUE_HARDWARE_MEM_WORKER_POOL_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Transaction.h"
+
+namespace rogue {
+namespace hardware {
+
+//! Memory Transaction Worker Pool
+/** This class queues the transactions of a memory mapped slave and services
+ * them with one or more worker threads.
+ *
+ * The address space is divided into regions of setRegionSize() bytes, by
+ * the start address of each transaction. A region is serviced by one worker
+ * at a time, in queue order, so transactions to the same region complete in
+ * the order they were posted while independent regions proceed in parallel.
+ * A worker takes the oldest transaction of an idle region together with up
+ * to setBatchSize() transactions of the same region which directly follow it
+ * in the queue. A single worker, the default, services the queue in the order
+ * the transactions were posted.
+ *
+ * The pool records the time each transaction waits in the queue and the time
+ * taken to service it.
+ */
+class MemWorkerPool {
+    //! Queued transaction
+    struct Entry {
+        std::shared_ptr<rogue::interfaces::memory::Transaction> tran;
+        uint64_t region;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    //! Transaction handler
+    std::function<void(std::shared_ptr<rogue::interfaces::memory::Transaction>)> handler_;
+
+    // Logging
+    std::shared_ptr<rogue::Logging> log_;
+
+    //! Queue and regions being serviced
+    std::deque<Entry> queue_;
+    std::set<uint64_t> busy_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    //! Serializes worker count changes
+    std::mutex ctrlMtx_;
+
+    std::vector<std::thread*> threads_;
+    bool threadEn_;
+    bool stopped_;
+
+    uint32_t regionBits_;
+    uint32_t batchSize_;
+
+    //! Statistics in nanoseconds
+    uint64_t tranCount_;
+    uint64_t queueTime_;
+    uint64_t queueMax_;
+    uint64_t serviceTime_;
+    uint64_t serviceMax_;
+
+    //! Worker thread
+    void runThread();
+
+    //! Start and stop the worker threads, control lock must be held
+    void startThreads(uint32_t count);
+    void stopThreads();
+
+  public:
+    //! Class factory which returns a MemWorkerPoolPtr to a newly created MemWorkerPool object
+    /** @param handler Function which services a transaction
+     * @param name Logger name
+     * @return MemWorkerPool pointer (MemWorkerPoolPtr)
+     */
+    static std::shared_ptr<rogue::hardware::MemWorkerPool> create(
+        std::function<void(std::shared_ptr<rogue::interfaces::memory::Transaction>)> handler,
+        std::string name);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Class Creator
+    MemWorkerPool(std::function<void(std::shared_ptr<rogue::interfaces::memory::Transaction>)> handler,
+                  std::string name);
+
+    // Destructor
+    ~MemWorkerPool();
+
+    //! Stop the workers, queued transactions are dropped and the pool can not be restarted
+    void stop();
+
+    //! Queue a transaction
+    void push(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+    //! Set the number of worker threads
+    /** Exposed to Python as setWorkerCount()
+     * @param count Number of workers, at least 1
+     */
+    void setWorkerCount(uint32_t count);
+
+    //! Get the number of worker threads
+    uint32_t getWorkerCount();
+
+    //! Set the size of the address regions which keep their order
+    /** Exposed to Python as setRegionSize()
+     * @param size Region size in bytes, a power of 2
+     */
+    void setRegionSize(uint64_t size);
+
+    //! Get the region size in bytes
+    uint64_t getRegionSize();
+
+    //! Set the max number of transactions a worker takes at once
+    void setBatchSize(uint32_t size);
+
+    //! Get the max number of transactions a worker takes at once
+    uint32_t getBatchSize();
+
+    //! Get the number of transactions waiting in the queue
+    uint32_t getQueueSize();
+
+    //! Get number of serviced transactions
+    uint64_t getTranCount();
+
+    //! Get mean time transactions waited in the queue, in seconds
+    double getQueueLatency();
+
+    //! Get max time a transaction waited in the queue, in seconds
+    double getQueueLatencyMax();
+
+    //! Get mean transaction service time, in seconds
+    double getServiceTime();
+
+    //! Get max transaction service time, in seconds
+    double getServiceTimeMax();
+
+    //! Reset the statistics
+    void resetStats();
+};
+
+//! Alias for using shared pointer as MemWorkerPoolPtr
+typedef std::shared_ptr<rogue::hardware::MemWorkerPool> MemWorkerPoolPtr;
+
+}  // namespace hardware
+}  // namespace rogue
+
+#endif
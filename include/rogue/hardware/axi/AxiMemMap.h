@@ -20,12 +20,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <thread>
 
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
+#include "rogue/hardware/MemWorkerPool.h"
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
@@ -40,36 +40,57 @@ namespace axi {
  * or Zynq AXI4 register space (using the rce_memmap driver). The driver
  * controls which space is available to the user. Multiple AxiMemMap classes
  * are allowed to be attached to the driver at the same time.
+ *
+ * By default each 32-bit register is accessed with a driver call. When a
+ * register window size is passed, the start of the register space is mapped
+ * into user space and transactions within the window are copied directly,
+ * using MemMap::regCopy() with the width set by setAccessWidth(). Transactions
+ * outside the window, or all transactions when the driver does not allow the
+ * mapping, use driver calls.
+ *
+ * Transactions are serviced by a MemWorkerPool, returned by getWorkers().
  */
 class AxiMemMap : public rogue::interfaces::memory::Slave {
     //! AxiMemMap file descriptor
     int32_t fd_;
 
+    //! Register window, NULL when not mapped
+    volatile uint8_t* map_;
+    uint32_t mapSize_;
+
+    //! Max register access width in bytes for the window
+    std::atomic<uint32_t> width_;
+
+    //! Transaction statistics
+    std::atomic<uint64_t> tranCount_;
+    std::atomic<uint64_t> byteCount_;
+    std::atomic<uint64_t> tranTime_;
+
     // Logging
     std::shared_ptr<rogue::Logging> log_;
 
-    std::thread* thread_;
     bool threadEn_;
 
-    //! Thread background
-    void runThread();
+    //! Transaction workers
+    std::shared_ptr<rogue::hardware::MemWorkerPool> workers_;
 
-    // Queue
-    rogue::Queue<std::shared_ptr<rogue::interfaces::memory::Transaction>> queue_;
+    //! Service a transaction, called by the workers
+    void processTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
 
   public:
     //! Class factory which returns a AxiMemMapPtr to a newly created AxiMemMap object
     /** Exposed to Python as rogue.hardware.axi.AxiMemMap()
      * @param path Path to device. i.e /dev/datadev_0
+     * @param mapSize Size of the register window to map, 0 to use driver calls only
      * @return AxiMemMap pointer (AxiMemMapPtr)
      */
-    static std::shared_ptr<rogue::hardware::axi::AxiMemMap> create(std::string path);
+    static std::shared_ptr<rogue::hardware::axi::AxiMemMap> create(std::string path, uint32_t mapSize = 0);
 
     // Setup class for use in python
     static void setup_python();
 
     // Class Creator
-    AxiMemMap(std::string path);
+    AxiMemMap(std::string path, uint32_t mapSize = 0);
 
     // Destructor
     ~AxiMemMap();
@@ -79,6 +100,36 @@ class AxiMemMap : public rogue::interfaces::memory::Slave {
 
     // Accept as transaction from the memory Master as defined in the Slave class.
     void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+    //! Get the transaction worker pool
+    std::shared_ptr<rogue::hardware::MemWorkerPool> getWorkers();
+
+    //! Set the max register access width for the window
+    /** Exposed to Python as setAccessWidth()
+     * @param width Access width in bytes, 4, 8 or 16
+     */
+    void setAccessWidth(uint32_t width);
+
+    //! Get the max register access width in bytes
+    uint32_t getAccessWidth();
+
+    //! Get the size of the mapped register window, 0 when not mapped
+    uint32_t getMapSize();
+
+    //! Get number of completed transactions
+    uint64_t getTranCount();
+
+    //! Get number of bytes transferred by completed transactions
+    uint64_t getByteCount();
+
+    //! Get time spent in register accesses in seconds
+    double getTranTime();
+
+    //! Get register access rate in bytes per second
+    double getTranRate();
+
+    //! Reset the transaction statistics
+    void resetStats();
 };
 
 //! Alias for using shared pointer as TcpClientPtr
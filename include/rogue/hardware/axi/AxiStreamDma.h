@@ -17,11 +17,16 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/hardware/axi/DmaEmulator.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -29,6 +34,35 @@ namespace rogue {
 namespace hardware {
 namespace axi {
 
+class AxiStreamDma;
+
+//! Buffer indexes waiting to be returned to the driver
+class AxiStreamDmaRetBatch {
+  public:
+    AxiStreamDmaRetBatch();
+
+    //! Protects the batch and the file descriptor
+    std::mutex mtx;
+
+    //! File descriptor the buffers are returned to, -1 once closed
+    int32_t fd;
+
+    //! Emulator owning the file descriptor, NULL for the driver
+    rogue::hardware::axi::DmaEmulatorPtr emu;
+
+    //! Buffer indexes
+    std::vector<uint32_t> index;
+
+    //! Time the oldest index was added
+    std::chrono::steady_clock::time_point first;
+
+    //! Number of indexes which triggers a return
+    uint32_t thold;
+
+    //! Max time an index waits before it is returned, in microseconds
+    uint32_t latency;
+};
+
 //! Storage class for shared memory buffers
 class AxiStreamDmaShared {
   public:
@@ -43,6 +77,9 @@ class AxiStreamDmaShared {
     //! Instance Counter
     int32_t openCount;
 
+    //! Protects the instance counter and the file descriptor
+    std::mutex openMtx;
+
     //! Pointer to zero copy buffers
     void** rawBuff;
 
@@ -54,6 +91,31 @@ class AxiStreamDmaShared {
 
     //! Zero copy is enabled
     bool zCopyEn;
+
+    //! Driver emulator for the path, NULL for the driver
+    rogue::hardware::axi::DmaEmulatorPtr emu;
+
+    //! Shared receive engine is enabled
+    bool rxShared;
+
+    //! Protects the receive destination list
+    std::mutex rxMtx;
+
+    //! Destination mask of the shared file descriptor
+    std::vector<uint8_t> rxMask;
+
+    //! Receivers of the shared engine by destination
+    std::map<uint32_t, rogue::hardware::axi::AxiStreamDma*> rxDest;
+
+    //! Shared receive thread
+    std::thread* rxThread;
+    bool rxThreadEn;
+
+    //! Receive thread released the last instance itself, it closes the file descriptor on exit
+    std::atomic<bool> rxSelfClose;
+
+    //! Buffers to return to the shared file descriptor
+    rogue::hardware::axi::AxiStreamDmaRetBatch ret;
 };
 
 //! Alias for using shared pointer as AxiStreamDmaSharedPtr
@@ -67,6 +129,18 @@ typedef std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> AxiStreamDmaSh
  * will allocate Frame and Buffer objects using memory mapped DMA buffers
  * or from a local memory pool when zero copy mode is disabled or a Frame
  * with is requested with the zero copy flag set to false.
+ *
+ * Zero copy buffers are returned to the driver in batches, once the batch
+ * reaches the return threshold or its oldest buffer reaches the return latency.
+ *
+ * By default each instance opens its own file descriptor and receive thread.
+ * When the shared receive engine is enabled for a device, all instances of the
+ * device use the file descriptor which maps the buffers, and a single thread
+ * reads all destinations and passes each frame to the instance for its
+ * destination.
+ *
+ * When a DmaEmulator exists for the path, the emulator is used in place of
+ * the device driver.
  */
 class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
     //! Shared memory buffer tracking
@@ -75,9 +149,15 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
     //! Max number of buffers to receive at once
     static const uint32_t RxBufferCount = 100;
 
+    //! Max number of buffers to return at once
+    static const uint32_t RetBufferCount = 1000;
+
     //! AxiStreamDma file descriptor
     std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> desc_;
 
+    //! Driver emulator, NULL for the driver
+    rogue::hardware::axi::DmaEmulatorPtr emu_;
+
     //! Process specific FD
     int32_t fd_;
 
@@ -99,11 +179,51 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
     //! Thread background
     void runThread(std::weak_ptr<int>);
 
-    //! Return queue
-    rogue::Queue<uint32_t> retQueue_;
+    //! Buffer received by the shared thread, passed on once the destination lock is released
+    struct SharedRx {
+        AxiStreamDma* inst;
+        std::shared_ptr<rogue::interfaces::stream::Buffer> buff;
+        int32_t size;
+        uint32_t flags;
+        uint32_t error;
+
+        SharedRx(AxiStreamDma* i,
+                 std::shared_ptr<rogue::interfaces::stream::Buffer> b,
+                 int32_t s,
+                 uint32_t f,
+                 uint32_t e)
+            : inst(i), buff(b), size(s), flags(f), error(e) {}
+    };
+
+    //! Shared receive thread background
+    static void runShared(rogue::hardware::axi::AxiStreamDmaShared* desc);
+
+    //! Frame being received
+    std::shared_ptr<rogue::interfaces::stream::Frame> rxFrame_;
+
+    //! Add a received buffer to the current frame, sends the frame when complete
+    void rxBuffer(std::shared_ptr<rogue::interfaces::stream::Buffer> buff,
+                  int32_t size,
+                  uint32_t flags,
+                  uint32_t error);
+
+    //! Buffer return batch, owned or shared
+    rogue::hardware::axi::AxiStreamDmaRetBatch* ret_;
 
-    //! Return thold
-    uint32_t retThold_;
+    //! Buffer return batch when the file descriptor is not shared
+    rogue::hardware::axi::AxiStreamDmaRetBatch ownRet_;
+
+    //! Return the buffers in a batch, all when force is set or once the latency has passed
+    static void retFlush(rogue::hardware::axi::AxiStreamDmaRetBatch* batch, bool force);
+
+    //! Return buffers to the driver or emulator, batch lock must be held
+    static int32_t retIndexes(rogue::hardware::axi::AxiStreamDmaRetBatch* batch, uint32_t count, uint32_t* indexes);
+
+    //! Register with the shared receive engine
+    void sharedOpen();
+
+    //! Unregister from the shared receive engine
+    void sharedClose();
 
     //! Open shared buffer space
     static std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared> openShared(std::string path,
@@ -112,6 +232,9 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
     //! Close shared buffer space
     static void closeShared(std::shared_ptr<rogue::hardware::axi::AxiStreamDmaShared>);
 
+    //! Close the file descriptor and unmap the buffers, open lock must be held
+    static void releaseShared(rogue::hardware::axi::AxiStreamDmaShared* desc);
+
   public:
     //! Class factory which returns a AxiStreamDmaPtr to a newly created AxiStreamDma object
     /** Exposed to Python as rogue.hardware.axi.AxiStreamDma()
@@ -148,6 +271,17 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
      */
     static void zeroCopyDisable(std::string path);
 
+    //! Enable the shared receive engine
+    /** All instances of the device receive through a single file descriptor
+     * and thread, instead of one per instance. Frames are passed to the
+     * instance matching the destination of the frame. Requires zero copy mode.
+     * This call must be made before the first AxiStreamDma device is created.
+     *
+     * Exposed to python as sharedRxEnable()
+     * @param path Path to device. i.e /dev/datadev_0
+     */
+    static void sharedRxEnable(std::string path);
+
     // Setup class in python
     static void setup_python();
 
@@ -191,6 +325,26 @@ class AxiStreamDma : public rogue::interfaces::stream::Master, public rogue::int
      */
     void dmaAck();
 
+    //! Set buffer return threshold
+    /** Zero copy buffers are returned to the driver once this many are
+     * waiting. When the shared receive engine is enabled this applies to all
+     * instances of the device.
+     *
+     * Exposed to python as setRetThold()
+     * @param count Number of buffers, 1 (the default) returns each buffer
+     * immediately. Limited to the 1000 buffers of a single driver call.
+     */
+    void setRetThold(uint32_t count);
+
+    //! Set buffer return latency
+    /** Waiting zero copy buffers are returned once the oldest has waited
+     * this long, checked by the receive thread about once per millisecond.
+     *
+     * Exposed to python as setRetLatency()
+     * @param latency Latency in microseconds
+     */
+    void setRetLatency(uint32_t latency);
+
     // Generate a Frame. Called from master
     std::shared_ptr<rogue::interfaces::stream::Frame> acceptReq(uint32_t size, bool zeroCopyEn);
 
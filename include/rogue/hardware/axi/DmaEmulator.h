@@ -0,0 +1,202 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : DMA Driver Emulator
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_HARDWARE_AXI_DMA_EMULATOR_H__
+#define __ROGUE_HARDWARE_AXI_DMA_EMULATOR_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rogue/EnableSharedFromThis.h"
+
+namespace rogue {
+namespace hardware {
+namespace axi {
+
+//! DMA Driver Emulator
+/** This class is a user space stand in for the aes-stream-drivers DMA driver,
+ * which allows the AxiStreamDma zero copy path to run without hardware. Once
+ * an emulator is created for a path, AxiStreamDma instances opened with the
+ * same path use the emulator instead of the device file. The emulator must
+ * be created before the first AxiStreamDma instance for the path.
+ *
+ * The emulator behaves as a hardware loopback. A buffer written to a
+ * destination is received by the file descriptor which has that destination
+ * in its mask, with the same size and flags. Buffers written by index are
+ * passed to the receiver without a copy, buffers written from user memory
+ * are copied into a free receive buffer. Buffers sent to a destination
+ * without a receiver are dropped.
+ *
+ * Each open returns an eventfd, so select() reports pending receive buffers
+ * as it does with the driver. Write readiness is always reported, calls
+ * waiting for a free buffer block for up to a millisecond before failing.
+ */
+class DmaEmulator : public rogue::EnableSharedFromThis<rogue::hardware::axi::DmaEmulator> {
+    //! Receive state of an open file descriptor
+    struct Handle {
+        std::vector<uint8_t> mask;
+        std::deque<uint32_t> queue;
+    };
+
+    //! Emulators by path
+    static std::mutex regMtx_;
+    static std::map<std::string, rogue::hardware::axi::DmaEmulator*> registry_;
+
+    //! Max number of destinations
+    static const uint32_t DestCount = 4096;
+
+    //! Max time to wait for a free buffer, in microseconds
+    static const uint32_t WaitTime = 1000;
+
+    std::string path_;
+    uint32_t rxCount_;
+    uint32_t txCount_;
+    uint32_t bSize_;
+
+    //! Buffer memory and pointers
+    uint8_t* mem_;
+    std::vector<void*> map_;
+
+    //! Received size, flags and destination of each buffer
+    std::vector<uint32_t> size_;
+    std::vector<uint32_t> flags_;
+    std::vector<uint32_t> dest_;
+
+    //! Free buffer indexes
+    std::vector<uint32_t> rxFree_;
+    std::vector<uint32_t> txFree_;
+
+    //! Open file descriptors and the file descriptor receiving each destination
+    std::map<int32_t, std::shared_ptr<Handle> > handles_;
+    std::vector<int32_t> destFd_;
+
+    uint64_t txBuffers_;
+    uint64_t rxBuffers_;
+    uint64_t dropBuffers_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    //! Lookup a file descriptor
+    std::shared_ptr<Handle> findHandle(int32_t fd);
+
+    //! Pass a written buffer to the receiver of the destination
+    void deliver(uint32_t index, uint32_t size, uint32_t flags, uint32_t dest);
+
+    //! Return a buffer to its free list
+    void freeIndex(uint32_t index);
+
+    //! Wait for a free buffer in the passed list
+    bool waitFree(std::unique_lock<std::mutex>& lock, std::vector<uint32_t>& list);
+
+  public:
+    //! Class factory which returns a pointer to a DmaEmulator (DmaEmulatorPtr)
+    /** Exposed as rogue.hardware.axi.DmaEmulator() to Python
+     *
+     * @param path Device path to emulate
+     * @param rxCount Number of receive buffers
+     * @param txCount Number of transmit buffers
+     * @param bSize Size of each buffer in bytes
+     */
+    static std::shared_ptr<rogue::hardware::axi::DmaEmulator> create(std::string path,
+                                                                     uint32_t rxCount,
+                                                                     uint32_t txCount,
+                                                                     uint32_t bSize);
+
+    //! Return the emulator for a path, NULL when the path is not emulated
+    static std::shared_ptr<rogue::hardware::axi::DmaEmulator> find(std::string path);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create the emulator
+    DmaEmulator(std::string path, uint32_t rxCount, uint32_t txCount, uint32_t bSize);
+
+    // Destroy the emulator
+    ~DmaEmulator();
+
+    //! Open a file descriptor, returns -1 on failure
+    int32_t open();
+
+    //! Close a file descriptor, buffers waiting to be read are freed
+    void close(int32_t fd);
+
+    //! Return the buffer pointers, matches dmaMapDma()
+    void** mapDma(uint32_t* count, uint32_t* size);
+
+    //! Return the buffer size in bytes
+    uint32_t getBuffSize();
+
+    //! Return the number of receive buffers
+    uint32_t getRxBuffCount();
+
+    //! Return the number of transmit buffers
+    uint32_t getTxBuffCount();
+
+    //! Set the destinations received by a file descriptor, matches dmaSetMaskBytes()
+    /** Fails when a destination is already received by another file descriptor.
+     */
+    int32_t setMaskBytes(int32_t fd, const uint8_t* mask);
+
+    //! Get a free transmit buffer index, matches dmaGetIndex()
+    int32_t getIndex(int32_t fd);
+
+    //! Write a buffer by index, matches dmaWriteIndex()
+    int32_t writeIndex(int32_t fd, uint32_t index, uint32_t size, uint32_t flags, uint32_t dest);
+
+    //! Write a buffer from user memory, matches dmaWrite()
+    /** Returns zero when no receive buffer is free.
+     */
+    int32_t write(int32_t fd, const void* buf, uint32_t size, uint32_t flags, uint32_t dest);
+
+    //! Read buffers by index, matches dmaReadBulkIndex()
+    int32_t readBulkIndex(int32_t fd,
+                          uint32_t count,
+                          int32_t* ret,
+                          uint32_t* index,
+                          uint32_t* flags,
+                          uint32_t* error,
+                          uint32_t* dest);
+
+    //! Read a buffer into user memory, matches dmaRead()
+    int32_t read(int32_t fd, void* buf, uint32_t maxSize, uint32_t* flags, uint32_t* error, uint32_t* dest);
+
+    //! Return buffers by index, matches dmaRetIndexes()
+    int32_t retIndexes(int32_t fd, uint32_t count, const uint32_t* indexes);
+
+    //! Get number of buffers written
+    uint64_t getTxCount();
+
+    //! Get number of buffers read
+    uint64_t getRxCount();
+
+    //! Get number of buffers dropped without a receiver
+    uint64_t getDropCount();
+};
+
+//! Alias for using shared pointer as DmaEmulatorPtr
+typedef std::shared_ptr<rogue::hardware::axi::DmaEmulator> DmaEmulatorPtr;
+
+}  // namespace axi
+}  // namespace hardware
+}  // namespace rogue
+
+#endif
@@ -158,6 +158,25 @@ class Block : public Master {
     // Get data to pointer from internal block or staged memory
     void getBytes(uint8_t* data, rogue::interfaces::memory::Variable* var, uint32_t index);
 
+    //////////////////////////////////////////
+    // Bulk list set/get helpers
+    //////////////////////////////////////////
+
+    // Verify a list range for bulk access
+    void checkList(const char* func, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    // Verify the range of values passed for bulk access
+    template <typename T>
+    void checkListValues(const char* func, rogue::interfaces::memory::Variable* var, const T* src, uint32_t count);
+
+    // Decode count list values starting at index with a single lock, conv converts each raw value
+    template <typename T, typename F>
+    void getListValues(T* dst, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count, F conv);
+
+    // Encode count list values starting at index with a single lock, conv converts each value to raw
+    template <typename T, typename F>
+    void setListValues(const T* src, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count, F conv);
+
     // Custom init function called after addVariables
     virtual void customInit();
 
@@ -249,6 +268,19 @@ class Block : public Master {
     bool blockPyTrans();
 
   private:
+    friend class BlockBatch;
+
+    // Check if the transaction type is valid for the current block state
+    bool validTransaction(uint32_t type, bool forceWr);
+
+    // Setup the transaction range for this block, called with the lock held
+    bool setupTransaction(uint32_t type,
+                          rogue::interfaces::memory::Variable* var,
+                          int32_t index,
+                          uint32_t& tOff,
+                          uint32_t& tSize,
+                          uint8_t*& tData);
+
     //! Start a c++ transaction for this block, internal version
     /** Start a c++ transaction with the passed type and access range
      *
@@ -377,6 +409,58 @@ class Block : public Master {
 
 #endif
 
+    //////////////////////////////////////////
+    // Bulk list access
+    //////////////////////////////////////////
+
+#ifndef NO_PYTHON
+
+    //! Get a range of a list variable as a numpy array, python version
+    /** Decodes count values starting at index with a single lock acquisition.
+     * A negative count returns all values from index to the end of the list.
+     *
+     * Exposed as _getArray() method of the Variable to Python
+     */
+    boost::python::object getArrayPy(rogue::interfaces::memory::Variable* var, int32_t index, int32_t count);
+
+#endif
+
+    //! Set count values of a list variable starting at index using unsigned int, C++ Version
+    void setUIntArray(const uint64_t* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Get count values of a list variable starting at index using unsigned int, C++ Version
+    void getUIntArray(uint64_t* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Set count values of a list variable starting at index using int, C++ Version
+    void setIntArray(const int64_t* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Get count values of a list variable starting at index using int, C++ Version
+    void getIntArray(int64_t* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Set count values of a list variable starting at index using bool, C++ Version
+    void setBoolArray(const bool* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Get count values of a list variable starting at index using bool, C++ Version
+    void getBoolArray(bool* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Set count values of a list variable starting at index using float, C++ Version
+    void setFloatArray(const float* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Get count values of a list variable starting at index using float, C++ Version
+    void getFloatArray(float* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Set count values of a list variable starting at index using double, C++ Version
+    void setDoubleArray(const double* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Get count values of a list variable starting at index using double, C++ Version
+    void getDoubleArray(double* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Set count values of a list variable starting at index using fixed point, C++ Version
+    void setFixedArray(const double* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //! Get count values of a list variable starting at index using fixed point, C++ Version
+    void getFixedArray(double* value, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
     //////////////////////////////////////////
     // Raw Bytes
     //////////////////////////////////////////
@@ -0,0 +1,188 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Memory Block Batch
+ * ----------------------------------------------------------------------------
+ * File       : BlockBatch.h
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Issues transactions for a list of blocks, merging address contiguous
+ * block ranges into larger transactions.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_MEMORY_BLOCK_BATCH_H__
+#define __ROGUE_INTERFACES_MEMORY_BLOCK_BATCH_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Block.h"
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace memory {
+
+class Slave;
+
+//! Memory Block batch transaction engine
+/** Issues a transaction of the same type for a list of Blocks. The ranges of
+ * the Blocks which share a Slave and are address contiguous are merged into a
+ * single transaction, up to the max access size of the Slave. All transactions
+ * are issued before any are waited on, and data from merged reads is copied
+ * back into each Block once complete.
+ *
+ * A merged transaction which fails is retried as one transaction per Block, so
+ * that errors are reported against the Block which caused them. Blocks are left
+ * in the same state as after Block::startTransaction(), so the results of each
+ * Block can be checked with Block::checkTransaction().
+ *
+ * The lock of every Block in the list is held, from setting up the transaction
+ * ranges until the merged transactions have completed, so the Block data can not
+ * change while it is gathered or scattered. The locks are taken in address order
+ * so concurrent batches with overlapping lists can not deadlock.
+ *
+ * Blocks which use python transactions are skipped.
+ */
+class BlockBatch {
+    // Block range for a transaction
+    struct Range {
+        rogue::interfaces::memory::Block* block;
+        rogue::interfaces::memory::Slave* slave;
+        uint64_t address;
+        uint32_t size;
+        uint8_t* data;
+    };
+
+    // Group of merged ranges
+    struct Group {
+        uint32_t first;
+        uint32_t count;
+        uint32_t size;
+        uint32_t max;
+        uint32_t stage;
+    };
+
+    // Serializes batches and protects the scratch storage
+    std::mutex mtx_;
+
+    // Scratch range and group lists
+    std::vector<Range> ranges_;
+    std::vector<Group> groups_;
+
+    // Blocks locked by the current batch, in address order
+    std::vector<rogue::interfaces::memory::Block*> locked_;
+
+    // Staging memory for merged transactions
+    std::vector<uint8_t> stage_;
+
+    // Statistics
+    std::atomic<uint64_t> blockCount_;
+    std::atomic<uint64_t> tranCount_;
+    std::atomic<uint64_t> mergeCount_;
+    std::atomic<uint64_t> byteCount_;
+    std::atomic<uint64_t> retryCount_;
+
+    // Log
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Merge address contiguous ranges into groups
+    void buildGroups();
+
+    // Issue the grouped transactions and wait for the merged ones to complete
+    void runGroups(uint32_t type);
+
+    // Lock each block once in address order
+    void lockBlocks(std::vector<std::shared_ptr<rogue::interfaces::memory::Block>>& blocks);
+
+    // Release the block locks
+    void unlockBlocks();
+
+  public:
+    //! Class factory which returns a pointer to a BlockBatch (BlockBatchPtr)
+    /** Exposed to Python as rogue.interfaces.memory.BlockBatch()
+     */
+    static std::shared_ptr<rogue::interfaces::memory::BlockBatch> create();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    // Create a BlockBatch
+    BlockBatch();
+
+    // Destroy the BlockBatch
+    ~BlockBatch();
+
+    //! Run a transaction for a list of blocks, C++ version
+    /** Returns once all merged transactions have completed. Transactions
+     * covering a single Block may still be in progress. When check is set the
+     * results of each Block are checked, otherwise Block::checkTransaction()
+     * must be called for each Block.
+     *
+     * @param blocks  List of Blocks
+     * @param type    Transaction type
+     * @param forceWr Force write of non-stale blocks
+     * @param check   Flag to indicate if the block results should be checked
+     */
+    void transaction(std::vector<std::shared_ptr<rogue::interfaces::memory::Block>> blocks,
+                     uint32_t type,
+                     bool forceWr,
+                     bool check);
+
+#ifndef NO_PYTHON
+
+    //! Run a transaction for a list of blocks, Python version
+    /** Variable updates are generated for each Block when check is set.
+     *
+     * Exposed as transaction() method to Python
+     */
+    void transactionPy(boost::python::object blocks, uint32_t type, bool forceWr, bool check);
+
+#endif
+
+    //! Get the number of block transactions requested
+    uint64_t getBlockCount();
+
+    //! Get the number of transactions issued to the slaves
+    uint64_t getTransactionCount();
+
+    //! Get the number of block transactions which were merged with another
+    uint64_t getMergeCount();
+
+    //! Get the number of bytes transferred
+    uint64_t getByteCount();
+
+    //! Get the number of merged transactions retried per block after an error
+    uint64_t getRetryCount();
+
+    //! Get the average number of block transactions per issued transaction
+    double getCoalesceRatio();
+
+    //! Reset the statistics
+    void resetStats();
+};
+
+//! Alias for using shared pointer as BlockBatchPtr
+typedef std::shared_ptr<rogue::interfaces::memory::BlockBatch> BlockBatchPtr;
+
+}  // namespace memory
+}  // namespace interfaces
+}  // namespace rogue
+
+#endif
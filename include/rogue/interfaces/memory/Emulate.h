@@ -23,7 +23,10 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -33,8 +36,6 @@
 #include <boost/python.hpp>
 #endif
 
-#define MAP_TYPE std::map<uint64_t, uint8_t*>
-
 namespace rogue {
 namespace interfaces {
 namespace memory {
@@ -42,14 +43,58 @@ namespace memory {
 //! Memory interface Emlator device
 /** This memory will respond to transactions, emilator hardware by responding to read
  * and write transactions.
+ *
+ * Pages are allocated on first access and located through a radix page table
+ * which is walked without locking. Copies to and from a page are protected by
+ * one of a set of striped locks, so masters accessing different pages do not
+ * serialize. A transaction which spans pages is not atomic across pages.
+ *
+ * The low part of the address space can optionally be backed by a memory
+ * mapped file, which keeps its contents between runs.
  */
 class Emulate : public Slave {
-    // Map to store 4K address space chunks
-    MAP_TYPE memMap_;
+    // Page table entry, points to the next level or to the page data
+    typedef std::atomic<void*> Entry;
+
+    // Address bits decoded by each page table level
+    static const uint32_t LevelBits = 12;
+
+    // Number of lock stripes for page data
+    static const uint32_t LockStripes = 64;
+
+    // Page size in bits
+    uint32_t pageBits_;
+
+    // Number of page table levels
+    uint32_t levels_;
+
+    // Root of the page table
+    Entry* root_;
 
-    // Lock
+    // Number of allocated pages
+    std::atomic<uint64_t> pageCount_;
+
+    // Page data locks
+    std::mutex stripes_[LockStripes];
+
+    // Configuration lock
     std::mutex mtx_;
 
+    // Backing file
+    std::string filePath_;
+    int fd_;
+    uint8_t* fileBase_;
+    uint64_t fileSize_;
+
+    // Allocate the page table root
+    void initTable();
+
+    // Free a page table node and everything below it
+    void freeNode(Entry* node, uint32_t level);
+
+    // Return the data of a page, allocating it on first access
+    uint8_t* findPage(uint64_t page);
+
   public:
     //! Class factory which returns a pointer to a Emulate (EmulatePtr)
     /** Exposed to Python as rogue.interfaces.memory.Emualte()
@@ -68,6 +113,34 @@ class Emulate : public Slave {
     // Destroy the Emulate
     ~Emulate();
 
+    //! Set the page size
+    /** Must be called before the first transaction.
+     *
+     * Exposed as setPageSize() to Python
+     *
+     * @param size Page size in bytes, a power of two from 64 bytes to 16MB
+     */
+    void setPageSize(uint32_t size);
+
+    //! Get the page size
+    uint32_t getPageSize();
+
+    //! Get the number of allocated pages, not including file backed memory
+    uint64_t getPageCount();
+
+    //! Back the low part of the address space with a file
+    /** Addresses below size are stored in the passed file, which is created
+     * if it does not exist and extended to size if it is smaller. Addresses
+     * above size use allocated pages. Must be called before the first
+     * transaction.
+     *
+     * Exposed as mapFile() to Python
+     *
+     * @param path File path
+     * @param size Size of the mapped region in bytes, a multiple of the page size
+     */
+    void mapFile(std::string path, uint64_t size);
+
     //! Handle the incoming memory transaction
     void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> transaction);
 };
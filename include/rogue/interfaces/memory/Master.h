@@ -29,6 +29,7 @@
 #include <thread>
 #include <vector>
 
+#include "rogue/CacheAllocator.h"
 #include "rogue/Logging.h"
 
 #ifndef NO_PYTHON
@@ -52,8 +53,13 @@ class Master {
     friend class Transaction;
 
   private:
-    //! Alias for map
-    typedef std::map<uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction> > TransactionMap;
+    //! Alias for map, map nodes are recycled
+    typedef std::map<
+        uint32_t,
+        std::shared_ptr<rogue::interfaces::memory::Transaction>,
+        std::less<uint32_t>,
+        rogue::CacheAllocator<std::pair<const uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction> > > >
+        TransactionMap;
 
     //! Transaction map
     TransactionMap tranMap_;
@@ -276,6 +282,35 @@ class Master {
 
 #endif
 
+    //! Helper function to gather scattered bits from a window of a byte array
+    /** The bits selected by mask in the little endian window of srcBytes (up
+     * to 8) bytes are packed, in ascending order, into the low bits of the
+     * dstBytes (up to 8) byte destination. Uses pext when available.
+     *
+     * Not exposed to Python
+     * @param dstData Destination byte array
+     * @param dstBytes Number of destination bytes to write
+     * @param srcData Source window
+     * @param srcBytes Number of bytes in the source window
+     * @param mask Bits to gather
+     */
+    static void extractBits(uint8_t* dstData, uint32_t dstBytes, uint8_t* srcData, uint32_t srcBytes, uint64_t mask);
+
+    //! Helper function to scatter bits into a window of a byte array
+    /** The low bits of the srcBytes (up to 8) byte source are placed, in
+     * ascending order, into the bits selected by mask in the little endian
+     * window of dstBytes (up to 8) bytes. Other window bits are unchanged.
+     * Uses pdep when available.
+     *
+     * Not exposed to Python
+     * @param dstData Destination window
+     * @param dstBytes Number of bytes in the destination window
+     * @param mask Bits to scatter into
+     * @param srcData Source byte array
+     * @param srcBytes Number of source bytes to read
+     */
+    static void depositBits(uint8_t* dstData, uint32_t dstBytes, uint64_t mask, uint8_t* srcData, uint32_t srcBytes);
+
 #ifndef NO_PYTHON
 
     //! Support >> operator in python
@@ -291,6 +326,14 @@ class Master {
     //! Internal transaction
     uint32_t intTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
 
+    //! Wait for a single transaction and return its error status
+    /** Unlike waitTransaction() the Master error status is not updated, allowing
+     * multiple threads to wait on their own transactions.
+     * @param id Id of transaction to wait for
+     * @return Error string, empty on success
+     */
+    std::string waitTransactionResult(uint32_t id);
+
   public:
     //! Wait for one or more transactions to complete
     /** This method is called to wait on transaction completion or timeout.
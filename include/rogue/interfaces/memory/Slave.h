@@ -23,8 +23,9 @@
 
 #include <stdint.h>
 
-#include <map>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
@@ -49,6 +50,10 @@ class Transaction;
  * Examples of Slave sub-class implementations are included elsewhere in this document.
  *
  * The Slave object provides mechanisms for tracking current transactions.
+ * Outstanding transactions are kept in a slot table indexed by transaction id and
+ * their timers are refreshed from a timer wheel, so looking up a transaction does
+ * not depend on the number of outstanding transactions. The Slave also keeps the
+ * outstanding transaction count and a histogram of completion latencies.
  */
 class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slave> {
     // Class instance counter
@@ -60,11 +65,64 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
     // Unique slave ID
     uint32_t id_;
 
-    // Alias for map
-    typedef std::map<uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction> > TransactionMap;
+    // Outstanding transaction slot
+    struct Slot {
+        std::shared_ptr<rogue::interfaces::memory::Transaction> tran;
+        uint32_t id;
+        std::chrono::steady_clock::time_point start;
+    };
 
-    // Transaction map
-    TransactionMap tranMap_;
+    // Slot table indexed by transaction id, allocated on the first transaction
+    std::vector<Slot> slots_;
+
+    // Slot table index mask
+    uint32_t slotMask_;
+
+    // Timer wheel entry, the entry is stale when the slot no longer holds the id
+    struct TimerEntry {
+        uint32_t id;
+        uint64_t due;
+    };
+
+    // Two level timer wheel, tick is one millisecond, allocated on the first transaction
+    std::vector<std::vector<TimerEntry> > wheel_[2];
+
+    // Entries being processed, kept to reuse its storage
+    std::vector<TimerEntry> timerDue_;
+
+    // Current wheel tick
+    uint64_t curTick_;
+
+    // Number of entries in the wheel
+    uint32_t wheelCount_;
+
+    // Outstanding transaction counts
+    uint32_t outstanding_;
+    uint32_t maxOutstanding_;
+
+    // Completion latency histogram
+    std::vector<uint64_t> latencyHist_;
+
+    // Current wheel tick time
+    static uint64_t currentTick();
+
+    // Ticks between timer refreshes of a transaction
+    static uint64_t timerTicks(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+    // Double the slot table
+    void growSlots();
+
+    // Remove a transaction from the slot table
+    void clearSlot(Slot& slot);
+
+    // Schedule a timer refresh
+    void addTimer(uint32_t id, uint64_t due);
+
+    // Process timers which are due
+    void runTimer(uint32_t id, std::shared_ptr<rogue::interfaces::memory::Transaction> ref);
+
+    // Advance the timer wheel
+    void advanceTimers(uint64_t tick, std::shared_ptr<rogue::interfaces::memory::Transaction> ref);
 
     // Slave lock
     std::mutex slaveMtx_;
@@ -113,8 +171,10 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
     /** This method is called by the sub-class to retrieve an existing transaction
      * using the unique transaction ID. If the transaction exists in the list the
      * pointer to that transaction will be returned. If not a NULL pointer will be
-     * returned. When getTransaction() is called the map will also be checked for
-     * stale transactions which will be removed from the map.
+     * returned. When getTransaction() is called the timers of transactions started
+     * after the returned transaction are refreshed and stale transactions are removed
+     * from the map. Timers are refreshed in batches, each outstanding transaction is
+     * visited at most once every eighth of its timeout.
      *
      * Exposed to python as _getTransaction()
      * @param index ID of transaction to lookup
@@ -122,6 +182,36 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
      */
     std::shared_ptr<rogue::interfaces::memory::Transaction> getTransaction(uint32_t index);
 
+    //! Number of completion latency histogram bins
+    static const uint32_t LatencyBins = 32;
+
+    //! Get the number of outstanding transactions
+    /** Exposed to python as getOutstanding()
+     * @return Number of transactions in the tracking map
+     */
+    uint32_t getOutstanding();
+
+    //! Get the peak number of outstanding transactions
+    /** Exposed to python as getMaxOutstanding()
+     * @return Peak number of transactions in the tracking map
+     */
+    uint32_t getMaxOutstanding();
+
+    //! Get the completion latency histogram
+    /** The latency is measured from addTransaction() to getTransaction(). Bin n
+     * counts latencies from 2^n up to 2^(n+1) microseconds, bin 0 also counts
+     * latencies below one microsecond and the last bin counts all longer latencies.
+     *
+     * Exposed to python as getLatencyHistogram()
+     * @return Vector of LatencyBins counts
+     */
+    std::vector<uint64_t> getLatencyHistogram();
+
+    //! Reset the completion latency histogram and peak outstanding count
+    /** Exposed to python as resetStats()
+     */
+    void resetStats();
+
     //! Get min size from slave
     /** Not exposed to Python
      * @return Minimum transaction size
@@ -213,6 +303,9 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
     //! Support << operator in python
     void lshiftPy(boost::python::object p);
 
+    // Get the completion latency histogram as a python list
+    boost::python::object getLatencyHistogramPy();
+
 #endif
 
     //! Support << operator in C++
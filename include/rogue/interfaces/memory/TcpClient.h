@@ -23,6 +23,9 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <thread>
 
@@ -42,6 +45,9 @@ namespace memory {
  *
  * The TcpClient memory interface will drop transactions when the remote server is not
  * present or when the pipeline backs up.
+ *
+ * Transactions are sent as they arrive without waiting for earlier responses.
+ * Responses are matched to their Transaction by id and may arrive in any order.
  */
 class TcpClient : public rogue::interfaces::memory::Slave {
     // Inbound Address
@@ -72,6 +78,15 @@ class TcpClient : public rogue::interfaces::memory::Slave {
     // Lock
     std::mutex bridgeMtx_;
 
+    // Send time of outstanding transactions, protected by bridgeMtx_
+    std::map<uint32_t, std::chrono::steady_clock::time_point> sendTime_;
+
+    // Statistics
+    std::atomic<uint32_t> maxInFlight_;
+    std::atomic<uint64_t> tranCount_;
+    std::atomic<uint64_t> latencyTotal_;
+    std::atomic<uint64_t> latencyMax_;
+
   public:
     //! Create a TcpClient object and return as a TcpServerPtr
     /**The creator takes an address and port. The passed address is the address of
@@ -104,6 +119,43 @@ class TcpClient : public rogue::interfaces::memory::Slave {
 
     // Process transaction from Master
     void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+    //! Get the number of transactions waiting for a response
+    /** Exposed as getInFlight() to Python
+     * @return Outstanding transaction count
+     */
+    uint32_t getInFlight();
+
+    //! Get the peak number of transactions waiting for a response
+    /** Exposed as getMaxInFlight() to Python
+     * @return Peak outstanding transaction count
+     */
+    uint32_t getMaxInFlight();
+
+    //! Get the number of responses received
+    /** Exposed as getTransactionCount() to Python
+     * @return Response count
+     */
+    uint64_t getTransactionCount();
+
+    //! Get the average round trip latency
+    /** Exposed as getLatencyAvg() to Python
+     * @return Average latency in seconds
+     */
+    double getLatencyAvg();
+
+    //! Get the maximum round trip latency
+    /** Exposed as getLatencyMax() to Python
+     * @return Maximum latency in seconds
+     */
+    double getLatencyMax();
+
+    //! Reset the in-flight and latency statistics
+    /** The Slave statistics are also reset.
+     *
+     * Exposed as resetStats() to Python
+     */
+    void resetStats();
 };
 
 //! Alias for using shared pointer as TcpClientPtr
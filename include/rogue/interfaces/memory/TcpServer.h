@@ -23,10 +23,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/Queue.h"
 #include "rogue/interfaces/memory/Master.h"
 
 namespace rogue {
@@ -39,6 +44,11 @@ namespace memory {
  * the memory Transaction to an attached Slave. On the other end of the link a
  * TcpClient accepts a memory Transaction from an attached Master and forwards it to
  * this TcpSver.
+ *
+ * Requests are issued to the Slave in the order they are received. Up to a window
+ * of transactions are kept outstanding at the same time, each is replied to as soon
+ * as it completes, which may be out of order. The TcpClient matches replies to
+ * transactions by id.
  */
 class TcpServer : public rogue::interfaces::memory::Master {
     // Inbound Address
@@ -56,9 +66,15 @@ class TcpServer : public rogue::interfaces::memory::Master {
     // Zeromq outbound port
     void* zmqResp_;
 
+    // Outstanding request, defined in the source file to keep ZeroMQ types private
+    struct Request;
+
     // Thread background
     void runThread();
 
+    // Reply thread background
+    void runReply();
+
     // Log
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
@@ -66,6 +82,27 @@ class TcpServer : public rogue::interfaces::memory::Master {
     std::thread* thread_;
     bool threadEn_;
 
+    // Reply threads, one per window slot
+    std::vector<std::thread*> replyThreads_;
+
+    // Outstanding requests waiting for a reply thread
+    rogue::Queue<std::shared_ptr<rogue::interfaces::memory::TcpServer::Request>> pending_;
+
+    // Window state
+    std::mutex windowMtx_;
+    std::condition_variable windowCond_;
+    uint32_t window_;
+    uint32_t inFlight_;
+
+    // Reply socket lock
+    std::mutex respMtx_;
+
+    // Statistics
+    std::atomic<uint32_t> maxInFlight_;
+    std::atomic<uint64_t> tranCount_;
+    std::atomic<uint64_t> latencyTotal_;
+    std::atomic<uint64_t> latencyMax_;
+
   public:
     //! Create a TcpServer object and return as a TcpServerPtr
     /**The creator takes an address and port. The passed address can either be
@@ -96,6 +133,33 @@ class TcpServer : public rogue::interfaces::memory::Master {
 
     // Stop the interface
     void stop();
+
+    //! Set the number of transactions which can be outstanding at once
+    /** Exposed as setWindow() to Python
+     * @param window Window size, 1 executes transactions one at a time
+     */
+    void setWindow(uint32_t window);
+
+    //! Get the number of transactions which can be outstanding at once
+    uint32_t getWindow();
+
+    //! Get the number of outstanding transactions
+    uint32_t getInFlight();
+
+    //! Get the peak number of outstanding transactions
+    uint32_t getMaxInFlight();
+
+    //! Get the number of completed transactions
+    uint64_t getTransactionCount();
+
+    //! Get average transaction latency in seconds
+    double getLatencyAvg();
+
+    //! Get maximum transaction latency in seconds
+    double getLatencyMax();
+
+    //! Reset statistics
+    void resetStats();
 };
 
 //! Alias for using shared pointer as TcpServerPtr
@@ -23,12 +23,14 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
 
+#include "rogue/CacheAllocator.h"
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
 
@@ -47,7 +49,11 @@ class Hub;
 
 //         using TransactionIDVec = std::vector<uint32_t>;
 //         using TransactionQueue = std::queue<std::shared_ptr<rogue::interfaces::memory::Transaction>>;
-using TransactionMap = std::map<uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction>>;
+using TransactionMap = std::map<
+    uint32_t,
+    std::shared_ptr<rogue::interfaces::memory::Transaction>,
+    std::less<uint32_t>,
+    rogue::CacheAllocator<std::pair<const uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction>>>>;
 
 //! Transaction Container
 /** The Transaction is passed between the Master and Slave to initiate a transaction.
@@ -55,10 +61,15 @@ using TransactionMap = std::map<uint32_t, std::shared_ptr<rogue::interfaces::mem
  * transaction data pointer. Each created transaction object has a unique 32-bit
  * transaction ID which is used to track the transaction. Transactions are never
  * created directly, instead they are created in the Master() class.
+ *
+ * Transaction objects are recycled through a per thread object cache and share a
+ * single logger, so creating a transaction does not allocate memory once the cache
+ * is warm.
  */
 class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Transaction> {
     friend class TransactionLock;
     friend class Master;
+    friend class Slave;
     friend class Hub;
 
   public:
@@ -67,10 +78,7 @@ class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory
 
   private:
     // Class instance counter
-    static uint32_t classIdx_;
-
-    // Class instance lock
-    static std::mutex classMtx_;
+    static std::atomic<uint32_t> classIdx_;
 
     // Conditional
     std::condition_variable cond_;
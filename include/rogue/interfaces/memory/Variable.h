@@ -73,6 +73,21 @@ class Variable {
     // Fast copy base array
     uint32_t* fastByte_;
 
+    // Bit plan is valid, variable bits fit in a single 64-bit window of the block
+    bool bitPlanEn_;
+
+    // First block byte of the bit plan window
+    uint32_t bitPlanByte_;
+
+    // Number of bytes in the bit plan window
+    uint32_t bitPlanBytes_;
+
+    // Bits of the bit plan window which belong to the variable
+    uint64_t bitPlanMask_;
+
+    // Compute the bit plan from the bit offsets and sizes
+    void buildBitPlan();
+
     // Total bytes (rounded up) for this value
     uint32_t byteSize_;
 
@@ -601,6 +616,17 @@ class VariableWrap : public rogue::interfaces::memory::Variable,
      */
     boost::python::object get(int32_t index);
 
+    //! Get a range of values from a list RemoteVariable
+    /** Decode a range of list values into a numpy array with a single
+     * access to the shadow memory.
+     *
+     * Exposed as _getArray() method to Python
+     *
+     * @param index   Index of first value
+     * @param count   Number of values, -1 to get the rest of the list
+     */
+    boost::python::object getArray(int32_t index, int32_t count);
+
     //! To Bytes
     boost::python::object toBytes(boost::python::object& value);
 
@@ -24,10 +24,17 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/Queue.h"
+#include "rogue/RingQueue.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -48,6 +55,26 @@ namespace stream {
  *
  * The Fifo supports a maximum depth to be configured. After this depth is reached
  * new incoming Frame objects are dropped.
+ *
+ * The Fifo can optionally use a bounded lock free ring queue in place of the default
+ * mutex protected queue. In this mode the queue holds at most twice the maximum depth,
+ * or RingQueue::DefaultCapacity entries when the depth is unlimited, after which
+ * incoming Frame objects are blocked rather than buffered.
+ *
+ * Frames can be passed to the attached Slave objects by a pool of worker threads so
+ * that a slow Slave does not serialize the pipeline. In unordered mode each worker
+ * passes frames on as soon as it receives them. In ordered mode each Slave receives
+ * frames one at a time in the order they were received by the Fifo. Workers form a
+ * pipeline across the attached Slave objects, a frame can be passed to one Slave
+ * while the previous frame is being processed by another. A Slave attached while
+ * frames are in flight receives frames in order, starting with the first frame
+ * which finds it attached. If a Slave throws while accepting a frame in ordered
+ * mode the error is logged and the frame is not passed to the remaining Slave
+ * objects.
+ *
+ * The drop policy defines what happens when the maximum depth is reached. DropNew
+ * drops the incoming frame, DropOldest drops the oldest queued frame to make room
+ * for the incoming frame and Block stalls the Master until there is room.
  */
 class Fifo : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
     std::shared_ptr<rogue::Logging> log_;
@@ -56,35 +83,81 @@ class Fifo : public rogue::interfaces::stream::Master, public rogue::interfaces:
     uint32_t maxDepth_;
     uint32_t trimSize_;
     bool noCopy_;
+    bool ordered_;
+    std::atomic<uint32_t> dropPolicy_;
 
     // Drop frame counter
-    std::size_t dropFrameCnt_;
+    std::atomic<std::size_t> dropFrameCnt_;
 
     // Queue
     rogue::Queue<std::shared_ptr<rogue::interfaces::stream::Frame>> queue_;
 
-    // Transmission thread
+    // Lock free queue, used in place of queue_ when allocated
+    std::unique_ptr<rogue::RingQueue<std::shared_ptr<rogue::interfaces::stream::Frame>>> ring_;
+
+    // Transmission threads
     bool threadEn_;
-    std::thread* thread_;
+    std::vector<std::thread*> threads_;
+
+    // Ordered delivery state, next sequence number to be passed to each slave
+    std::mutex popMtx_;
+    std::mutex orderMtx_;
+    std::condition_variable orderCond_;
+    uint64_t popSeq_;
+    std::vector<uint64_t> slaveSeq_;
+
+    // Sequence numbers of the frames popped and not yet passed to every slave
+    std::set<uint64_t> inFlight_;
+
+    // Get the next frame from the queue
+    std::shared_ptr<rogue::interfaces::stream::Frame> pop();
+
+    // Pass a frame to each slave in sequence order
+    void sendOrdered(std::shared_ptr<rogue::interfaces::stream::Frame> frame, uint64_t seq);
+
+    // Mark a frame as passed to a slave and wake the waiting workers
+    void advanceSeq(uint32_t slave, uint64_t seq);
 
     // Thread background
     void runThread();
 
   public:
+    //! Drop incoming frames when full
+    static const uint32_t DropNew = 0;
+
+    //! Drop the oldest queued frame when full
+    static const uint32_t DropOldest = 1;
+
+    //! Block the Master when full
+    static const uint32_t Block = 2;
+
     //! Create a Fifo object and return as a FifoPtr
     /** Exposed as rogue.interfaces.stream.Fifo() to Python
      * @param maxDepth Set to a non-zero value to configured fixed size mode.
      * @param trimSize Set to a non-zero value to limit the amount of data copied.
      * @param noCopy Set to true to disable Frame copy
+     * @param lockFree Set to true to use a lock free ring queue
+     * @param workers Number of worker threads passing frames to the Slave objects
+     * @param ordered Set to true to pass frames to the Slave objects in order
      * @return Fifo object as a FifoPtr
      */
-    static std::shared_ptr<rogue::interfaces::stream::Fifo> create(uint32_t maxDepth, uint32_t trimSize, bool noCopy);
+    static std::shared_ptr<rogue::interfaces::stream::Fifo> create(uint32_t maxDepth,
+                                                                   uint32_t trimSize,
+                                                                   bool noCopy,
+                                                                   bool lockFree = false,
+                                                                   uint32_t workers = 1,
+                                                                   bool ordered = false);
 
     // Setup class for use in python
     static void setup_python();
 
     // Create a Fifo object.
-    Fifo(uint32_t maxDepth, uint32_t trimSize, bool noCopy);
+    Fifo(uint32_t maxDepth,
+         uint32_t trimSize,
+         bool noCopy,
+         bool lockFree = false,
+         uint32_t workers = 1,
+         bool ordered = false);
 
     // Destroy the Fifo
     ~Fifo();
@@ -98,6 +171,27 @@ class Fifo : public rogue::interfaces::stream::Master, public rogue::interfaces:
     // Clear counters
     void clearCnt();
 
+    //! Set drop policy
+    /** Block has no effect when the maximum depth is unlimited.
+     *
+     * Exposed as setDropPolicy() to Python
+     * @param policy DropNew, DropOldest or Block
+     */
+    void setDropPolicy(uint32_t policy);
+
+    //! Get drop policy
+    uint32_t getDropPolicy();
+
+    //! Get number of worker threads
+    uint32_t getWorkers();
+
+    //! Set CPU affinity of a worker thread
+    /** Exposed as setWorkerAffinity() to Python
+     * @param index Worker index
+     * @param cpu CPU number, or -1 to allow all CPUs
+     */
+    void setWorkerAffinity(uint32_t index, int32_t cpu);
+
     // Receive frame from Master
     void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 };
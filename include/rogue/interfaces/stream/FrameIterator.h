@@ -22,6 +22,7 @@
 #include "rogue/Directives.h"
 
 #include <stdint.h>
+#include <sys/uio.h>
 
 #include <cstring>
 #include <memory>
@@ -233,6 +234,32 @@ class FrameIterator : public std::iterator<std::random_access_iterator_tag, uint
     rogue::interfaces::stream::FrameIterator& operator-=(const int32_t sub);
 };
 
+//! Contiguous blocks of at least this size are copied with bulkCopy()
+const uint32_t BulkCopySize = 4194304;
+
+//! Copy a large block of memory
+/** Uses AVX-512 or AVX2 non-temporal stores, selected at runtime for the
+ * running CPU, so that large copies do not evict the working set from the
+ * cache. Falls back to memcpy when neither is available.
+ * @param dst Pointer to data destination
+ * @param src Pointer to data source
+ * @param size The number of bytes to copy
+ */
+void bulkCopy(void* dst, const void* src, uint32_t size);
+
+//! Inline helper function to copy a contiguous block
+/** Small blocks use memcpy, large blocks use bulkCopy().
+ * @param dst Pointer to data destination
+ * @param src Pointer to data source
+ * @param size The number of bytes to copy
+ */
+static inline void blockCopy(void* dst, const void* src, uint32_t size) {
+    if (size >= BulkCopySize)
+        bulkCopy(dst, src, size);
+    else
+        std::memcpy(dst, src, size);
+}
+
 //! Inline helper function to copy values to a frame iterator
 /** This helper function copies from the passed data pointer into the
  * Frame at the iterator position. The iterator is incremented by the copy size.
@@ -246,7 +273,7 @@ static inline void toFrame(rogue::interfaces::stream::FrameIterator& iter, uint3
 
     do {
         csize = (size > iter.remBuffer()) ? iter.remBuffer() : size;
-        std::memcpy(iter.ptr(), ptr, csize);
+        blockCopy(iter.ptr(), ptr, csize);
         ptr += csize;
         iter += csize;
         size -= csize;
@@ -266,7 +293,7 @@ static inline void fromFrame(rogue::interfaces::stream::FrameIterator& iter, uin
 
     do {
         csize = (size > iter.remBuffer()) ? iter.remBuffer() : size;
-        std::memcpy(ptr, iter.ptr(), csize);
+        blockCopy(ptr, iter.ptr(), csize);
         ptr += csize;
         iter += csize;
         size -= csize;
@@ -289,12 +316,44 @@ static inline void copyFrame(rogue::interfaces::stream::FrameIterator& srcIter,
     do {
         csize = (size > srcIter.remBuffer()) ? srcIter.remBuffer() : size;
         csize = (csize > dstIter.remBuffer()) ? dstIter.remBuffer() : csize;
-        std::memcpy(dstIter.ptr(), srcIter.ptr(), csize);
+        blockCopy(dstIter.ptr(), srcIter.ptr(), csize);
         srcIter += csize;
         dstIter += csize;
         size -= csize;
     } while (size > 0 && csize > 0);
 }
+
+//! Inline helper function to describe frame data as a list of iovec entries
+/** This helper function appends one iovec entry for each contiguous block of
+ * the Frame starting at the iterator location, covering up to size bytes, and
+ * updates the iterator by the covered size. Using an iterator from beginRead()
+ * describes the payload for a gather write, an iterator from beginWrite()
+ * describes the available space for a scatter read. The entries reference the
+ * Frame buffers and are only valid while the Frame is held.
+ * @param iter FrameIterator at position of the first block
+ * @param size The number of bytes to describe
+ * @param iov Vector to append the iovec entries to
+ * @return Number of bytes covered by the appended entries
+ */
+static inline uint32_t toIovec(rogue::interfaces::stream::FrameIterator& iter,
+                               uint32_t size,
+                               std::vector<struct iovec>& iov) {
+    struct iovec entry;
+    uint32_t total;
+    uint32_t csize;
+
+    total = 0;
+    while (size > 0 && (csize = iter.remBuffer()) > 0) {
+        if (csize > size) csize = size;
+        entry.iov_base = iter.ptr();
+        entry.iov_len  = csize;
+        iov.push_back(entry);
+        iter += csize;
+        size -= csize;
+        total += csize;
+    }
+    return total;
+}
 }  // namespace stream
 }  // namespace interfaces
 }  // namespace rogue
@@ -59,6 +59,10 @@ class Master : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Mas
     // Default slave if not connected
     std::shared_ptr<rogue::interfaces::stream::Slave> defSlave_;
 
+  protected:
+    // Get a copy of the slave list, in order of attachment
+    std::vector<std::shared_ptr<rogue::interfaces::stream::Slave> > getSlaves();
+
   public:
     //! Class factory which returns a pointer to a Master object (MasterPtr)
     /** Create a new Master
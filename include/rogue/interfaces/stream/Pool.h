@@ -23,11 +23,14 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Queue.h"
+#include "rogue/RingQueue.h"
 
 namespace rogue {
 namespace interfaces {
@@ -48,24 +51,43 @@ class Buffer;
  * a new requester. The pool size defines the maximum number of entries to allow in
  * the pool.
  *
+ * Pooled buffers are held in a lock free free list shared by all threads. Each
+ * thread additionally keeps a small cache of free buffers for each pool it has
+ * recently used, so the steady state allocate and return path takes no shared
+ * lock. Buffers held in these thread caches are in addition to the configured
+ * pool size and are released from all threads when the pool is reconfigured or
+ * destroyed.
+ *
  * A subclass can be created with intercepts the Frame requests and allocates
  * Frame and Buffer objects from an alternative source such as a hardware DMA driver.
  */
 class Pool : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Pool> {
+    // Free list for buffers of a single fixed size, replaced when the configuration changes
+    struct Depot {
+        uint64_t id;
+        uint32_t size;
+        rogue::RingQueue<uint8_t*> ring;
+
+        Depot(uint64_t i, uint32_t s, uint32_t c) : id(i), size(s), ring(c) {}
+    };
+
     // Mutex
     std::mutex mtx_;
 
     // Track buffer allocations
-    uint32_t allocMeta_;
+    std::atomic<uint32_t> allocMeta_;
 
     // Total memory allocated
-    uint32_t allocBytes_;
+    std::atomic<uint32_t> allocBytes_;
 
     // Total buffers allocated
-    uint32_t allocCount_;
+    std::atomic<uint32_t> allocCount_;
+
+    // Active buffer free list, NULL when pooling is disabled
+    std::atomic<Depot*> depot_;
 
-    // Buffer queue
-    std::queue<uint8_t*> dataQ_;
+    // All free lists created by this pool, released in the destructor
+    std::vector<Depot*> depots_;
 
     // Fixed size buffer mode
     uint32_t fixedSize_;
@@ -73,6 +95,15 @@ class Pool : public rogue::EnableSharedFromThis<rogue::interfaces::stream::Pool>
     // Buffer queue count
     uint32_t poolSize_;
 
+    // Create a new free list for the current configuration, called with mtx_ held
+    void updateDepot();
+
+    // Get a buffer from the thread cache or free list, returns NULL if none are available
+    static uint8_t* cacheGet(Depot* depot);
+
+    // Return a buffer to the thread cache
+    static void cachePut(Depot* depot, uint8_t* data);
+
   public:
     // Class creator
     Pool();
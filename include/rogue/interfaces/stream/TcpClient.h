@@ -50,15 +50,18 @@ class TcpClient : public rogue::interfaces::stream::TcpCore {
      * Exposed to Python as rogue.interfaces.stream.TcpClient
      * @param addr Interface address for server, remote server address for client.
      * @param port Base port number of use for connection.
+     * @param zeroCopy Send frames in the header format, see TcpCore.
      * @return TcpClient object as a TcpClientPtr
      */
-    static std::shared_ptr<rogue::interfaces::stream::TcpClient> create(std::string addr, uint16_t port);
+    static std::shared_ptr<rogue::interfaces::stream::TcpClient> create(std::string addr,
+                                                                        uint16_t port,
+                                                                        bool zeroCopy = false);
 
     // Setup class for use in python
     static void setup_python();
 
     // Create a TcpClient object
-    TcpClient(std::string addr, uint16_t port);
+    TcpClient(std::string addr, uint16_t port, bool zeroCopy = false);
 
     // Destroy the TcpClient
     ~TcpClient();
@@ -23,12 +23,16 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <thread>
 
 #include "rogue/Logging.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Pool.h"
 #include "rogue/interfaces/stream/Slave.h"
 
 namespace rogue {
@@ -46,9 +50,38 @@ namespace stream {
  * transmissions when the remote side is either not present or is back pressuring.
  * When the remote server is not present a local buffer is not utilized, where it is
  * utilized when a connection has been established.
+ *
+ * By default each frame is sent as a four part message holding the flags, channel,
+ * error and a copy of the payload, which is understood by all versions of the bridge
+ * and the simulation interfaces.
+ *
+ * When zero copy mode is selected at construction each message instead starts with a
+ * part containing an 8 byte record header (payload size, flags, channel and error).
+ * Frames up to InlineSize bytes are copied directly after the header. Larger frames
+ * are sent without a copy, each frame buffer is passed to ZeroMQ as a separate message
+ * part which holds a reference to the frame until it has been transmitted. Such a
+ * frame, and the buffers it holds, stay allocated in the ZeroMQ send queue after
+ * acceptFrame() returns. Buffers taken from a fixed size source, such as DMA buffers,
+ * are only returned once the remote side has received the data, so a slow receiver
+ * can hold up to the send high water mark of frames. The receiver must be a version
+ * which understands this format. Received message parts become the buffers of the
+ * received frame. Both formats are always accepted on receive.
+ *
+ * An optional coalescing mode packs small frames into a single message as a sequence
+ * of records, each a header followed by the payload. A batch is sent when the next
+ * record does not fit in the configured maximum size, when the oldest frame in the
+ * batch has waited for the configured latency, or before a larger frame is sent.
+ * Batches always use the header format. Receivers always accept batched messages,
+ * coalescing only needs to be enabled on the transmit side.
  */
 class TcpCore : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
   protected:
+    // Frames up to this size are copied into the header part
+    static const uint32_t InlineSize = 1024;
+
+    // Send frames with the header format, large frames without a copy
+    bool zeroCopy_;
+
     // Inbound Address
     std::string pullAddr_;
 
@@ -67,16 +100,58 @@ class TcpCore : public rogue::interfaces::stream::Master, public rogue::interfac
     // Thread background
     void runThread();
 
+    // Pool for received frames, wraps message parts as frame buffers
+    std::shared_ptr<rogue::interfaces::stream::Pool> rxPool_;
+
+    // Create a frame from a block of received data
+    std::shared_ptr<rogue::interfaces::stream::Frame> rxCopy(uint8_t* data, uint32_t size);
+
     // Log
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
     // Thread
     std::thread* thread_;
-    bool threadEn_;
+    std::atomic<bool> threadEn_;
+
+    // Time in milliseconds stalled transmits and queued messages keep waiting for the remote side after stop()
+    static const uint32_t StopTimeout = 1000;
+
+    // Transmits give up after this time once the threads are disabled
+    std::chrono::steady_clock::time_point stopTime_;
 
     // Lock
     std::mutex bridgeMtx_;
 
+    // Coalescing buffer and state, protected by bridgeMtx_
+    uint8_t* batch_;
+    uint32_t batchMax_;
+    uint32_t batchUsed_;
+    uint32_t batchFrames_;
+    uint32_t batchLatency_;
+    std::chrono::steady_clock::time_point batchStart_;
+
+    // Coalescing flush thread
+    std::thread* flushThread_;
+    std::condition_variable flushCond_;
+
+    // Batch statistics
+    std::atomic<uint64_t> rxBatchCount_;
+    std::atomic<uint64_t> rxBatchTotal_;
+    std::atomic<uint64_t> txBatchCount_;
+    std::atomic<uint64_t> txBatchTotal_;
+
+    // Send a message part, waits while the remote side is not ready, bridgeMtx_ must be held
+    int32_t sendPart(void* msg, int32_t flags);
+
+    // Send the pending batch, bridgeMtx_ must be held
+    void flushBatch();
+
+    // Send a frame with the legacy four part format, bridgeMtx_ must be held
+    void sendLegacy(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    // Flush thread background
+    void runFlush();
+
   public:
     //! Create a TcpCore object and return as a TcpCorePtr
     /**The creator takes an address, port and server mode flag. The passed
@@ -91,15 +166,19 @@ class TcpCore : public rogue::interfaces::stream::Master, public rogue::interfac
      * @param addr Interface address for server, remote server address for client.
      * @param port Base port number of use for connection.
      * @param server Server flag. Set to True to run in server mode.
+     * @param zeroCopy Set to True to send frames with the header format.
      * @return TcpCore object as a TcpCorePtr
      */
-    static std::shared_ptr<rogue::interfaces::stream::TcpCore> create(std::string addr, uint16_t port, bool server);
+    static std::shared_ptr<rogue::interfaces::stream::TcpCore> create(std::string addr,
+                                                                      uint16_t port,
+                                                                      bool server,
+                                                                      bool zeroCopy = false);
 
     // Setup class for use in python
     static void setup_python();
 
     // Create a TcpCore object
-    TcpCore(std::string addr, uint16_t port, bool server);
+    TcpCore(std::string addr, uint16_t port, bool server, bool zeroCopy = false);
 
     // Destroy the TcpCore
     ~TcpCore();
@@ -112,6 +191,38 @@ class TcpCore : public rogue::interfaces::stream::Master, public rogue::interfac
 
     // Receive frame from Master
     void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    //! Set coalescing parameters
+    /** Frames up to InlineSize bytes are packed into messages of up to size bytes.
+     * A partially filled message is sent once its oldest frame has waited for
+     * latency microseconds. A size of zero disables coalescing.
+     *
+     * Exposed to Python as setCoalesce()
+     * @param size Maximum message size in bytes
+     * @param latency Maximum latency in microseconds
+     */
+    void setCoalesce(uint32_t size, uint32_t latency);
+
+    //! Get maximum coalesced message size, zero when disabled
+    uint32_t getCoalesceSize();
+
+    //! Get maximum coalescing latency in microseconds
+    uint32_t getCoalesceLatency();
+
+    //! Get number of messages received
+    uint64_t getRxBatchCount();
+
+    //! Get average number of frames per received message
+    double getRxBatchAvg();
+
+    //! Get number of messages sent
+    uint64_t getTxBatchCount();
+
+    //! Get average number of frames per sent message
+    double getTxBatchAvg();
+
+    //! Reset batch counters
+    void resetBatchCounters();
 };
 
 //! Alias for using shared pointer as TcpCorePtr
@@ -52,15 +52,18 @@ class TcpServer : public rogue::interfaces::stream::TcpCore {
      * Exposed to Python as rogue.interfaces.stream.TcpServer
      * @param addr Interface address for server, remote server address for client.
      * @param port Base port number of use for connection.
+     * @param zeroCopy Send frames in the header format, see TcpCore.
      * @return TcpServer object as a TcpServerPtr
      */
-    static std::shared_ptr<rogue::interfaces::stream::TcpServer> create(std::string addr, uint16_t port);
+    static std::shared_ptr<rogue::interfaces::stream::TcpServer> create(std::string addr,
+                                                                        uint16_t port,
+                                                                        bool zeroCopy = false);
 
     // Setup class in python
     static void setup_python();
 
     // Create a TcpServer object
-    TcpServer(std::string addr, uint16_t port);
+    TcpServer(std::string addr, uint16_t port, bool zeroCopy = false);
 
     // Destroy the TcpServer
     ~TcpServer();
@@ -24,11 +24,14 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
 #include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/FrameIterator.h"
 
 namespace rogue {
 namespace protocols {
@@ -37,27 +40,56 @@ namespace batcher {
 class Data;
 
 //!  AXI Stream FIFO
+/** Frames which contain a single buffer are parsed with direct loads from the
+ * buffer memory. Frames with multiple buffers are parsed with frame iterators.
+ *
+ * Record objects are reused by the next processFrame() call when they are not
+ * referenced elsewhere, so a CoreV1 instance which is kept across frames
+ * avoids an allocation per record. The frame references held by the records
+ * are dropped by reset().
+ */
 class CoreV1 {
     std::shared_ptr<rogue::Logging> log_;
 
     //! Frame pointers
     std::shared_ptr<rogue::interfaces::stream::Frame> frame_;
 
-    //! Data List
+    //! Data List, entries past count_ are kept for reuse
     std::vector<std::shared_ptr<rogue::protocols::batcher::Data> > list_;
 
+    //! Number of records in the current frame
+    uint32_t count_;
+
     //! Header size
     uint32_t headerSize_;
 
     //! Tail size
     uint32_t tailSize_;
 
-    //! Tail pointers
-    std::vector<rogue::interfaces::stream::FrameIterator> tails_;
+    //! Tail offsets
+    std::vector<uint32_t> tails_;
 
     //! Sequence number
     uint32_t seq_;
 
+    //! Parse statistics
+    std::atomic<uint64_t> frameCount_;
+    std::atomic<uint64_t> fastCount_;
+    std::atomic<uint64_t> recordCount_;
+    std::atomic<uint64_t> byteCount_;
+    std::atomic<uint64_t> parseTime_;
+
+    //! Parse header and tails
+    bool parseFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    //! Add a record at the passed offset from the iterator
+    void addRecord(const rogue::interfaces::stream::FrameIterator& it,
+                   uint32_t offset,
+                   uint32_t size,
+                   uint8_t dest,
+                   uint8_t fUser,
+                   uint8_t lUser);
+
   public:
     //! Setup class in python
     static void setup_python();
@@ -106,6 +138,27 @@ class CoreV1 {
 
     //! Reset data
     void reset();
+
+    //! Get number of frames processed
+    uint64_t getFrameCount();
+
+    //! Get number of frames parsed with direct buffer loads
+    uint64_t getFastCount();
+
+    //! Get number of records found
+    uint64_t getRecordCount();
+
+    //! Get number of frame bytes processed
+    uint64_t getByteCount();
+
+    //! Get time spent parsing frames in seconds
+    double getParseTime();
+
+    //! Get parse rate in records per second
+    double getParseRate();
+
+    //! Reset the statistics
+    void resetStats();
 };
 
 // Convienence
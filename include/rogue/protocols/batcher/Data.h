@@ -68,6 +68,17 @@ class Data {
     //! Deconstructor
     ~Data();
 
+    //! Update record with data at the passed offset from the iterator
+    void update(const rogue::interfaces::stream::FrameIterator& it,
+                uint32_t offset,
+                uint32_t size,
+                uint8_t dest,
+                uint8_t fUser,
+                uint8_t lUser);
+
+    //! Release the frame reference
+    void release();
+
     //! Return Begin Data Iterator
     rogue::interfaces::stream::FrameIterator begin();
 
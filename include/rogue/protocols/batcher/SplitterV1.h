@@ -24,12 +24,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "rogue/Logging.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
+#include "rogue/protocols/batcher/CoreV1.h"
 
 namespace rogue {
 namespace protocols {
@@ -37,6 +40,21 @@ namespace batcher {
 
 //!  AXI Stream FIFO
 class SplitterV1 : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    // Serializes frames through the parser
+    std::mutex mtx_;
+
+    // Parser, kept across frames to reuse record storage
+    std::shared_ptr<rogue::protocols::batcher::CoreV1> core_;
+
+    // Zero copy mode
+    std::atomic<bool> zeroCopy_;
+
+    // Frames emitted as views of the super frame
+    std::atomic<uint64_t> sliceCount_;
+
+    // Frames emitted as copies
+    std::atomic<uint64_t> copyCount_;
+
   public:
     //! Class creation
     static std::shared_ptr<rogue::protocols::batcher::SplitterV1> create();
@@ -52,6 +70,27 @@ class SplitterV1 : public rogue::interfaces::stream::Master, public rogue::inter
 
     //! Accept a frame from master
     void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    //! Set zero copy mode
+    /** Emitted frames contain a single buffer which points into the memory of
+     * the received super frame, which is kept alive until all of the emitted
+     * frames are released. Records which straddle buffers of the super frame
+     * are copied. Emitted frames share memory with the super frame and have no
+     * header or tail room.
+     */
+    void setZeroCopy(bool enable);
+
+    //! Get zero copy mode
+    bool getZeroCopy();
+
+    //! Get number of frames emitted as views of the super frame
+    uint64_t getSliceCount();
+
+    //! Get number of frames emitted as copies
+    uint64_t getCopyCount();
+
+    //! Get the parser, used to read parse statistics
+    std::shared_ptr<rogue::protocols::batcher::CoreV1> getCore();
 };
 
 // Convienence
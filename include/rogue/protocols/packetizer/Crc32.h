@@ -0,0 +1,82 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Packetizer CRC32
+ * ----------------------------------------------------------------------------
+ * File       : Crc32.h
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CRC-32 engine used by the packetizer version 2 protocol.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_PROTOCOLS_PACKETIZER_CRC32_H__
+#define __ROGUE_PROTOCOLS_PACKETIZER_CRC32_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace protocols {
+namespace packetizer {
+
+//! CRC-32 engine
+/** Computes the standard reflected CRC-32 (polynomial 0x04C11DB7, initial
+ * value and final xor of 0xFFFFFFFF), the same result as CRC::CRC_32() from
+ * CRC.h. A calculation is continued over a new block by passing the result
+ * of the previous block as the crc argument, a crc of zero starts a new
+ * calculation.
+ *
+ * Blocks of 64 bytes or more are folded with carry-less multiplies when the
+ * running CPU supports PCLMULQDQ, other blocks and CPUs use a slicing-by-8
+ * table lookup. The engine is selected at runtime.
+ */
+class Crc32 {
+  public:
+    // Setup class for use in python
+    static void setup_python();
+
+    //! Compute CRC using the fastest engine for the running CPU
+    /** @param data Pointer to data
+     * @param size Data size in bytes
+     * @param crc Result of the previous block, zero for a new calculation
+     * @return CRC value
+     */
+    static uint32_t calculate(const void* data, uint32_t size, uint32_t crc = 0);
+
+    //! Compute CRC using slicing-by-8 table lookups
+    static uint32_t calculateTable(const void* data, uint32_t size, uint32_t crc = 0);
+
+    //! Compute CRC using carry-less multiply folding
+    /** Falls back to table lookups when PCLMULQDQ is not supported.
+     */
+    static uint32_t calculateClmul(const void* data, uint32_t size, uint32_t crc = 0);
+
+    //! Return true if the running CPU supports carry-less multiply folding
+    static bool clmulSupported();
+
+#ifndef NO_PYTHON
+
+    //! Compute CRC of a python buffer, engine 0 = fastest, 1 = table, 2 = carry-less multiply
+    /** Exposed as calculate() to Python
+     */
+    static uint32_t calculatePy(boost::python::object data, uint32_t crc, uint32_t engine);
+
+#endif
+};
+
+}  // namespace packetizer
+}  // namespace protocols
+}  // namespace rogue
+
+#endif
@@ -29,6 +29,7 @@
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
 #include "rogue/Queue.h"
+#include "rogue/RingQueue.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -95,6 +96,12 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     // State queue
     rogue::Queue<std::shared_ptr<rogue::protocols::rssi::Header>> stQueue_;
 
+    // Lock free application and state queues, used in place of appQueue_ and stQueue_ when enabled.
+    // The selection is fixed at construction so the threads never see it change.
+    bool lockFree_;
+    rogue::RingQueue<std::shared_ptr<rogue::protocols::rssi::Header>, true> appRing_;
+    rogue::RingQueue<std::shared_ptr<rogue::protocols::rssi::Header>, false> stRing_;
+
     // Application tracking
     uint8_t lastSeqRx_;
     uint8_t ackSeqRx_;
@@ -141,13 +148,15 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
         uint32_t segSize,
         std::shared_ptr<rogue::protocols::rssi::Transport> tran,
         std::shared_ptr<rogue::protocols::rssi::Application> app,
-        bool server);
+        bool server,
+        bool lockFree = false);
 
     //! Creator
     Controller(uint32_t segSize,
                std::shared_ptr<rogue::protocols::rssi::Transport> tran,
                std::shared_ptr<rogue::protocols::rssi::Application> app,
-               bool server);
+               bool server,
+               bool lockFree = false);
 
     //! Destructor
     ~Controller();
@@ -225,6 +234,9 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
 
     void resetCounters();
 
+    //! Get whether lock free single producer queues hold received frames
+    bool getLockFreeQueue();
+
     //! Set timeout in microseconds for frame transmits
     void setTimeout(uint32_t timeout);
 
@@ -235,6 +247,11 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     void start();
 
   private:
+    // Queue helpers which dispatch to the selected queue type
+    void appPush(std::shared_ptr<rogue::protocols::rssi::Header> head);
+    void stPush(std::shared_ptr<rogue::protocols::rssi::Header> head);
+    std::shared_ptr<rogue::protocols::rssi::Header> stPop();
+
     // Method to transit a frame with proper updates
     void transportTx(std::shared_ptr<rogue::protocols::rssi::Header> head, bool seqUpdate, bool txReset);
 
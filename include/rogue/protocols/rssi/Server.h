@@ -44,13 +44,13 @@ class Server {
 
   public:
     //! Class creation
-    static std::shared_ptr<rogue::protocols::rssi::Server> create(uint32_t segSize);
+    static std::shared_ptr<rogue::protocols::rssi::Server> create(uint32_t segSize, bool lockFree = false);
 
     //! Setup class in python
     static void setup_python();
 
     //! Creator
-    Server(uint32_t segSize);
+    Server(uint32_t segSize, bool lockFree = false);
 
     //! Destructor
     ~Server();
@@ -109,6 +109,8 @@ class Server {
     void setLocMaxCumAck(uint8_t val);
     uint8_t getLocMaxCumAck();
 
+    bool getLockFreeQueue();
+
     uint8_t curMaxBuffers();
     uint16_t curMaxSegment();
     uint16_t curCumAckTout();
@@ -24,9 +24,12 @@
 #include <stdint.h>
 #include <sys/socket.h>
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Frame.h"
 
 namespace rogue {
 namespace protocols {
@@ -41,6 +44,9 @@ const uint32_t HdrSize = 20 + 8;
 const uint32_t MaxJumboPayload = JumboMTU - HdrSize;
 const uint32_t MaxStdPayload   = StdMTU - HdrSize;
 
+// Maximum number of datagrams per recvmmsg/sendmmsg call
+const uint32_t MaxBatchSize = 1024;
+
 //! UDP Core
 class Core {
   protected:
@@ -64,6 +70,43 @@ class Core {
     //! mutex
     std::mutex udpMtx_;
 
+    //! Number of datagrams per recvmmsg/sendmmsg call, 1 disables batching
+    std::atomic<uint32_t> batchSize_;
+
+#ifndef __MACH__
+    //! Receive message headers, only used by the receive thread
+    std::vector<struct mmsghdr> rxMsgs_;
+
+    //! Receive IOVs and source addresses, only used by the receive thread
+    std::vector<struct iovec> rxIovs_;
+    std::vector<struct sockaddr_in> rxAddrs_;
+
+    //! Transmit message headers, protected by udpMtx_
+    std::vector<struct mmsghdr> txMsgs_;
+
+    //! Transmit IOVs, protected by udpMtx_
+    std::vector<struct iovec> txIovs_;
+#endif
+
+    //! Batch statistics
+    std::atomic<uint64_t> rxBatchCount_;
+    std::atomic<uint64_t> rxBatchTotal_;
+    std::atomic<uint64_t> txBatchCount_;
+    std::atomic<uint64_t> txBatchTotal_;
+
+    //! Receive up to frames.size() datagrams with a single recvmmsg call
+    /*
+     * Each returned frame has its payload set to the received size, truncated
+     * datagrams are returned with an empty payload. The source address of the
+     * last datagram is copied to addr when it is not NULL. Returns the number of
+     * frames filled, or <= 0 when no data was available.
+     */
+    int32_t recvBatch(std::vector<std::shared_ptr<rogue::interfaces::stream::Frame> >& frames,
+                      struct sockaddr_in* addr);
+
+    //! Transmit all buffers of a frame with sendmmsg, udpMtx_ must be held
+    void sendBatch(std::shared_ptr<rogue::interfaces::stream::Frame> frame, const char* name);
+
   public:
     //! Setup class in python
     static void setup_python();
@@ -85,6 +128,27 @@ class Core {
 
     //! Set timeout for frame transmits in microseconds
     void setTimeout(uint32_t timeout);
+
+    //! Set number of datagrams per receive and transmit call, 1 disables batching
+    void setBatchSize(uint32_t size);
+
+    //! Get number of datagrams per receive and transmit call
+    uint32_t getBatchSize();
+
+    //! Get number of batched receive calls which returned data
+    uint64_t getRxBatchCount();
+
+    //! Get average number of datagrams returned per batched receive call
+    double getRxBatchAvg();
+
+    //! Get number of batched transmit calls
+    uint64_t getTxBatchCount();
+
+    //! Get average number of datagrams sent per batched transmit call
+    double getTxBatchAvg();
+
+    //! Reset batch counters
+    void resetBatchCounters();
 };
 
 // Convenience
@@ -20,11 +20,15 @@
 
 #include <stdint.h>
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
+#include "rogue/utilities/PrbsEngine.h"
 
 namespace rogue {
 namespace utilities {
@@ -32,12 +36,17 @@ namespace utilities {
 //! PRBS master / slave class
 /*
  * Engine can be used as either a master or slave.
- * Internal thread can en enabled for auto frame generation
+ * Internal threads can en enabled for auto frame generation. With more than
+ * one thread the frame payloads are generated in parallel, each frame from
+ * its own sequence number, and the frames are sent in sequence order.
  */
 class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::stream::Master {
     //! Max size
     const static uint32_t MaxBytes = 64;
 
+    //! Payload bytes checked at once
+    const static uint32_t CheckBytes = 8192;
+
     //! PRBS taps
     uint8_t* taps_;
 
@@ -56,6 +65,9 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     //! Lock
     std::mutex pMtx_;
 
+    //! Receive payload engine
+    rogue::utilities::PrbsEngine rxEng_;
+
     //! rx sequence tracking
     uint32_t rxSeq_;
 
@@ -71,6 +83,11 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     //! tx sequence tracking
     uint32_t txSeq_;
 
+    //! Next tx sequence to send, frames are sent in order
+    uint32_t txSend_;
+    std::mutex txMtx_;
+    std::condition_variable txCond_;
+
     //! Transmit size
     uint32_t txSize_;
 
@@ -112,12 +129,16 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     std::shared_ptr<rogue::Logging> rxLog_;
     std::shared_ptr<rogue::Logging> txLog_;
 
-    //! TX thread
-    std::thread* txThread_;
+    //! TX threads
+    std::vector<std::thread*> txThreads_;
+    uint32_t txThreadCount_;
     bool threadEn_;
 
-    //! Internal computation
-    void flfsr(uint8_t* data);
+    //! Generate a data frame with the passed payload engine
+    void txFrame(uint32_t size, rogue::utilities::PrbsEngine& eng);
+
+    //! Log a payload mismatch
+    void payloadError(uint32_t pos, uint32_t size, const uint8_t* got, const uint8_t* exp);
 
     //! Thread background
     void runThread();
@@ -160,6 +181,12 @@ class Prbs : public rogue::interfaces::stream::Slave, public rogue::interfaces::
     //! Disable auto generation
     void disable();
 
+    //! Set the number of auto generation threads, default = 1
+    void setTxThreads(uint32_t count);
+
+    //! Get the number of auto generation threads
+    uint32_t getTxThreads();
+
     //! Get rx enable
     bool getRxEnable();
 
@@ -0,0 +1,111 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Word Parallel PRBS Engine
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_UTILITIES_PRBS_ENGINE_H__
+#define __ROGUE_UTILITIES_PRBS_ENGINE_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace rogue {
+namespace utilities {
+
+//! Word parallel PRBS engine
+/** Generates the payload words of the Prbs class. Each word is the LFSR state
+ * after one shift, where the state is shifted left by one bit and the XOR of
+ * the tap bits enters at bit 0. Consecutive words therefore share all but one
+ * bit, and the data is a window sliding over a single bit sequence.
+ *
+ * The sequence is generated 64 bits at a time. Starting from the seed, the
+ * next 64 bits are a linear function of the current state, computed with one
+ * table lookup per state byte. Once enough history exists the engine instead
+ * steps by the 64th power of the feedback polynomial, which has the same taps
+ * at 64 times the distance, so each step is one XOR per tap. The words are
+ * cut out of the 64 bit blocks with shifts, using AVX2 when the CPU supports
+ * it.
+ *
+ * Taps at or above the data width are ignored. An engine is not thread safe,
+ * each thread uses its own.
+ */
+class PrbsEngine {
+    //! Max data width in 64-bit words
+    static const uint32_t MaxLimbs = 8;
+
+    //! Blocks generated between history moves
+    static const uint32_t ChunkBlocks = 256;
+
+    //! Data width in bits and bytes
+    uint32_t width_;
+    uint32_t byteWidth_;
+
+    //! Tap bits of the state, per 64-bit word
+    uint64_t tapMask_[MaxLimbs];
+
+    //! Taps, in ascending order
+    std::vector<uint32_t> taps_;
+
+    //! Next 64 bits for each value of each state byte
+    std::vector<uint64_t> table_;
+
+    //! Sequence blocks, blk_[0] is block base_
+    std::vector<uint64_t> blk_;
+    uint64_t base_;
+
+    //! Blocks kept when the buffer is moved
+    uint32_t hist_;
+
+    //! First block generated by the polynomial step
+    uint64_t polyBlock_;
+
+    //! Next block to generate
+    uint64_t next_;
+
+    //! Next word
+    uint64_t word_;
+
+    //! Build the tables
+    void genTables();
+
+    //! Generate the next block
+    void genBlock();
+
+  public:
+    //! Create an engine with the default 32-bit width and taps
+    PrbsEngine();
+
+    //! Set the width and taps
+    /** The sequence is restarted by the next seed() call. Nothing is done
+     * when the configuration is unchanged.
+     * @param width Data width in bits, a multiple of 32 up to 512
+     * @param tapCnt Number of taps
+     * @param taps Tap bit positions
+     */
+    void setup(uint32_t width, uint32_t tapCnt, const uint8_t* taps);
+
+    //! Start a sequence
+    /** @param data Initial state of width / 8 bytes
+     */
+    void seed(const uint8_t* data);
+
+    //! Generate the next words of the sequence
+    /** @param dst Destination of count * width / 8 bytes
+     * @param count Number of words
+     */
+    void fill(uint8_t* dst, uint32_t count);
+};
+
+}  // namespace utilities
+}  // namespace rogue
+#endif
@@ -0,0 +1,118 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : io_uring submission helper.
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Minimal wrapper around the Linux io_uring interface used by the file
+ *    reader and writer to keep multiple reads or writes in flight. The
+ *    interface is accessed through the raw system calls so no additional
+ *    library is required. On systems without io_uring support create()
+ *    throws and callers fall back to blocking reads and writes.
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_UTILITIES_FILEIO_IO_URING_H__
+#define __ROGUE_UTILITIES_FILEIO_IO_URING_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <memory>
+
+struct iovec;
+
+namespace rogue {
+namespace utilities {
+namespace fileio {
+
+//! io_uring submission and completion ring
+/** Not thread safe, each ring is owned by a single reader or writer thread.
+ */
+class IoUring {
+    //! Ring file descriptor
+    int32_t fd_;
+
+    //! Submission ring mapping
+    void* sqMap_;
+    uint32_t sqMapSize_;
+
+    //! Completion ring mapping
+    void* cqMap_;
+    uint32_t cqMapSize_;
+
+    //! Submission entries mapping
+    void* sqes_;
+    uint32_t sqesSize_;
+
+    //! Submission ring pointers
+    uint32_t* sqHead_;
+    uint32_t* sqTail_;
+    uint32_t* sqMask_;
+    uint32_t* sqArray_;
+
+    //! Completion ring pointers
+    uint32_t* cqHead_;
+    uint32_t* cqTail_;
+    uint32_t* cqMask_;
+    void* cqes_;
+
+    //! Ring size
+    uint32_t depth_;
+
+    //! Entries queued but not yet submitted to the kernel
+    uint32_t toSubmit_;
+
+    //! Buffers have been registered
+    bool registered_;
+
+    //! Unmap rings and close descriptor
+    void release();
+
+    //! Queue a read or write
+    bool queue(uint8_t op, int32_t fd, void* data, uint32_t size, uint64_t offset, int32_t index, uint64_t tag);
+
+  public:
+    //! Return true if io_uring is supported by this build and the running kernel
+    static bool isSupported();
+
+    //! Class creation, throws if the ring can not be created
+    static std::shared_ptr<rogue::utilities::fileio::IoUring> create(uint32_t depth);
+
+    //! Creator
+    explicit IoUring(uint32_t depth);
+
+    //! Deconstructor
+    ~IoUring();
+
+    //! Get ring depth
+    uint32_t depth();
+
+    //! Register fixed buffers, returns false if registration failed
+    bool registerBuffers(struct iovec* iov, uint32_t count);
+
+    //! Queue a write, index is the registered buffer index or -1
+    bool write(int32_t fd, void* data, uint32_t size, uint64_t offset, int32_t index, uint64_t tag);
+
+    //! Queue a read, index is the registered buffer index or -1
+    bool read(int32_t fd, void* data, uint32_t size, uint64_t offset, int32_t index, uint64_t tag);
+
+    //! Submit queued entries to the kernel
+    void submit();
+
+    //! Get a completion, optionally blocking until one is available
+    bool complete(uint64_t& tag, int32_t& result, bool wait);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::utilities::fileio::IoUring> IoUringPtr;
+}  // namespace fileio
+}  // namespace utilities
+}  // namespace rogue
+#endif
@@ -0,0 +1,198 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : Indexed data file reader utility.
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Class to read data files written by StreamWriter with random access.
+ *    The data files are memory mapped and an index of the frame offsets,
+ *    channels and flags is built on open. The index is cached in a sidecar
+ *    file (data file name with .idx appended) and is reused as long as the
+ *    data files are unchanged. Frames can be emitted either as copies or as
+ *    zero copy frames whose buffers point into the mapping.
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_UTILITIES_FILEIO_MAPPED_STREAM_READER_H__
+#define __ROGUE_UTILITIES_FILEIO_MAPPED_STREAM_READER_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Pool.h"
+
+namespace rogue {
+namespace utilities {
+namespace fileio {
+
+//! Indexed data file reader
+class MappedStreamReader : public rogue::interfaces::stream::Master {
+    //! Memory mapped data file
+    /** Acts as the Pool for zero copy frames so the mapping stays valid
+     * until all frames referencing it are released.
+     */
+    class MappedFile : public rogue::interfaces::stream::Pool {
+      public:
+        //! File name
+        std::string name;
+
+        //! Mapped data
+        uint8_t* data;
+
+        //! File size
+        uint64_t size;
+
+        //! File modification time in nanoseconds
+        int64_t mtime;
+
+        //! Hash of the data at the start and end of the file
+        uint64_t hash;
+
+        //! Map a file, throws on error
+        explicit MappedFile(std::string file);
+
+        //! Unmap the file
+        ~MappedFile();
+
+        //! Create a frame referencing the mapped data
+        std::shared_ptr<rogue::interfaces::stream::Frame> mapFrame(uint64_t offset, uint32_t size);
+
+        //! Buffers reference the mapping, nothing to free
+        void retBuffer(uint8_t* data, uint32_t meta, uint32_t size);
+    };
+
+    typedef std::shared_ptr<MappedFile> MappedFilePtr;
+
+    //! Index entry, stored as is in the sidecar file
+    struct IndexEntry {
+        uint64_t offset;
+        uint32_t size;
+        uint32_t meta;
+        uint32_t file;
+        uint32_t reserved;
+    };
+
+    //! Log
+    std::shared_ptr<rogue::Logging> log_;
+
+    //! Mapped data files
+    std::vector<MappedFilePtr> files_;
+
+    //! Frame index
+    std::vector<IndexEntry> index_;
+
+    //! Frame numbers per channel, into index_
+    std::map<uint8_t, std::vector<uint64_t>> chanIndex_;
+
+    //! Channel filter, -1 for all channels
+    int32_t filter_;
+
+    //! Zero copy mode
+    bool zeroCopy_;
+
+    //! Index was loaded from the sidecar file
+    bool indexCached_;
+
+    //! Access lock
+    std::mutex mtx_;
+
+    //! Load index from sidecar file, returns false if missing or stale
+    bool loadIndex(std::string name);
+
+    //! Save index to sidecar file
+    void saveIndex(std::string name);
+
+    //! Build index by scanning the mapped files
+    void buildIndex();
+
+    //! Convert a frame number in the filtered view to an index entry
+    IndexEntry* getEntry(uint64_t index);
+
+    //! Emit an index entry
+    void emitEntry(IndexEntry* entry);
+
+  public:
+    //! Class creation
+    static std::shared_ptr<rogue::utilities::fileio::MappedStreamReader> create();
+
+    //! Setup class in python
+    static void setup_python();
+
+    //! Creator
+    MappedStreamReader();
+
+    //! Deconstructor
+    ~MappedStreamReader();
+
+    //! Open a data file, a file ending in .1 opens the complete group of files
+    void open(std::string file);
+
+    //! Close data files
+    void close();
+
+    //! Get open status
+    bool isOpen();
+
+    //! Get status of the sidecar index, true if the index was loaded from the cache
+    bool getIndexCached();
+
+    //! Set channel filter, -1 to select all channels
+    /** Frame numbers passed to the other methods are relative to the filtered
+     * list of frames.
+     */
+    void setChannelFilter(int32_t channel);
+
+    //! Get channel filter
+    int32_t getChannelFilter();
+
+    //! Set zero copy mode
+    /** Frames are emitted with buffers which point into the read only file
+     * mapping. Downstream slaves must not modify the frame data.
+     */
+    void setZeroCopy(bool enable);
+
+    //! Get zero copy mode
+    bool getZeroCopy();
+
+    //! Get number of frames, after channel filter
+    uint64_t getFrameCount();
+
+    //! Get frame payload size
+    uint32_t getFrameSize(uint64_t index);
+
+    //! Get frame channel
+    uint8_t getFrameChannel(uint64_t index);
+
+    //! Get frame flags
+    uint16_t getFrameFlags(uint64_t index);
+
+    //! Get frame error
+    uint8_t getFrameError(uint64_t index);
+
+    //! Send a single frame to the attached slaves
+    void readFrame(uint64_t index);
+
+    //! Send a range of frames to the attached slaves
+    void readRange(uint64_t start, uint64_t count);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::utilities::fileio::MappedStreamReader> MappedStreamReaderPtr;
+}  // namespace fileio
+}  // namespace utilities
+}  // namespace rogue
+#endif
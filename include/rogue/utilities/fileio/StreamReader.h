@@ -25,8 +25,10 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/interfaces/stream/Master.h"
+#include "rogue/utilities/fileio/IoUring.h"
 
 namespace rogue {
 namespace utilities {
@@ -34,6 +36,57 @@ namespace fileio {
 
 //! Stream writer central class
 class StreamReader : public rogue::interfaces::stream::Master {
+    //! Read ahead chunk
+    struct ReadChunk {
+        uint8_t* data;
+        uint64_t offset;
+        uint32_t size;
+        uint32_t pos;
+        bool pending;
+    };
+
+    //! Size of each read ahead chunk
+    static const uint32_t ChunkSize = 1048576;
+
+    //! Number of chunks kept in flight when using io_uring
+    static const uint32_t ChunkDepth = 4;
+
+    //! Read ahead chunks
+    std::vector<ReadChunk> chunks_;
+
+    //! Chunk being consumed
+    uint32_t chunkIdx_;
+
+    //! File offset of the next chunk read
+    uint64_t rdOffset_;
+
+    //! Use io_uring for reads
+    bool ioUring_;
+
+    //! Ring used by the read thread, NULL when disabled or not supported
+    rogue::utilities::fileio::IoUringPtr ring_;
+
+    //! Allocate read ahead chunks and ring
+    void allocChunks();
+
+    //! Free read ahead chunks and ring
+    void freeChunks();
+
+    //! Start reading a new file
+    void startRead();
+
+    //! Wait for outstanding reads before the file is closed
+    void stopRead();
+
+    //! Issue a read for a chunk
+    void readChunk(ReadChunk* chunk);
+
+    //! Complete a chunk with blocking reads, stops at the end of the file
+    void fillChunk(ReadChunk* chunk);
+
+    //! Copy data from the read ahead chunks, returns number of bytes copied
+    uint32_t readData(void* data, uint32_t size);
+
     //! Base file name
     std::string baseName_;
 
@@ -92,6 +145,15 @@ class StreamReader : public rogue::interfaces::stream::Master {
 
     //! Return true while reading
     bool isActive();
+
+    //! Set io_uring flag, takes effect on the next open
+    /** Multiple read ahead chunks are kept in flight using registered buffers.
+     * Falls back to blocking reads when io_uring is not available.
+     */
+    void setIoUring(bool enable);
+
+    //! Get io_uring state, true if reads are using io_uring
+    bool getIoUring();
 };
 
 // Convenience
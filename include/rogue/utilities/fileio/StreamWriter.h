@@ -34,15 +34,20 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
 #include "rogue/interfaces/stream/Frame.h"
+#include "rogue/utilities/fileio/IoUring.h"
 
 namespace rogue {
 namespace utilities {
@@ -54,6 +59,122 @@ class StreamWriterChannel;
 class StreamWriter : public rogue::EnableSharedFromThis<rogue::utilities::fileio::StreamWriter> {
     friend class StreamWriterChannel;
 
+    //! Write buffer owned by the asynchronous writer
+    struct AsyncBuffer {
+        uint8_t* data;
+        uint32_t size;
+        int32_t fd;
+        uint64_t offset;
+        int32_t index;
+        bool pending;
+    };
+
+    //! Alignment of write buffers, required for O_DIRECT
+    static const uint32_t Alignment = 4096;
+
+    //! Buffer size used in asynchronous mode when buffering is disabled
+    static const uint32_t DefaultAsyncSize = 4194304;
+
+    //! Number of asynchronous buffers, zero when disabled
+    uint32_t asyncDepth_;
+
+    //! Size of each asynchronous buffer
+    uint32_t asyncSize_;
+
+    //! Asynchronous buffer storage
+    std::vector<AsyncBuffer> asyncBuffers_;
+
+    //! Buffer currently being filled
+    AsyncBuffer* active_;
+
+    //! Buffers waiting to be written and buffers free to be filled
+    std::deque<AsyncBuffer*> fullQueue_;
+    std::deque<AsyncBuffer*> freeQueue_;
+
+    //! Writer thread state, protected by queueMtx_
+    std::mutex queueMtx_;
+    std::condition_variable queueCond_;
+    std::thread* writeThread_;
+    bool threadEn_;
+    bool writerBusy_;
+
+    //! Set by the writer thread when a write fails
+    std::atomic<bool> writeError_;
+
+    //! Open files with O_DIRECT
+    std::atomic<bool> directIo_;
+
+    //! Bytes between fdatasync calls, zero to disable
+    std::atomic<uint64_t> syncInterval_;
+
+    //! Use io_uring in asynchronous mode
+    bool ioUring_;
+
+    //! Ring used by the writer thread, NULL when disabled or not supported
+    rogue::utilities::fileio::IoUringPtr ring_;
+
+    //! Number of writes in flight and start of the current busy period
+    uint32_t ringCount_;
+    std::chrono::steady_clock::time_point ringStart_;
+
+    //! State of the descriptor being written, owned by the writing context
+    int32_t wrFd_;
+    uint64_t wrOffset_;
+    uint64_t wrSync_;
+    bool wrDirect_;
+
+    //! Statistics
+    std::atomic<uint32_t> queuePeak_;
+    std::atomic<uint32_t> stallCount_;
+    std::atomic<uint64_t> stallTime_;
+    std::atomic<uint64_t> writeBytes_;
+    std::atomic<uint64_t> writeTime_;
+
+    //! Open a file with the configured flags
+    int32_t openFile(std::string name);
+
+    //! Flush, wait for pending writes and close the current file
+    void closeFile();
+
+    //! Track descriptor state before a write, returns the write offset
+    uint64_t prepareWrite(int32_t fd, uint8_t* data, uint32_t size);
+
+    //! Return true if a write is eligible for O_DIRECT
+    bool wantDirect(uint8_t* data, uint32_t size);
+
+    //! Write a complete block at an offset
+    bool writeAll(int32_t fd, uint8_t* data, uint32_t size, uint64_t offset);
+
+    //! Update counters after a write and apply the sync policy
+    void writeDone(int32_t fd, uint32_t size);
+
+    //! Write a block to a descriptor, handles O_DIRECT and sync policy
+    bool writeBlock(int32_t fd, uint8_t* data, uint32_t size);
+
+    //! Queue a buffer to the io_uring, called from writer thread
+    void ringWrite(AsyncBuffer* buff);
+
+    //! Wait for an io_uring write completion, called from writer thread
+    void ringComplete();
+
+    //! Return a buffer to the free list
+    void returnBuffer(AsyncBuffer* buff);
+
+    //! Allocate write buffers, call with lock held
+    void allocBuffers(uint32_t size, uint32_t depth);
+
+    //! Free write buffers, call with lock held
+    void freeBuffers();
+
+    //! Wait for a free asynchronous buffer
+    void acquireBuffer();
+
+    //! Wait for the writer thread to become idle
+    void drain();
+
+    //! Asynchronous writer thread
+    void runThread();
+
   protected:
     // Log
     std::shared_ptr<rogue::Logging> log_;
@@ -145,6 +266,54 @@ class StreamWriter : public rogue::EnableSharedFromThis<rogue::utilities::fileio
     //! Set drop errors flag
     void setDropErrors(bool drop);
 
+    //! Set number of buffers for asynchronous writes, 0 to disable
+    /** When enabled frames are copied into a pool of aligned buffers which are
+     * written to disk by a dedicated thread. The caller only blocks when all
+     * buffers are waiting to be written. Values less than 2 are raised to 2.
+     */
+    void setAsync(uint32_t depth);
+
+    //! Get number of asynchronous buffers, 0 if disabled
+    uint32_t getAsync();
+
+    //! Set O_DIRECT flag, takes effect on the next file open
+    /** Full buffers are written directly to the device, bypassing the page
+     * cache. The buffer size should be a multiple of 4096. Writes which do not
+     * meet the alignment requirement fall back to cached writes.
+     */
+    void setDirectIo(bool enable);
+
+    //! Set number of bytes between fdatasync calls, 0 to disable
+    void setSyncInterval(uint64_t bytes);
+
+    //! Set io_uring flag, used in asynchronous mode when supported
+    /** Each asynchronous buffer is registered with the ring and up to the
+     * asynchronous depth writes are kept in flight. Falls back to blocking
+     * writes when io_uring is not available.
+     */
+    void setIoUring(bool enable);
+
+    //! Get io_uring state, true if writes are using io_uring
+    bool getIoUring();
+
+    //! Get number of buffers waiting to be written
+    uint32_t getWriteQueueDepth();
+
+    //! Get peak number of buffers waiting to be written
+    uint32_t getWriteQueuePeak();
+
+    //! Get number of times a write blocked waiting for a free buffer
+    uint32_t getStallCount();
+
+    //! Get total time in seconds spent waiting for a free buffer
+    double getStallTime();
+
+    //! Get disk write bandwidth in bytes per second
+    double getWriteBandwidth();
+
+    //! Reset write statistics
+    void resetStats();
+
     //! Get a port
     std::shared_ptr<rogue::utilities::fileio::StreamWriterChannel> getChannel(uint8_t channel);
 
@@ -107,6 +107,9 @@ class PrbsTx(pyrogue.Device):
         self.add(pyrogue.LocalVariable(name='txEnable', description='PRBS Run Enable', mode='RW',
                                        value=False, localSet=self._txEnable))
 
+        self.add(pyrogue.LocalVariable(name='txThreads', description='PRBS Generation Threads', mode='RW',
+                                       value=1, typeStr='UInt32', localSet=self._txThreads))
+
         self.add(pyrogue.LocalCommand(name='genFrame',description='Generate n frames',value=1,
                                       function=self._genFrame))
 
@@ -146,6 +149,10 @@ class PrbsTx(pyrogue.Device):
             self._prbs.disable()
             self._prbs.enable(value)
 
+    def _txThreads(self,value,changed):
+        if changed:
+            self._prbs.setTxThreads(value)
+
     def _txEnable(self,value,changed):
         if changed:
             if int(value) == 0:
@@ -57,6 +57,9 @@ std::mutex rogue::Logging::levelMtx_;
 // Filter list
 std::vector<rogue::LogFilter*> rogue::Logging::filters_;
 
+// Configuration counter
+std::atomic<uint32_t> rogue::Logging::config_(0);
+
 // Crate logger
 rogue::LoggingPtr rogue::Logging::create(std::string name, bool quiet) {
     rogue::LoggingPtr log = std::make_shared<rogue::Logging>(name, quiet);
@@ -64,22 +67,38 @@ rogue::LoggingPtr rogue::Logging::create(std::string name, bool quiet) {
 }
 
 rogue::Logging::Logging(std::string name, bool quiet) {
-    std::vector<rogue::LogFilter*>::iterator it;
-
     name_ = "pyrogue." + name;
 
     levelMtx_.lock();
+    intLevel();
+    levelMtx_.unlock();
 
-    level_ = gblLevel_;
+    if (!quiet) warning("Starting logger with level = %" PRIu32, (uint32_t)level_);
+}
+
+// Compute local level, lock must be held
+void rogue::Logging::intLevel() {
+    std::vector<rogue::LogFilter*>::iterator it;
+    uint32_t level;
+
+    localConfig_ = config_.load();
+    level        = gblLevel_;
 
     for (it = filters_.begin(); it < filters_.end(); it++) {
         if (name_.find((*it)->name_) == 0) {
-            if ((*it)->level_ < level_) level_ = (*it)->level_;
+            if ((*it)->level_ < level) level = (*it)->level_;
         }
     }
-    levelMtx_.unlock();
+    level_ = level;
+}
 
-    if (!quiet) warning("Starting logger with level = %" PRIu32, level_);
+// Recompute local level after a configuration change
+void rogue::Logging::refreshLevel() {
+    if (localConfig_.load() == config_.load()) return;
+
+    levelMtx_.lock();
+    intLevel();
+    levelMtx_.unlock();
 }
 
 rogue::Logging::~Logging() {}
@@ -87,6 +106,7 @@ rogue::Logging::~Logging() {}
 void rogue::Logging::setLevel(uint32_t level) {
     levelMtx_.lock();
     gblLevel_ = level;
+    config_++;
     levelMtx_.unlock();
 }
 
@@ -96,6 +116,7 @@ void rogue::Logging::setFilter(std::string name, uint32_t level) {
     rogue::LogFilter* flt = new rogue::LogFilter(name, level);
 
     filters_.push_back(flt);
+    config_++;
 
     levelMtx_.unlock();
 }
@@ -26,9 +26,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <memory>
-#include <thread>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -36,6 +38,11 @@
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/TransactionLock.h"
 
+#if defined(__x86_64__) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ROGUE_MEM_MAP_SSE2
+#endif
+
 namespace rh  = rogue::hardware;
 namespace rim = rogue::interfaces::memory;
 
@@ -54,7 +61,10 @@ rh::MemMapPtr rh::MemMap::create(uint64_t base, uint32_t size) {
 rh::MemMap::MemMap(uint64_t base, uint32_t size) : rim::Slave(4, 0xFFFFFFFF) {
     log_ = rogue::Logging::create("MemMap");
 
-    size_ = size;
+    size_  = size;
+    width_ = 4;
+
+    resetStats();
 
     fd_ = ::open(MAP_DEVICE, O_RDWR);
 
@@ -65,9 +75,10 @@ rh::MemMap::MemMap(uint64_t base, uint32_t size) : rim::Slave(4, 0xFFFFFFFF) {
 
     log_->debug("Created map to 0x%" PRIx64 " with size 0x%" PRIx32, base, size);
 
-    // Start read thread
+    // Start transaction workers
     threadEn_ = true;
-    thread_   = new std::thread(&rh::MemMap::runThread, this);
+    workers_  = rh::MemWorkerPool::create(std::bind(&rh::MemMap::processTransaction, this, std::placeholders::_1),
+                                         "MemMap");
 }
 
 //! Destructor
@@ -79,8 +90,7 @@ void rh::MemMap::stop() {
     if (threadEn_) {
         rogue::GilRelease noGil;
         threadEn_ = false;
-        queue_.stop();
-        thread_->join();
+        workers_->stop();
         munmap((void*)map_, size_);
         ::close(fd_);
     }
@@ -88,78 +98,175 @@ void rh::MemMap::stop() {
 
 //! Post a transaction
 void rh::MemMap::doTransaction(rim::TransactionPtr tran) {
-    rogue::GilRelease noGil;
-    queue_.push(tran);
+    workers_->push(tran);
 }
 
-//! Working Thread
-void rh::MemMap::runThread() {
-    rim::TransactionPtr tran;
-
-    uint32_t* tPtr;
-    uint32_t* mPtr;
-    uint32_t count;
+//! Get the transaction worker pool
+rh::MemWorkerPoolPtr rh::MemMap::getWorkers() {
+    return workers_;
+}
 
-    log_->logThreadId();
+//! Set the max register access width
+void rh::MemMap::setAccessWidth(uint32_t width) {
+    if (width != 4 && width != 8 && width != 16)
+        throw(rogue::GeneralError::create("MemMap::setAccessWidth",
+                                          "Invalid access width %" PRIu32 ", must be 4, 8 or 16",
+                                          width));
+    width_ = width;
+}
 
-    while (threadEn_) {
-        if ((tran = queue_.pop()) != NULL) {
-            count = 0;
+//! Get the max register access width in bytes
+uint32_t rh::MemMap::getAccessWidth() {
+    return width_;
+}
 
-            rim::TransactionLockPtr lock = tran->lock();
+//! Get number of completed transactions
+uint64_t rh::MemMap::getTranCount() {
+    return tranCount_;
+}
 
-            if (tran->expired()) {
-                log_->warning("Transaction expired. Id=%" PRIu32, tran->id());
-                tran.reset();
-                continue;
-            }
+//! Get number of bytes transferred by completed transactions
+uint64_t rh::MemMap::getByteCount() {
+    return byteCount_;
+}
 
-            if ((tran->size() % 4) != 0) {
-                tran->error("Invalid transaction size %" PRIu32 ", must be an integer number of 4 bytes", tran->size());
-                tran.reset();
-                continue;
-            }
+//! Get time spent in register accesses in seconds
+double rh::MemMap::getTranTime() {
+    return (double)tranTime_ / 1.0e9;
+}
 
-            // Check that the address is legal
-            if ((tran->address() + tran->size()) > size_) {
-                tran->error("Request transaction to address 0x%" PRIx64 " with size %" PRIu32 " is out of bounds",
-                            tran->address(),
-                            tran->size());
-                tran.reset();
-                continue;
-            }
+//! Get register access rate in bytes per second
+double rh::MemMap::getTranRate() {
+    uint64_t time = tranTime_;
 
-            tPtr = (uint32_t*)tran->begin();
-            mPtr = (uint32_t*)(map_ + tran->address());
+    if (time == 0) return 0.0;
+    return (double)byteCount_ * 1.0e9 / (double)time;
+}
 
-            while (count != tran->size()) {
-                // Write or post
-                if (tran->type() == rim::Write || tran->type() == rim::Post) *mPtr = *tPtr;
+//! Reset the transaction statistics
+void rh::MemMap::resetStats() {
+    tranCount_ = 0;
+    byteCount_ = 0;
+    tranTime_  = 0;
+}
 
-                // Read or verify
-                else
-                    *tPtr = *mPtr;
+//! Copy between mapped register space and memory
+void rh::MemMap::regCopy(volatile uint8_t* reg, uint8_t* data, uint32_t size, uint32_t width, bool write) {
+    uint64_t d64;
+    uint32_t d32;
+
+    // Accesses are never narrower than 32 bits, a partial word would run past the end
+    if ((size % 4) != 0)
+        throw(rogue::GeneralError::create("MemMap::regCopy",
+                                          "Invalid copy size %" PRIu32 ", must be an integer number of 4 bytes",
+                                          size));
+
+    while (size > 0) {
+#ifdef ROGUE_MEM_MAP_SSE2
+        // 128-bit access, a single SSE2 load or store
+        if (width >= 16 && size >= 16 && ((uintptr_t)reg & 0xF) == 0) {
+            if (write)
+                _mm_store_si128((__m128i*)reg, _mm_loadu_si128((const __m128i*)data));
+            else
+                _mm_storeu_si128((__m128i*)data, _mm_load_si128((const __m128i*)reg));
+            reg += 16;
+            data += 16;
+            size -= 16;
+            continue;
+        }
+#endif
 
-                ++mPtr;
-                ++tPtr;
-                count += 4;
+        // 64-bit access, a 128-bit access is split when SSE2 is not available
+        if (width >= 8 && size >= 8 && ((uintptr_t)reg & 0x7) == 0) {
+            if (write) {
+                std::memcpy(&d64, data, 8);
+                *((volatile uint64_t*)reg) = d64;
+            } else {
+                d64 = *((volatile uint64_t*)reg);
+                std::memcpy(data, &d64, 8);
             }
+            reg += 8;
+            data += 8;
+            size -= 8;
+            continue;
+        }
 
-            log_->debug("Transaction id=%" PRIu32 ", addr 0x%08" PRIx64 ". Size=%" PRIu32 ", type=%" PRIu32,
-                        tran->id(),
-                        tran->address(),
-                        tran->size(),
-                        tran->type());
-            tran->done();
+        // 32-bit access
+        if (write) {
+            std::memcpy(&d32, data, 4);
+            *((volatile uint32_t*)reg) = d32;
+        } else {
+            d32 = *((volatile uint32_t*)reg);
+            std::memcpy(data, &d32, 4);
         }
+        reg += 4;
+        data += 4;
+        size -= 4;
+    }
+
+    // Order the accesses with those of the next transaction
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+//! Service a transaction, called by the workers
+void rh::MemMap::processTransaction(rim::TransactionPtr tran) {
+    std::chrono::steady_clock::time_point start;
+    std::chrono::nanoseconds dur;
+
+    rim::TransactionLockPtr lock = tran->lock();
+
+    if (tran->expired()) {
+        log_->warning("Transaction expired. Id=%" PRIu32, tran->id());
+        return;
+    }
+
+    if ((tran->size() % 4) != 0) {
+        tran->error("Invalid transaction size %" PRIu32 ", must be an integer number of 4 bytes", tran->size());
+        return;
     }
+
+    // Check that the address is legal
+    if ((tran->address() + tran->size()) > size_) {
+        tran->error("Request transaction to address 0x%" PRIx64 " with size %" PRIu32 " is out of bounds",
+                    tran->address(),
+                    tran->size());
+        return;
+    }
+
+    start = std::chrono::steady_clock::now();
+
+    regCopy(map_ + tran->address(),
+            tran->begin(),
+            tran->size(),
+            width_,
+            tran->type() == rim::Write || tran->type() == rim::Post);
+
+    dur = std::chrono::steady_clock::now() - start;
+    tranTime_ += dur.count();
+    byteCount_ += tran->size();
+    tranCount_++;
+
+    log_->debug("Transaction id=%" PRIu32 ", addr 0x%08" PRIx64 ". Size=%" PRIu32 ", type=%" PRIu32,
+                tran->id(),
+                tran->address(),
+                tran->size(),
+                tran->type());
+    tran->done();
 }
 
 void rh::MemMap::setup_python() {
 #ifndef NO_PYTHON
 
     bp::class_<rh::MemMap, rh::MemMapPtr, bp::bases<rim::Slave>, boost::noncopyable>("MemMap",
-                                                                                     bp::init<uint64_t, uint32_t>());
+                                                                                     bp::init<uint64_t, uint32_t>())
+        .def("getWorkers", &rh::MemMap::getWorkers)
+        .def("setAccessWidth", &rh::MemMap::setAccessWidth)
+        .def("getAccessWidth", &rh::MemMap::getAccessWidth)
+        .def("getTranCount", &rh::MemMap::getTranCount)
+        .def("getByteCount", &rh::MemMap::getByteCount)
+        .def("getTranTime", &rh::MemMap::getTranTime)
+        .def("getTranRate", &rh::MemMap::getTranRate)
+        .def("resetStats", &rh::MemMap::resetStats);
 
     bp::implicitly_convertible<rh::MemMapPtr, rim::SlavePtr>();
 #endif
@@ -0,0 +1,328 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Memory Transaction Worker Pool
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/hardware/MemWorkerPool.h"
+
+#include <inttypes.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+
+namespace rh  = rogue::hardware;
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+rh::MemWorkerPoolPtr rh::MemWorkerPool::create(std::function<void(rim::TransactionPtr)> handler, std::string name) {
+    rh::MemWorkerPoolPtr r = std::make_shared<rh::MemWorkerPool>(handler, name);
+    return (r);
+}
+
+//! Creator
+rh::MemWorkerPool::MemWorkerPool(std::function<void(rim::TransactionPtr)> handler, std::string name) {
+    handler_    = handler;
+    log_        = rogue::Logging::create(name);
+    threadEn_   = false;
+    stopped_    = false;
+    regionBits_ = 16;
+    batchSize_  = 16;
+
+    resetStats();
+
+    std::lock_guard<std::mutex> lock(ctrlMtx_);
+    startThreads(1);
+}
+
+//! Destructor
+rh::MemWorkerPool::~MemWorkerPool() {
+    this->stop();
+}
+
+//! Stop the workers
+void rh::MemWorkerPool::stop() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(ctrlMtx_);
+
+    if (stopped_) return;
+
+    {
+        std::lock_guard<std::mutex> qLock(mtx_);
+        stopped_ = true;
+        queue_.clear();
+    }
+    stopThreads();
+}
+
+//! Start the worker threads
+void rh::MemWorkerPool::startThreads(uint32_t count) {
+    uint32_t x;
+
+    threadEn_ = true;
+    for (x = 0; x < count; x++) threads_.push_back(new std::thread(&rh::MemWorkerPool::runThread, this));
+}
+
+//! Stop the worker threads
+void rh::MemWorkerPool::stopThreads() {
+    std::vector<std::thread*>::iterator it;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        threadEn_ = false;
+        cond_.notify_all();
+    }
+
+    for (it = threads_.begin(); it != threads_.end(); ++it) {
+        (*it)->join();
+        delete (*it);
+    }
+    threads_.clear();
+}
+
+//! Queue a transaction
+void rh::MemWorkerPool::push(rim::TransactionPtr tran) {
+    Entry entry;
+
+    entry.tran = tran;
+    entry.time = std::chrono::steady_clock::now();
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (stopped_) return;
+
+    entry.region = tran->address() >> regionBits_;
+    queue_.push_back(entry);
+    cond_.notify_one();
+}
+
+//! Worker thread
+void rh::MemWorkerPool::runThread() {
+    std::vector<Entry> batch;
+    std::deque<Entry>::iterator it;
+    std::vector<Entry>::iterator bIt;
+    uint64_t region;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    uint64_t queueTime;
+    uint64_t queueMax;
+    uint64_t serviceTime;
+    uint64_t serviceMax;
+    uint64_t wait;
+    uint64_t dur;
+
+    log_->logThreadId();
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (threadEn_) {
+        // Find the oldest transaction of an idle region
+        for (it = queue_.begin(); it != queue_.end() && busy_.count(it->region) != 0; ++it) {}
+
+        if (it == queue_.end()) {
+            cond_.wait(lock);
+            continue;
+        }
+
+        // Take the run of transactions of the region which follow it in the queue,
+        // a transaction is never taken ahead of an older one for another idle region
+        region = it->region;
+        busy_.insert(region);
+
+        while (it != queue_.end() && it->region == region && batch.size() < batchSize_) {
+            batch.push_back(*it);
+            it = queue_.erase(it);
+        }
+
+        // Queue may hold transactions for other workers
+        if (!queue_.empty()) cond_.notify_one();
+        lock.unlock();
+
+        queueTime   = 0;
+        queueMax    = 0;
+        serviceTime = 0;
+        serviceMax  = 0;
+        start       = std::chrono::steady_clock::now();
+
+        for (bIt = batch.begin(); bIt != batch.end(); ++bIt) {
+            wait = std::chrono::duration_cast<std::chrono::nanoseconds>(start - bIt->time).count();
+            handler_(bIt->tran);
+            end = std::chrono::steady_clock::now();
+
+            dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            queueTime += wait;
+            serviceTime += dur;
+            if (wait > queueMax) queueMax = wait;
+            if (dur > serviceMax) serviceMax = dur;
+
+            bIt->tran.reset();
+            start = end;
+        }
+
+        lock.lock();
+
+        tranCount_ += batch.size();
+        queueTime_ += queueTime;
+        serviceTime_ += serviceTime;
+        if (queueMax > queueMax_) queueMax_ = queueMax;
+        if (serviceMax > serviceMax_) serviceMax_ = serviceMax;
+
+        // Release the region, its next transactions may be taken by any worker
+        busy_.erase(region);
+        batch.clear();
+        if (!queue_.empty()) cond_.notify_all();
+    }
+}
+
+//! Set the number of worker threads
+void rh::MemWorkerPool::setWorkerCount(uint32_t count) {
+    if (count == 0) throw(rogue::GeneralError("MemWorkerPool::setWorkerCount", "Worker count must be at least 1"));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(ctrlMtx_);
+
+    if (stopped_ || count == threads_.size()) return;
+
+    stopThreads();
+    startThreads(count);
+}
+
+//! Get the number of worker threads
+uint32_t rh::MemWorkerPool::getWorkerCount() {
+    std::lock_guard<std::mutex> lock(ctrlMtx_);
+    return threads_.size();
+}
+
+//! Set the size of the address regions which keep their order
+void rh::MemWorkerPool::setRegionSize(uint64_t size) {
+    uint32_t bits;
+
+    if (size == 0 || (size & (size - 1)) != 0)
+        throw(rogue::GeneralError::create("MemWorkerPool::setRegionSize",
+                                          "Invalid region size 0x%" PRIx64 ", must be a power of 2",
+                                          size));
+
+    for (bits = 0; (1ULL << bits) != size; bits++) {}
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // Queued transactions keep the regions they were queued with
+    regionBits_ = bits;
+}
+
+//! Get the region size in bytes
+uint64_t rh::MemWorkerPool::getRegionSize() {
+    return 1ULL << regionBits_;
+}
+
+//! Set the max number of transactions a worker takes at once
+void rh::MemWorkerPool::setBatchSize(uint32_t size) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    batchSize_ = (size == 0) ? 1 : size;
+}
+
+//! Get the max number of transactions a worker takes at once
+uint32_t rh::MemWorkerPool::getBatchSize() {
+    return batchSize_;
+}
+
+//! Get the number of transactions waiting in the queue
+uint32_t rh::MemWorkerPool::getQueueSize() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return queue_.size();
+}
+
+//! Get number of serviced transactions
+uint64_t rh::MemWorkerPool::getTranCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return tranCount_;
+}
+
+//! Get mean time transactions waited in the queue
+double rh::MemWorkerPool::getQueueLatency() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (tranCount_ == 0) return 0.0;
+    return (double)queueTime_ / (double)tranCount_ / 1.0e9;
+}
+
+//! Get max time a transaction waited in the queue
+double rh::MemWorkerPool::getQueueLatencyMax() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (double)queueMax_ / 1.0e9;
+}
+
+//! Get mean transaction service time
+double rh::MemWorkerPool::getServiceTime() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (tranCount_ == 0) return 0.0;
+    return (double)serviceTime_ / (double)tranCount_ / 1.0e9;
+}
+
+//! Get max transaction service time
+double rh::MemWorkerPool::getServiceTimeMax() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (double)serviceMax_ / 1.0e9;
+}
+
+//! Reset the statistics
+void rh::MemWorkerPool::resetStats() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    tranCount_   = 0;
+    queueTime_   = 0;
+    queueMax_    = 0;
+    serviceTime_ = 0;
+    serviceMax_  = 0;
+}
+
+void rh::MemWorkerPool::setup_python() {
+#ifndef NO_PYTHON
+
+    bp::class_<rh::MemWorkerPool, rh::MemWorkerPoolPtr, boost::noncopyable>("MemWorkerPool", bp::no_init)
+        .def("setWorkerCount", &rh::MemWorkerPool::setWorkerCount)
+        .def("getWorkerCount", &rh::MemWorkerPool::getWorkerCount)
+        .def("setRegionSize", &rh::MemWorkerPool::setRegionSize)
+        .def("getRegionSize", &rh::MemWorkerPool::getRegionSize)
+        .def("setBatchSize", &rh::MemWorkerPool::setBatchSize)
+        .def("getBatchSize", &rh::MemWorkerPool::getBatchSize)
+        .def("getQueueSize", &rh::MemWorkerPool::getQueueSize)
+        .def("getTranCount", &rh::MemWorkerPool::getTranCount)
+        .def("getQueueLatency", &rh::MemWorkerPool::getQueueLatency)
+        .def("getQueueLatencyMax", &rh::MemWorkerPool::getQueueLatencyMax)
+        .def("getServiceTime", &rh::MemWorkerPool::getServiceTime)
+        .def("getServiceTimeMax", &rh::MemWorkerPool::getServiceTimeMax)
+        .def("resetStats", &rh::MemWorkerPool::resetStats);
+#endif
+}
@@ -26,17 +26,20 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <memory>
-#include <thread>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
+#include "rogue/hardware/MemMap.h"
 #include "rogue/hardware/drivers/AxisDriver.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/TransactionLock.h"
 
+namespace rh  = rogue::hardware;
 namespace rha = rogue::hardware::axi;
 namespace rim = rogue::interfaces::memory;
 
@@ -46,13 +49,21 @@ namespace bp = boost::python;
 #endif
 
 //! Class creation
-rha::AxiMemMapPtr rha::AxiMemMap::create(std::string path) {
-    rha::AxiMemMapPtr r = std::make_shared<rha::AxiMemMap>(path);
+rha::AxiMemMapPtr rha::AxiMemMap::create(std::string path, uint32_t mapSize) {
+    rha::AxiMemMapPtr r = std::make_shared<rha::AxiMemMap>(path, mapSize);
     return (r);
 }
 
 //! Creator
-rha::AxiMemMap::AxiMemMap(std::string path) : rim::Slave(4, 0xFFFFFFFF) {
+rha::AxiMemMap::AxiMemMap(std::string path, uint32_t mapSize) : rim::Slave(4, 0xFFFFFFFF) {
+    void* ptr;
+
+    map_     = NULL;
+    mapSize_ = 0;
+    width_   = 4;
+
+    resetStats();
+
     fd_  = ::open(path.c_str(), O_RDWR);
     log_ = rogue::Logging::create("axi.AxiMemMap");
     if (fd_ < 0)
@@ -66,9 +77,23 @@ rha::AxiMemMap::AxiMemMap(std::string path) : rim::Slave(4, 0xFFFFFFFF) {
       To use later versions (64-bit address API),, you will need to upgrade both rogue and aes-stream-driver at the same time to:\n \
       \t\taes-stream-driver = v5.16.0 (or later)\n\t\trogue = v5.13.0 (or later)"));
 
-    // Start read thread
+    // Map register window, fall back to driver calls on failure
+    if (mapSize > 0) {
+        if ((ptr = dmaMapRegister(fd_, 0, mapSize)) == MAP_FAILED) {
+            log_->warning("Failed to map register window of 0x%" PRIx32 " bytes for %s, using driver calls",
+                          mapSize,
+                          path.c_str());
+        } else {
+            map_     = (volatile uint8_t*)ptr;
+            mapSize_ = mapSize;
+            log_->debug("Mapped register window of 0x%" PRIx32 " bytes for %s", mapSize, path.c_str());
+        }
+    }
+
+    // Start transaction workers
     threadEn_ = true;
-    thread_   = new std::thread(&rha::AxiMemMap::runThread, this);
+    workers_  = rh::MemWorkerPool::create(std::bind(&rha::AxiMemMap::processTransaction, this, std::placeholders::_1),
+                                         "axi.AxiMemMap");
 }
 
 //! Destructor
@@ -81,22 +106,76 @@ void rha::AxiMemMap::stop() {
     if (threadEn_) {
         rogue::GilRelease noGil;
         threadEn_ = false;
-        queue_.stop();
-        thread_->join();
+        workers_->stop();
+        if (map_ != NULL) dmaUnMapRegister(fd_, (void*)map_, mapSize_);
         ::close(fd_);
     }
 }
 
 //! Post a transaction
 void rha::AxiMemMap::doTransaction(rim::TransactionPtr tran) {
-    rogue::GilRelease noGil;
-    queue_.push(tran);
+    workers_->push(tran);
+}
+
+//! Get the transaction worker pool
+rh::MemWorkerPoolPtr rha::AxiMemMap::getWorkers() {
+    return workers_;
+}
+
+//! Set the max register access width for the window
+void rha::AxiMemMap::setAccessWidth(uint32_t width) {
+    if (width != 4 && width != 8 && width != 16)
+        throw(rogue::GeneralError::create("AxiMemMap::setAccessWidth",
+                                          "Invalid access width %" PRIu32 ", must be 4, 8 or 16",
+                                          width));
+    width_ = width;
+}
+
+//! Get the max register access width in bytes
+uint32_t rha::AxiMemMap::getAccessWidth() {
+    return width_;
+}
+
+//! Get the size of the mapped register window
+uint32_t rha::AxiMemMap::getMapSize() {
+    return mapSize_;
+}
+
+//! Get number of completed transactions
+uint64_t rha::AxiMemMap::getTranCount() {
+    return tranCount_;
+}
+
+//! Get number of bytes transferred by completed transactions
+uint64_t rha::AxiMemMap::getByteCount() {
+    return byteCount_;
 }
 
-//! Working Thread
-void rha::AxiMemMap::runThread() {
-    rim::TransactionPtr tran;
+//! Get time spent in register accesses in seconds
+double rha::AxiMemMap::getTranTime() {
+    return (double)tranTime_ / 1.0e9;
+}
+
+//! Get register access rate in bytes per second
+double rha::AxiMemMap::getTranRate() {
+    uint64_t time = tranTime_;
+
+    if (time == 0) return 0.0;
+    return (double)byteCount_ * 1.0e9 / (double)time;
+}
+
+//! Reset the transaction statistics
+void rha::AxiMemMap::resetStats() {
+    tranCount_ = 0;
+    byteCount_ = 0;
+    tranTime_  = 0;
+}
+
+//! Service a transaction, called by the workers
+void rha::AxiMemMap::processTransaction(rim::TransactionPtr tran) {
     rim::Transaction::iterator it;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::nanoseconds dur;
 
     uint32_t count;
     uint32_t data;
@@ -107,64 +186,84 @@ void rha::AxiMemMap::runThread() {
     dataSize = sizeof(uint32_t);
     ptr      = (uint8_t*)(&data);
 
-    log_->logThreadId();
+    if ((tran->size() % dataSize) != 0) {
+        tran->error("Invalid transaction size %" PRIu32 ", must be an integer number of %" PRIu32 " bytes",
+                    tran->size(),
+                    dataSize);
+        return;
+    }
+
+    count = 0;
+    ret   = 0;
 
-    while (threadEn_) {
-        if ((tran = queue_.pop()) != NULL) {
-            if ((tran->size() % dataSize) != 0) {
-                tran->error("Invalid transaction size %" PRIu32 ", must be an integer number of %" PRIu32 " bytes",
+    rim::TransactionLockPtr lock = tran->lock();
+
+    if (tran->expired()) {
+        log_->warning("Transaction expired. Id=%" PRIu32, tran->id());
+        return;
+    }
+
+    it    = tran->begin();
+    data  = 0;
+    start = std::chrono::steady_clock::now();
+
+    // Transaction is within the register window
+    if (map_ != NULL && (tran->address() + tran->size()) <= mapSize_) {
+        rh::MemMap::regCopy(map_ + tran->address(),
+                            it,
                             tran->size(),
-                            dataSize);
-                tran.reset();
-                continue;
-            }
-
-            count = 0;
-            ret   = 0;
-
-            rim::TransactionLockPtr lock = tran->lock();
-
-            if (tran->expired()) {
-                log_->warning("Transaction expired. Id=%" PRIu32, tran->id());
-                tran.reset();
-                continue;
-            }
-
-            it = tran->begin();
-
-            while ((ret == 0) && (count != tran->size())) {
-                if (tran->type() == rim::Write || tran->type() == rim::Post) {
-                    // Assume transaction has a contiguous memory block
-                    std::memcpy(ptr, it, dataSize);
-                    ret = dmaWriteRegister(fd_, tran->address() + count, data);
-                } else {
-                    ret = dmaReadRegister(fd_, tran->address() + count, &data);
-                    std::memcpy(it, ptr, dataSize);
-                }
-                count += dataSize;
-                it += dataSize;
-            }
-
-            log_->debug("Transaction id=%" PRIu32 ", addr 0x%016" PRIx64 ". Size=%" PRIu32 ", type=%" PRIu32
-                        ", data=0x%08" PRIu32,
-                        tran->id(),
-                        tran->address(),
-                        tran->size(),
-                        tran->type(),
-                        data);
-            if (ret != 0)
-                tran->error("Memory transaction failed with error code %" PRIi32 ", see driver error codes", ret);
-            else
-                tran->done();
+                            width_,
+                            tran->type() == rim::Write || tran->type() == rim::Post);
+        count = tran->size();
+    }
+
+    while ((ret == 0) && (count != tran->size())) {
+        if (tran->type() == rim::Write || tran->type() == rim::Post) {
+            // Assume transaction has a contiguous memory block
+            std::memcpy(ptr, it, dataSize);
+            ret = dmaWriteRegister(fd_, tran->address() + count, data);
+        } else {
+            ret = dmaReadRegister(fd_, tran->address() + count, &data);
+            std::memcpy(it, ptr, dataSize);
         }
+        count += dataSize;
+        it += dataSize;
+    }
+
+    dur = std::chrono::steady_clock::now() - start;
+    tranTime_ += dur.count();
+
+    log_->debug("Transaction id=%" PRIu32 ", addr 0x%016" PRIx64 ". Size=%" PRIu32 ", type=%" PRIu32
+                ", data=0x%08" PRIu32,
+                tran->id(),
+                tran->address(),
+                tran->size(),
+                tran->type(),
+                data);
+    if (ret != 0)
+        tran->error("Memory transaction failed with error code %" PRIi32 ", see driver error codes", ret);
+    else {
+        byteCount_ += tran->size();
+        tranCount_++;
+        tran->done();
     }
 }
 
 void rha::AxiMemMap::setup_python() {
 #ifndef NO_PYTHON
 
-    bp::class_<rha::AxiMemMap, rha::AxiMemMapPtr, bp::bases<rim::Slave>, boost::noncopyable>("AxiMemMap",
-                                                                                             bp::init<std::string>());
+    bp::class_<rha::AxiMemMap, rha::AxiMemMapPtr, bp::bases<rim::Slave>, boost::noncopyable>(
+        "AxiMemMap",
+        bp::init<std::string, bp::optional<uint32_t>>())
+        .def("getWorkers", &rha::AxiMemMap::getWorkers)
+        .def("setAccessWidth", &rha::AxiMemMap::setAccessWidth)
+        .def("getAccessWidth", &rha::AxiMemMap::getAccessWidth)
+        .def("getMapSize", &rha::AxiMemMap::getMapSize)
+        .def("getTranCount", &rha::AxiMemMap::getTranCount)
+        .def("getByteCount", &rha::AxiMemMap::getByteCount)
+        .def("getTranTime", &rha::AxiMemMap::getTranTime)
+        .def("getTranRate", &rha::AxiMemMap::getTranRate)
+        .def("resetStats", &rha::AxiMemMap::resetStats);
 
     bp::implicitly_convertible<rha::AxiMemMapPtr, rim::SlavePtr>();
 #endif
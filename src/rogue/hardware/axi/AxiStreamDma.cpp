@@ -24,6 +24,7 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#include <chrono>
 #include <memory>
 
 #include "rogue/GeneralError.h"
@@ -44,14 +45,28 @@ namespace bp = boost::python;
 
 std::map<std::string, std::shared_ptr<rha::AxiStreamDmaShared> > rha::AxiStreamDma::sharedBuffers_;
 
+const uint32_t rha::AxiStreamDma::RxBufferCount;
+const uint32_t rha::AxiStreamDma::RetBufferCount;
+
+rha::AxiStreamDmaRetBatch::AxiStreamDmaRetBatch() {
+    this->fd      = -1;
+    this->thold   = 1;
+    this->latency = 1000;
+}
+
 rha::AxiStreamDmaShared::AxiStreamDmaShared(std::string path) {
-    this->fd        = -1;
-    this->path      = path;
-    this->openCount = 1;
-    this->rawBuff   = NULL;
-    this->bCount    = 0;
-    this->bSize     = 0;
-    this->zCopyEn   = true;
+    this->fd          = -1;
+    this->path        = path;
+    this->openCount   = 1;
+    this->rawBuff     = NULL;
+    this->bCount      = 0;
+    this->bSize       = 0;
+    this->zCopyEn     = true;
+    this->rxShared    = false;
+    this->rxThread    = NULL;
+    this->rxThreadEn  = false;
+    this->rxSelfClose = false;
+    this->rxMask.resize(DMA_MASK_SIZE, 0);
 }
 
 //! Open shared buffer space
@@ -71,6 +86,8 @@ rha::AxiStreamDmaSharedPtr rha::AxiStreamDma::openShared(std::string path, rogue
         log->debug("Opening new shared file descriptor for %s", path.c_str());
     }
 
+    std::lock_guard<std::mutex> lock(ret->openMtx);
+
     // Check if already open
     if (ret->fd != -1) {
         ret->openCount++;
@@ -78,12 +95,31 @@ rha::AxiStreamDmaSharedPtr rha::AxiStreamDma::openShared(std::string path, rogue
         return ret;
     }
 
+    // Use the emulator in place of the driver when one exists for the path
+    ret->emu = rha::DmaEmulator::find(path);
+
     // Check if zero copy is disabled, if so don't open or map buffers
     if (!ret->zCopyEn) {
         log->debug("Zero copy is disabled. Not Mapping Buffers for %s", path.c_str());
         return ret;
     }
 
+    // Emulated device
+    if (ret->emu) {
+        if ((ret->fd = ret->emu->open()) < 0)
+            throw(rogue::GeneralError::create("AxiStreamDma::openShared",
+                                              "Failed to open emulated device: %s",
+                                              path.c_str()));
+
+        ret->rawBuff   = ret->emu->mapDma(&(ret->bCount), &(ret->bSize));
+        ret->ret.fd    = ret->fd;
+        ret->ret.emu   = ret->emu;
+        log->debug("Mapped emulated buffers. bCount = %i, bSize=%i for %s", ret->bCount, ret->bSize, path.c_str());
+
+        sharedBuffers_.insert(std::pair<std::string, rha::AxiStreamDmaSharedPtr>(path, ret));
+        return ret;
+    }
+
     // We need to open device and create shared buffers
     if ((ret->fd = ::open(path.c_str(), O_RDWR)) < 0)
         throw(rogue::GeneralError::create("AxiStreamDma::openShared", "Failed to open device file: %s", path.c_str()));
@@ -114,6 +150,8 @@ rha::AxiStreamDmaSharedPtr rha::AxiStreamDma::openShared(std::string path, rogue
     }
     log->debug("Mapped buffers. bCount = %i, bSize=%i for %s", ret->bCount, ret->bSize, path.c_str());
 
+    ret->ret.fd = ret->fd;
+
     // Add entry to map and return
     sharedBuffers_.insert(std::pair<std::string, rha::AxiStreamDmaSharedPtr>(path, ret));
     return ret;
@@ -121,17 +159,36 @@ rha::AxiStreamDmaSharedPtr rha::AxiStreamDma::openShared(std::string path, rogue
 
 //! Close shared buffer space
 void rha::AxiStreamDma::closeShared(rha::AxiStreamDmaSharedPtr desc) {
+    std::lock_guard<std::mutex> lock(desc->openMtx);
+
     desc->openCount--;
 
-    if (desc->openCount == 0) {
-        if (desc->rawBuff != NULL) { dmaUnMapDma(desc->fd, desc->rawBuff); }
+    // A receive thread which released the last instance closes it once it exits
+    if (desc->openCount == 0 && !desc->rxSelfClose) releaseShared(desc.get());
+}
+
+//! Close the file descriptor and unmap the buffers, open lock must be held
+void rha::AxiStreamDma::releaseShared(rha::AxiStreamDmaShared* desc) {
+    retFlush(&(desc->ret), true);
 
+    {
+        std::lock_guard<std::mutex> lock(desc->ret.mtx);
+        desc->ret.fd = -1;
+    }
+
+    if (desc->emu) {
+        if (desc->fd >= 0) desc->emu->close(desc->fd);
+    } else {
+        if (desc->rawBuff != NULL) { dmaUnMapDma(desc->fd, desc->rawBuff); }
         ::close(desc->fd);
-        desc->fd      = -1;
-        desc->bCount  = 0;
-        desc->bSize   = 0;
-        desc->rawBuff = NULL;
     }
+
+    desc->ret.emu.reset();
+    desc->emu.reset();
+    desc->fd      = -1;
+    desc->bCount  = 0;
+    desc->bSize   = 0;
+    desc->rawBuff = NULL;
 }
 
 //! Class creation
@@ -155,13 +212,34 @@ void rha::AxiStreamDma::zeroCopyDisable(std::string path) {
     sharedBuffers_.insert(std::pair<std::string, rha::AxiStreamDmaSharedPtr>(path, ret));
 }
 
+void rha::AxiStreamDma::sharedRxEnable(std::string path) {
+    std::map<std::string, rha::AxiStreamDmaSharedPtr>::iterator it;
+
+    // Entry already exists
+    if ((it = sharedBuffers_.find(path)) != sharedBuffers_.end()) {
+        if (it->second->fd != -1)
+            throw(rogue::GeneralError("AxiStreamDma::sharedRxEnable",
+                                      "sharedRxEnable can't be called after a device has been opened"));
+        it->second->rxShared = true;
+        return;
+    }
+
+    // Create new record
+    rha::AxiStreamDmaSharedPtr ret = std::make_shared<rha::AxiStreamDmaShared>(path);
+    ret->rxShared                  = true;
+
+    sharedBuffers_.insert(std::pair<std::string, rha::AxiStreamDmaSharedPtr>(path, ret));
+}
+
 //! Open the device. Pass destination.
 rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable) {
     uint8_t mask[DMA_MASK_SIZE];
 
     dest_     = dest;
     enSsi_    = ssiEnable;
-    retThold_ = 1;
+    ret_      = &ownRet_;
+    rxFrame_  = ris::Frame::create();
+    threadEn_ = false;
 
     // Create a shared pointer to use as a lock for runThread()
     std::shared_ptr<int> scopePtr = std::make_shared<int>(0);
@@ -174,11 +252,20 @@ rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable)
 
     // Attempt to open shared structure
     desc_ = openShared(path, log_);
+    emu_  = desc_->emu;
 
-    if (desc_->bCount >= 1000) retThold_ = 80;
+    // Receive through the shared engine
+    if (desc_->rxShared) {
+        if (desc_->rawBuff != NULL) {
+            sharedOpen();
+            return;
+        }
+        log_->warning("Shared receive engine requires zero copy mode, using a receive thread for dest 0x%" PRIx32,
+                      dest);
+    }
 
     // Open non shared file descriptor
-    if ((fd_ = ::open(path.c_str(), O_RDWR)) < 0) {
+    if ((fd_ = (emu_ ? emu_->open() : ::open(path.c_str(), O_RDWR))) < 0) {
         closeShared(desc_);
         throw(
             rogue::GeneralError::create("AxiStreamDma::AxiStreamDma", "Failed to open device file: %s", path.c_str()));
@@ -186,17 +273,27 @@ rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable)
 
     // Zero copy is disabled
     if (desc_->rawBuff == NULL) {
-        desc_->bCount = dmaGetTxBuffCount(fd_) + dmaGetRxBuffCount(fd_);
-        desc_->bSize  = dmaGetBuffSize(fd_);
+        if (emu_) {
+            desc_->bCount = emu_->getTxBuffCount() + emu_->getRxBuffCount();
+            desc_->bSize  = emu_->getBuffSize();
+        } else {
+            desc_->bCount = dmaGetTxBuffCount(fd_) + dmaGetRxBuffCount(fd_);
+            desc_->bSize  = dmaGetBuffSize(fd_);
+        }
     }
-    if (desc_->bCount >= 1000) retThold_ = 80;
+
+    ownRet_.fd  = fd_;
+    ownRet_.emu = emu_;
 
     dmaInitMaskBytes(mask);
     dmaAddMaskBytes(mask, dest_);
 
-    if (dmaSetMaskBytes(fd_, mask) < 0) {
+    if ((emu_ ? emu_->setMaskBytes(fd_, mask) : dmaSetMaskBytes(fd_, mask)) < 0) {
         closeShared(desc_);
-        ::close(fd_);
+        if (emu_)
+            emu_->close(fd_);
+        else
+            ::close(fd_);
         throw(rogue::GeneralError::create("AxiStreamDma::AxiStreamDma",
                                           "Failed to open device file %s with dest 0x%" PRIx32
                                           "! Another process may already have it open!",
@@ -214,6 +311,86 @@ rha::AxiStreamDma::AxiStreamDma(std::string path, uint32_t dest, bool ssiEnable)
 #endif
 }
 
+//! Register with the shared receive engine
+void rha::AxiStreamDma::sharedOpen() {
+    std::vector<uint8_t> mask;
+
+    std::lock_guard<std::mutex> lock(desc_->rxMtx);
+
+    mask = desc_->rxMask;
+    dmaAddMaskBytes(mask.data(), dest_);
+
+    if (desc_->rxDest.count(dest_) != 0 ||
+        (emu_ ? emu_->setMaskBytes(desc_->fd, mask.data()) : dmaSetMaskBytes(desc_->fd, mask.data())) < 0) {
+        closeShared(desc_);
+        throw(rogue::GeneralError::create("AxiStreamDma::AxiStreamDma",
+                                          "Failed to open device file %s with dest 0x%" PRIx32
+                                          "! Another process may already have it open!",
+                                          desc_->path.c_str(),
+                                          dest_));
+    }
+
+    desc_->rxMask        = mask;
+    desc_->rxDest[dest_] = this;
+
+    // Transmit and buffer returns also use the shared descriptor
+    fd_       = desc_->fd;
+    ret_      = &(desc_->ret);
+    threadEn_ = true;
+    thread_   = NULL;
+
+    // Start the shared thread with the first destination, a thread which is
+    // exiting after releasing the last destination is kept running instead
+    if (desc_->rxThread != NULL) {
+        desc_->rxThreadEn  = true;
+        desc_->rxSelfClose = false;
+    } else {
+        desc_->rxThreadEn = true;
+        desc_->rxThread   = new std::thread(&rha::AxiStreamDma::runShared, desc_.get());
+
+#ifndef __MACH__
+        pthread_setname_np(desc_->rxThread->native_handle(), "AxiStreamDmaRx");
+#endif
+    }
+}
+
+//! Unregister from the shared receive engine
+void rha::AxiStreamDma::sharedClose() {
+    std::thread* thread = NULL;
+    uint32_t byte;
+
+    {
+        std::lock_guard<std::mutex> lock(desc_->rxMtx);
+
+        byte = dest_ / 8;
+        if (byte < DMA_MASK_SIZE) desc_->rxMask[byte] &= ~(1 << (dest_ % 8));
+        desc_->rxDest.erase(dest_);
+
+        // Release the destination, the last instance stops the thread. When released by the
+        // receive thread itself, the thread exits and closes the file descriptor on its own.
+        if (desc_->rxDest.empty()) {
+            desc_->rxThreadEn = false;
+
+            if (desc_->rxThread != NULL && desc_->rxThread->get_id() == std::this_thread::get_id()) {
+                desc_->rxSelfClose = true;
+            } else {
+                thread             = desc_->rxThread;
+                desc_->rxThread    = NULL;
+                desc_->rxSelfClose = false;
+            }
+        } else if (emu_) {
+            emu_->setMaskBytes(desc_->fd, desc_->rxMask.data());
+        } else {
+            dmaSetMaskBytes(desc_->fd, desc_->rxMask.data());
+        }
+    }
+
+    if (thread != NULL) {
+        thread->join();
+        delete thread;
+    }
+}
+
 //! Close the device
 rha::AxiStreamDma::~AxiStreamDma() {
     this->stop();
@@ -225,10 +402,27 @@ void rha::AxiStreamDma::stop() {
 
         // Stop read thread
         threadEn_ = false;
-        thread_->join();
+
+        if (thread_ == NULL) {
+            sharedClose();
+        } else {
+            thread_->join();
+
+            // Return waiting buffers before closing
+            retFlush(&ownRet_, true);
+
+            {
+                std::lock_guard<std::mutex> lock(ownRet_.mtx);
+                ownRet_.fd = -1;
+            }
+
+            if (emu_)
+                emu_->close(fd_);
+            else
+                ::close(fd_);
+        }
 
         closeShared(desc_);
-        ::close(fd_);
         fd_ = -1;
     }
 }
@@ -244,12 +438,28 @@ void rha::AxiStreamDma::setTimeout(uint32_t timeout) {
 
 //! Set driver debug level
 void rha::AxiStreamDma::setDriverDebug(uint32_t level) {
-    dmaSetDebug(fd_, level);
+    if (!emu_) dmaSetDebug(fd_, level);
 }
 
 //! Strobe ack line
 void rha::AxiStreamDma::dmaAck() {
-    if (fd_ >= 0) axisReadAck(fd_);
+    if (fd_ >= 0 && !emu_) axisReadAck(fd_);
+}
+
+//! Set buffer return threshold
+void rha::AxiStreamDma::setRetThold(uint32_t count) {
+    std::lock_guard<std::mutex> lock(ret_->mtx);
+    if (count == 0) count = 1;
+
+    // Limit of a single driver return call
+    if (count > RetBufferCount) count = RetBufferCount;
+    ret_->thold = count;
+}
+
+//! Set buffer return latency
+void rha::AxiStreamDma::setRetLatency(uint32_t latency) {
+    std::lock_guard<std::mutex> lock(ret_->mtx);
+    ret_->latency = latency;
 }
 
 //! Generate a buffer. Called from master
@@ -302,7 +512,7 @@ ris::FramePtr rha::AxiStreamDma::acceptReq(uint32_t size, bool zeroCopyEn) {
                 } else {
                     // Attempt to get index.
                     // return of less than 0 is a failure to get a buffer
-                    res = dmaGetIndex(fd_);
+                    res = emu_ ? emu_->getIndex(fd_) : dmaGetIndex(fd_);
                 }
             } while (res < 0);
 
@@ -370,11 +580,20 @@ void rha::AxiStreamDma::acceptFrame(ris::FramePtr frame) {
             // Buffer is not already stale as indicates by bit 30
             if ((meta & 0x40000000) == 0) {
                 // Write by passing (*it)er index to driver
-                if (dmaWriteIndex(fd_,
-                                  meta & 0x3FFFFFFF,
-                                  (*it)->getPayload(),
-                                  axisSetFlags(fuser, luser, cont),
-                                  dest_) <= 0) {
+                if (emu_)
+                    res = emu_->writeIndex(fd_,
+                                           meta & 0x3FFFFFFF,
+                                           (*it)->getPayload(),
+                                           axisSetFlags(fuser, luser, cont),
+                                           dest_);
+                else
+                    res = dmaWriteIndex(fd_,
+                                        meta & 0x3FFFFFFF,
+                                        (*it)->getPayload(),
+                                        axisSetFlags(fuser, luser, cont),
+                                        dest_);
+
+                if (res <= 0) {
                     throw(rogue::GeneralError("AxiStreamDma::acceptFrame", "AXIS Write Call Failed"));
                 }
 
@@ -404,9 +623,16 @@ void rha::AxiStreamDma::acceptFrame(ris::FramePtr frame) {
                     res = 0;
                 } else {
                     // Write with (*it)er copy
-                    if ((res =
-                             dmaWrite(fd_, (*it)->begin(), (*it)->getPayload(), axisSetFlags(fuser, luser, 0), dest_)) <
-                        0) {
+                    if (emu_)
+                        res = emu_->write(fd_,
+                                          (*it)->begin(),
+                                          (*it)->getPayload(),
+                                          axisSetFlags(fuser, luser, 0),
+                                          dest_);
+                    else
+                        res = dmaWrite(fd_, (*it)->begin(), (*it)->getPayload(), axisSetFlags(fuser, luser, 0), dest_);
+
+                    if (res < 0) {
                         throw(rogue::GeneralError("AxiStreamDma::acceptFrame", "AXIS Write Call Failed!!!!"));
                     }
                 }
@@ -423,38 +649,25 @@ void rha::AxiStreamDma::acceptFrame(ris::FramePtr frame) {
 //! Return a buffer
 void rha::AxiStreamDma::retBuffer(uint8_t* data, uint32_t meta, uint32_t size) {
     rogue::GilRelease noGil;
-    uint32_t ret[100];
-    uint32_t count;
-    uint32_t x;
 
     // Buffer is zero copy as indicated by bit 31
     if ((meta & 0x80000000) != 0) {
-        // Device is open and buffer is not stale
         // Bit 30 indicates buffer has already been returned to hardware
-        if ((fd_ >= 0) && ((meta & 0x40000000) == 0)) {
-#if 0
-         // Add to queue
-         printf("Adding to queue\n");
-         retQueue_.push(meta);
-
-         // Bulk return
-         if ( (count = retQueue_.size()) >= retThold_ ) {
-            printf("Return count=%" PRIu32 "\n", count);
-            if ( count > 100 ) count = 100;
-            for (x=0; x < count; x++) ret[x] = retQueue_.pop() & 0x3FFFFFFF;
-
-            if ( dmaRetIndexes(fd_,count,ret) < 0 )
-               throw(rogue::GeneralError("AxiStreamDma::retBuffer","AXIS Return Buffer Call Failed!!!!"));
-
-            decCounter(size*count);
-            printf("Return done\n");
-         }
-
-#else
-            if (dmaRetIndex(fd_, meta & 0x3FFFFFFF) < 0)
-                throw(rogue::GeneralError("AxiStreamDma::retBuffer", "AXIS Return Buffer Call Failed!!!!"));
-
-#endif
+        if ((meta & 0x40000000) == 0) {
+            std::lock_guard<std::mutex> lock(ret_->mtx);
+
+            // Device is open
+            if (ret_->fd >= 0) {
+                if (ret_->index.empty()) ret_->first = std::chrono::steady_clock::now();
+                ret_->index.push_back(meta & 0x3FFFFFFF);
+
+                // Bulk return
+                if (ret_->index.size() >= ret_->thold) {
+                    if (retIndexes(ret_, ret_->index.size(), ret_->index.data()) < 0)
+                        throw(rogue::GeneralError("AxiStreamDma::retBuffer", "AXIS Return Buffer Call Failed!!!!"));
+                    ret_->index.clear();
+                }
+            }
         }
         decCounter(size);
     }
@@ -464,35 +677,89 @@ void rha::AxiStreamDma::retBuffer(uint8_t* data, uint32_t meta, uint32_t size) {
         Pool::retBuffer(data, meta, size);
 }
 
+//! Return buffers to the driver or emulator, batch lock must be held
+int32_t rha::AxiStreamDma::retIndexes(rha::AxiStreamDmaRetBatch* batch, uint32_t count, uint32_t* indexes) {
+    if (batch->emu) return batch->emu->retIndexes(batch->fd, count, indexes);
+    return dmaRetIndexes(batch->fd, count, indexes);
+}
+
+//! Return the buffers in a batch, all when force is set or once the latency has passed
+void rha::AxiStreamDma::retFlush(rha::AxiStreamDmaRetBatch* batch, bool force) {
+    std::chrono::microseconds age;
+    uint32_t count;
+    uint32_t x;
+
+    std::lock_guard<std::mutex> lock(batch->mtx);
+
+    if (batch->index.empty() || batch->fd < 0) return;
+
+    age = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - batch->first);
+    if (!force && age.count() < batch->latency) return;
+
+    for (x = 0; x < batch->index.size(); x += count) {
+        count = batch->index.size() - x;
+        if (count > RetBufferCount) count = RetBufferCount;
+
+        if (retIndexes(batch, count, batch->index.data() + x) < 0)
+            throw(rogue::GeneralError("AxiStreamDma::retFlush", "AXIS Return Buffer Call Failed!!!!"));
+    }
+    batch->index.clear();
+}
+
+//! Add a received buffer to the pending frame
+void rha::AxiStreamDma::rxBuffer(ris::BufferPtr buff, int32_t size, uint32_t flags, uint32_t error) {
+    uint32_t fuser;
+    uint32_t luser;
+    uint32_t cont;
+    uint8_t ferr;
+
+    fuser = axisGetFuser(flags);
+    luser = axisGetLuser(flags);
+    cont  = axisGetCont(flags);
+
+    buff->setPayload(size);
+
+    ferr = rxFrame_->getError();
+
+    // Receive error
+    ferr |= (error & 0xFF);
+
+    // First buffer of frame
+    if (rxFrame_->isEmpty()) rxFrame_->setFirstUser(fuser & 0xFF);
+
+    // Last buffer of frame
+    if (cont == 0) {
+        rxFrame_->setLastUser(luser & 0xFF);
+        if (enSsi_ && ((luser & 0x1) != 0)) ferr |= 0x80;
+    }
+
+    rxFrame_->setError(ferr);
+    rxFrame_->appendBuffer(buff);
+
+    // If continue flag is not set, push frame and get a new empty frame
+    if (cont == 0) {
+        sendFrame(rxFrame_);
+        rxFrame_ = ris::Frame::create();
+    }
+}
+
 //! Run thread
 void rha::AxiStreamDma::runThread(std::weak_ptr<int> lockPtr) {
-    ris::BufferPtr buff[RxBufferCount];
+    ris::BufferPtr buff;
     uint32_t meta[RxBufferCount];
     uint32_t rxFlags[RxBufferCount];
     uint32_t rxError[RxBufferCount];
     int32_t rxSize[RxBufferCount];
     int32_t rxCount;
     int32_t x;
-    ris::FramePtr frame;
     fd_set fds;
-    uint8_t error;
-    uint32_t fuser;
-    uint32_t luser;
-    uint32_t cont;
     struct timeval tout;
 
-    fuser = 0;
-    luser = 0;
-    cont  = 0;
-
     // Wait until constructor completes
     while (!lockPtr.expired()) continue;
 
     log_->logThreadId();
 
-    // Preallocate empty frame
-    frame = ris::Frame::create();
-
     while (threadEn_) {
         // Setup fds for select call
         FD_ZERO(&fds);
@@ -507,63 +774,148 @@ void rha::AxiStreamDma::runThread(std::weak_ptr<int> lockPtr) {
             // Zero copy buffers were not allocated
             if (desc_->rawBuff == NULL) {
                 // Allocate a buffer
-                buff[0] = allocBuffer(desc_->bSize, NULL);
+                buff = allocBuffer(desc_->bSize, NULL);
 
                 // Attempt read, dest is not needed since only one lane/vc is open
-                rxSize[0] = dmaRead(fd_, buff[0]->begin(), buff[0]->getAvailable(), rxFlags, rxError, NULL);
-                if (rxSize[0] <= 0)
-                    rxCount = rxSize[0];
+                if (emu_)
+                    rxSize[0] = emu_->read(fd_, buff->begin(), buff->getAvailable(), rxFlags, rxError, NULL);
                 else
-                    rxCount = 1;
+                    rxSize[0] = dmaRead(fd_, buff->begin(), buff->getAvailable(), rxFlags, rxError, NULL);
+
+                // Return of -1 is bad
+                if (rxSize[0] < 0) throw(rogue::GeneralError("AxiStreamDma::runThread", "DMA Interface Failure!"));
+
+                if (rxSize[0] > 0) rxBuffer(buff, rxSize[0], rxFlags[0], rxError[0]);
+                buff.reset();
             }
 
             // Zero copy read
             else {
                 // Attempt read, dest is not needed since only one lane/vc is open
-                rxCount = dmaReadBulkIndex(fd_, RxBufferCount, rxSize, meta, rxFlags, rxError, NULL);
+                if (emu_)
+                    rxCount = emu_->readBulkIndex(fd_, RxBufferCount, rxSize, meta, rxFlags, rxError, NULL);
+                else
+                    rxCount = dmaReadBulkIndex(fd_, RxBufferCount, rxSize, meta, rxFlags, rxError, NULL);
+
+                // Return of -1 is bad
+                if (rxCount < 0) throw(rogue::GeneralError("AxiStreamDma::runThread", "DMA Interface Failure!"));
 
-                // Allocate a buffer, Mark zero copy meta with bit 31 set, lower bits are index
+                // Mark zero copy meta with bit 31 set, lower bits are index
                 for (x = 0; x < rxCount; x++)
-                    buff[x] = createBuffer(desc_->rawBuff[meta[x]], 0x80000000 | meta[x], desc_->bSize, desc_->bSize);
+                    rxBuffer(createBuffer(desc_->rawBuff[meta[x]], 0x80000000 | meta[x], desc_->bSize, desc_->bSize),
+                             rxSize[x],
+                             rxFlags[x],
+                             rxError[x]);
             }
+        }
 
-            // Return of -1 is bad
-            if (rxCount < 0) throw(rogue::GeneralError("AxiStreamDma::runThread", "DMA Interface Failure!"));
+        // Return buffers held past the latency limit
+        retFlush(ret_, false);
+    }
+}
+
+//! Run shared receive thread, buffers are routed to the instance owning the destination
+void rha::AxiStreamDma::runShared(rha::AxiStreamDmaShared* desc) {
+    std::map<uint32_t, rha::AxiStreamDma*>::iterator it;
+    ris::BufferPtr buff;
+    std::vector<SharedRx> rx;
+    uint32_t meta[RxBufferCount];
+    uint32_t rxFlags[RxBufferCount];
+    uint32_t rxError[RxBufferCount];
+    uint32_t rxDest[RxBufferCount];
+    int32_t rxSize[RxBufferCount];
+    int32_t rxCount;
+    int32_t x;
+    rha::AxiStreamDma* inst;
+    fd_set fds;
+    struct timeval tout;
 
-            // Read was successful
-            for (x = 0; x < rxCount; x++) {
-                fuser = axisGetFuser(rxFlags[x]);
-                luser = axisGetLuser(rxFlags[x]);
-                cont  = axisGetCont(rxFlags[x]);
+    rx.reserve(RxBufferCount);
 
-                buff[x]->setPayload(rxSize[x]);
+    while (true) {
+        // Exit once disabled, a sharedOpen() before this point keeps the thread running
+        {
+            std::lock_guard<std::mutex> lock(desc->rxMtx);
 
-                error = frame->getError();
+            if (!desc->rxThreadEn) {
+                if (!desc->rxSelfClose) return;
 
-                // Receive error
-                error |= (rxError[x] & 0xFF);
+                // The thread released the last instance, nobody joins it
+                desc->rxThread->detach();
+                delete desc->rxThread;
+                desc->rxThread    = NULL;
+                desc->rxSelfClose = false;
+                break;
+            }
+        }
 
-                // First buffer of frame
-                if (frame->isEmpty()) frame->setFirstUser(fuser & 0xFF);
+        // Setup fds for select call
+        FD_ZERO(&fds);
+        FD_SET(desc->fd, &fds);
 
-                // Last buffer of frame
-                if (cont == 0) {
-                    frame->setLastUser(luser & 0xFF);
-                    if (enSsi_ && ((luser & 0x1) != 0)) error |= 0x80;
-                }
+        // Setup select timeout
+        tout.tv_sec  = 0;
+        tout.tv_usec = 1000;
 
-                frame->setError(error);
-                frame->appendBuffer(buff[x]);
-                buff[x].reset();
+        // Select returns with available buffer
+        if (select(desc->fd + 1, &fds, NULL, NULL, &tout) > 0) {
+            if (desc->emu)
+                rxCount = desc->emu->readBulkIndex(desc->fd, RxBufferCount, rxSize, meta, rxFlags, rxError, rxDest);
+            else
+                rxCount = dmaReadBulkIndex(desc->fd, RxBufferCount, rxSize, meta, rxFlags, rxError, rxDest);
 
-                // If continue flag is not set, push frame and get a new empty frame
-                if (cont == 0) {
-                    sendFrame(frame);
-                    frame = ris::Frame::create();
+            // Return of -1 is bad
+            if (rxCount < 0) throw(rogue::GeneralError("AxiStreamDma::runShared", "DMA Interface Failure!"));
+
+            // Buffers are created under the lock and passed on once it is released, so the
+            // downstream chain is free to close a destination. Each buffer holds its instance.
+            {
+                std::lock_guard<std::mutex> lock(desc->rxMtx);
+
+                for (x = 0; x < rxCount; x++) {
+                    buff.reset();
+
+                    if ((it = desc->rxDest.find(rxDest[x])) != desc->rxDest.end()) {
+                        inst = it->second;
+
+                        // Mark zero copy meta with bit 31 set, lower bits are index
+                        try {
+                            buff = inst->createBuffer(desc->rawBuff[meta[x]],
+                                                      0x80000000 | meta[x],
+                                                      desc->bSize,
+                                                      desc->bSize);
+                        } catch (std::bad_weak_ptr&) {
+                            // Instance is being destroyed
+                        }
+                    }
+
+                    // Destination was closed after the buffer was received
+                    if (!buff) {
+                        if (desc->emu)
+                            desc->emu->retIndexes(desc->fd, 1, &(meta[x]));
+                        else
+                            dmaRetIndex(desc->fd, meta[x]);
+                        continue;
+                    }
+
+                    rx.push_back(SharedRx(inst, buff, rxSize[x], rxFlags[x], rxError[x]));
                 }
+                buff.reset();
             }
+
+            // Buffers of a stopped instance are returned as they are released
+            for (x = 0; x < (int32_t)rx.size(); x++)
+                if (rx[x].inst->threadEn_) rx[x].inst->rxBuffer(rx[x].buff, rx[x].size, rx[x].flags, rx[x].error);
+            rx.clear();
         }
+
+        // Return buffers held past the latency limit
+        retFlush(&(desc->ret), false);
     }
+
+    // Close unless a new instance opened the device after the thread was released
+    std::lock_guard<std::mutex> lock(desc->openMtx);
+    if (desc->openCount == 0 && desc->fd != -1) releaseShared(desc);
 }
 
 void rha::AxiStreamDma::setup_python() {
@@ -575,7 +927,10 @@ void rha::AxiStreamDma::setup_python() {
         .def("setDriverDebug", &rha::AxiStreamDma::setDriverDebug)
         .def("dmaAck", &rha::AxiStreamDma::dmaAck)
         .def("setTimeout", &rha::AxiStreamDma::setTimeout)
-        .def("zeroCopyDisable", &rha::AxiStreamDma::zeroCopyDisable);
+        .def("zeroCopyDisable", &rha::AxiStreamDma::zeroCopyDisable)
+        .def("sharedRxEnable", &rha::AxiStreamDma::sharedRxEnable)
+        .def("setRetThold", &rha::AxiStreamDma::setRetThold)
+        .def("setRetLatency", &rha::AxiStreamDma::setRetLatency);
 
     bp::implicitly_convertible<rha::AxiStreamDmaPtr, ris::MasterPtr>();
     bp::implicitly_convertible<rha::AxiStreamDmaPtr, ris::SlavePtr>();
@@ -0,0 +1,394 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : DMA Driver Emulator
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/hardware/axi/DmaEmulator.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "rogue/GeneralError.h"
+#include "rogue/hardware/drivers/DmaDriver.h"
+
+namespace rha = rogue::hardware::axi;
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+std::mutex rha::DmaEmulator::regMtx_;
+std::map<std::string, rha::DmaEmulator*> rha::DmaEmulator::registry_;
+
+const uint32_t rha::DmaEmulator::DestCount;
+const uint32_t rha::DmaEmulator::WaitTime;
+
+//! Class creation
+rha::DmaEmulatorPtr rha::DmaEmulator::create(std::string path, uint32_t rxCount, uint32_t txCount, uint32_t bSize) {
+    rha::DmaEmulatorPtr r = std::make_shared<rha::DmaEmulator>(path, rxCount, txCount, bSize);
+    return (r);
+}
+
+//! Return the emulator for a path
+rha::DmaEmulatorPtr rha::DmaEmulator::find(std::string path) {
+    std::map<std::string, rha::DmaEmulator*>::iterator it;
+
+    std::lock_guard<std::mutex> lock(regMtx_);
+
+    if ((it = registry_.find(path)) == registry_.end()) return rha::DmaEmulatorPtr();
+
+    // Emulator may be in the process of being destroyed
+    try {
+        return it->second->shared_from_this();
+    } catch (std::bad_weak_ptr& e) {
+        return rha::DmaEmulatorPtr();
+    }
+}
+
+//! Create the emulator
+rha::DmaEmulator::DmaEmulator(std::string path, uint32_t rxCount, uint32_t txCount, uint32_t bSize) {
+    uint32_t x;
+
+    if (rxCount == 0 || txCount == 0 || bSize == 0)
+        throw(rogue::GeneralError("DmaEmulator::DmaEmulator", "Buffer count and size must be non-zero"));
+
+    path_        = path;
+    rxCount_     = rxCount;
+    txCount_     = txCount;
+    bSize_       = bSize;
+    txBuffers_   = 0;
+    rxBuffers_   = 0;
+    dropBuffers_ = 0;
+
+    // Buffers are contiguous, each is aligned to 64 bytes
+    bSize = (bSize_ + 63) & ~63;
+    if (posix_memalign(reinterpret_cast<void**>(&mem_), 64, (uint64_t)bSize * (rxCount_ + txCount_)) != 0)
+        throw(rogue::GeneralError::create("DmaEmulator::DmaEmulator",
+                                          "Failed to allocate %" PRIu32 " buffers of %" PRIu32 " bytes",
+                                          rxCount_ + txCount_,
+                                          bSize_));
+
+    // Receive buffers first, then transmit buffers, popped from the back in index order
+    for (x = 0; x < (rxCount_ + txCount_); x++) map_.push_back(mem_ + (uint64_t)bSize * x);
+    for (x = rxCount_; x > 0; x--) rxFree_.push_back(x - 1);
+    for (x = rxCount_ + txCount_; x > rxCount_; x--) txFree_.push_back(x - 1);
+
+    size_.resize(rxCount_ + txCount_, 0);
+    flags_.resize(rxCount_ + txCount_, 0);
+    dest_.resize(rxCount_ + txCount_, 0);
+    destFd_.resize(DestCount, -1);
+
+    std::lock_guard<std::mutex> lock(regMtx_);
+
+    if (registry_.count(path_) != 0) {
+        free(mem_);
+        throw(rogue::GeneralError::create("DmaEmulator::DmaEmulator",
+                                          "An emulator already exists for %s",
+                                          path_.c_str()));
+    }
+    registry_[path_] = this;
+}
+
+//! Destroy the emulator
+rha::DmaEmulator::~DmaEmulator() {
+    std::map<int32_t, std::shared_ptr<Handle> >::iterator it;
+
+    {
+        std::lock_guard<std::mutex> lock(regMtx_);
+        registry_.erase(path_);
+    }
+
+    for (it = handles_.begin(); it != handles_.end(); ++it) ::close(it->first);
+    free(mem_);
+}
+
+//! Lookup a file descriptor
+std::shared_ptr<rha::DmaEmulator::Handle> rha::DmaEmulator::findHandle(int32_t fd) {
+    std::map<int32_t, std::shared_ptr<Handle> >::iterator it;
+
+    if ((it = handles_.find(fd)) == handles_.end()) return std::shared_ptr<Handle>();
+    return it->second;
+}
+
+//! Pass a written buffer to the receiver of the destination
+void rha::DmaEmulator::deliver(uint32_t index, uint32_t size, uint32_t flags, uint32_t dest) {
+    std::shared_ptr<Handle> handle;
+    uint64_t event;
+
+    txBuffers_++;
+
+    if (dest >= DestCount || !(handle = findHandle(destFd_[dest]))) {
+        dropBuffers_++;
+        freeIndex(index);
+        return;
+    }
+
+    size_[index]  = size;
+    flags_[index] = flags;
+    dest_[index]  = dest;
+    handle->queue.push_back(index);
+
+    // Receive queue becomes readable
+    event = 1;
+    if (handle->queue.size() == 1 && ::write(destFd_[dest], &event, sizeof(event)) != sizeof(event))
+        throw(rogue::GeneralError("DmaEmulator::deliver", "Failed to signal receive event"));
+}
+
+//! Return a buffer to its free list
+void rha::DmaEmulator::freeIndex(uint32_t index) {
+    if (index < rxCount_)
+        rxFree_.push_back(index);
+    else
+        txFree_.push_back(index);
+    cond_.notify_all();
+}
+
+//! Wait for a free buffer in the passed list
+bool rha::DmaEmulator::waitFree(std::unique_lock<std::mutex>& lock, std::vector<uint32_t>& list) {
+    if (list.empty()) cond_.wait_for(lock, std::chrono::microseconds(WaitTime));
+    return !list.empty();
+}
+
+//! Open a file descriptor
+int32_t rha::DmaEmulator::open() {
+    std::shared_ptr<Handle> handle = std::make_shared<Handle>();
+    int32_t fd;
+
+    if ((fd = eventfd(0, EFD_NONBLOCK)) < 0) return -1;
+
+    handle->mask.resize(DMA_MASK_SIZE, 0);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    handles_[fd] = handle;
+    return fd;
+}
+
+//! Close a file descriptor
+void rha::DmaEmulator::close(int32_t fd) {
+    std::shared_ptr<Handle> handle;
+    uint32_t x;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        if (!(handle = findHandle(fd))) return;
+
+        for (x = 0; x < DestCount; x++)
+            if (destFd_[x] == fd) destFd_[x] = -1;
+
+        while (!handle->queue.empty()) {
+            freeIndex(handle->queue.front());
+            handle->queue.pop_front();
+        }
+        handles_.erase(fd);
+    }
+    ::close(fd);
+}
+
+//! Return the buffer pointers
+void** rha::DmaEmulator::mapDma(uint32_t* count, uint32_t* size) {
+    *count = rxCount_ + txCount_;
+    *size  = bSize_;
+    return map_.data();
+}
+
+//! Return the buffer size in bytes
+uint32_t rha::DmaEmulator::getBuffSize() {
+    return bSize_;
+}
+
+//! Return the number of receive buffers
+uint32_t rha::DmaEmulator::getRxBuffCount() {
+    return rxCount_;
+}
+
+//! Return the number of transmit buffers
+uint32_t rha::DmaEmulator::getTxBuffCount() {
+    return txCount_;
+}
+
+//! Set the destinations received by a file descriptor
+int32_t rha::DmaEmulator::setMaskBytes(int32_t fd, const uint8_t* mask) {
+    std::shared_ptr<Handle> handle;
+    uint32_t x;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (!(handle = findHandle(fd))) return -1;
+
+    // Destination is owned by another file descriptor
+    for (x = 0; x < DestCount; x++)
+        if ((mask[x / 8] & (1 << (x % 8))) != 0 && destFd_[x] != -1 && destFd_[x] != fd) return -1;
+
+    for (x = 0; x < DestCount; x++) {
+        if ((mask[x / 8] & (1 << (x % 8))) != 0)
+            destFd_[x] = fd;
+        else if (destFd_[x] == fd)
+            destFd_[x] = -1;
+    }
+    handle->mask.assign(mask, mask + DMA_MASK_SIZE);
+    return 0;
+}
+
+//! Get a free transmit buffer index
+int32_t rha::DmaEmulator::getIndex(int32_t) {
+    uint32_t index;
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    if (!waitFree(lock, txFree_)) return -1;
+
+    index = txFree_.back();
+    txFree_.pop_back();
+    return index;
+}
+
+//! Write a buffer by index
+int32_t rha::DmaEmulator::writeIndex(int32_t, uint32_t index, uint32_t size, uint32_t flags, uint32_t dest) {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (index >= (rxCount_ + txCount_) || size > bSize_) return -1;
+
+    deliver(index, size, flags, dest);
+    return size;
+}
+
+//! Write a buffer from user memory
+int32_t rha::DmaEmulator::write(int32_t, const void* buf, uint32_t size, uint32_t flags, uint32_t dest) {
+    uint32_t index;
+
+    if (size > bSize_) return -1;
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    if (!waitFree(lock, rxFree_)) return 0;
+
+    index = rxFree_.back();
+    rxFree_.pop_back();
+
+    memcpy(map_[index], buf, size);
+    deliver(index, size, flags, dest);
+    return size;
+}
+
+//! Read buffers by index
+int32_t rha::DmaEmulator::readBulkIndex(int32_t fd,
+                                        uint32_t count,
+                                        int32_t* ret,
+                                        uint32_t* index,
+                                        uint32_t* flags,
+                                        uint32_t* error,
+                                        uint32_t* dest) {
+    std::shared_ptr<Handle> handle;
+    uint64_t event;
+    uint32_t x;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (!(handle = findHandle(fd))) return -1;
+
+    for (x = 0; x < count && !handle->queue.empty(); x++) {
+        index[x] = handle->queue.front();
+        handle->queue.pop_front();
+
+        ret[x] = size_[index[x]];
+        if (flags != NULL) flags[x] = flags_[index[x]];
+        if (error != NULL) error[x] = 0;
+        if (dest != NULL) dest[x] = dest_[index[x]];
+    }
+    rxBuffers_ += x;
+
+    // Clear readable state
+    if (handle->queue.empty() && ::read(fd, &event, sizeof(event)) < 0) event = 0;
+
+    return x;
+}
+
+//! Read a buffer into user memory
+int32_t rha::DmaEmulator::read(int32_t fd,
+                               void* buf,
+                               uint32_t maxSize,
+                               uint32_t* flags,
+                               uint32_t* error,
+                               uint32_t* dest) {
+    uint32_t index;
+    int32_t ret;
+    uint32_t rxErr;
+
+    if (readBulkIndex(fd, 1, &ret, &index, flags, &rxErr, dest) != 1) return 0;
+
+    // Truncate buffers larger than the user memory
+    if ((uint32_t)ret > maxSize) {
+        rxErr |= DMA_ERR_MAX;
+        ret = maxSize;
+    }
+    if (error != NULL) *error = rxErr;
+
+    memcpy(buf, map_[index], ret);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    freeIndex(index);
+    return ret;
+}
+
+//! Return buffers by index
+int32_t rha::DmaEmulator::retIndexes(int32_t, uint32_t count, const uint32_t* indexes) {
+    uint32_t x;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    for (x = 0; x < count; x++) {
+        if (indexes[x] >= (rxCount_ + txCount_)) return -1;
+        freeIndex(indexes[x]);
+    }
+    return 0;
+}
+
+//! Get number of buffers written
+uint64_t rha::DmaEmulator::getTxCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return txBuffers_;
+}
+
+//! Get number of buffers read
+uint64_t rha::DmaEmulator::getRxCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return rxBuffers_;
+}
+
+//! Get number of buffers dropped without a receiver
+uint64_t rha::DmaEmulator::getDropCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return dropBuffers_;
+}
+
+void rha::DmaEmulator::setup_python() {
+#ifndef NO_PYTHON
+
+    bp::class_<rha::DmaEmulator, rha::DmaEmulatorPtr, boost::noncopyable>(
+        "DmaEmulator",
+        bp::init<std::string, uint32_t, uint32_t, uint32_t>())
+        .def("getTxCount", &rha::DmaEmulator::getTxCount)
+        .def("getRxCount", &rha::DmaEmulator::getRxCount)
+        .def("getDropCount", &rha::DmaEmulator::getDropCount);
+#endif
+}
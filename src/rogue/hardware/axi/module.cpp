@@ -26,6 +26,7 @@
 
 #include "rogue/hardware/axi/AxiMemMap.h"
 #include "rogue/hardware/axi/AxiStreamDma.h"
+#include "rogue/hardware/axi/DmaEmulator.h"
 
 namespace bp  = boost::python;
 namespace rha = rogue::hardware::axi;
@@ -42,5 +43,6 @@ void rha::setup_module() {
     bp::scope io_scope = module;
 
     rha::AxiStreamDma::setup_python();
+    rha::DmaEmulator::setup_python();
     rha::AxiMemMap::setup_python();
 }
@@ -27,6 +27,7 @@
 #include <boost/python.hpp>
 
 #include "rogue/hardware/MemMap.h"
+#include "rogue/hardware/MemWorkerPool.h"
 #include "rogue/hardware/axi/module.h"
 
 namespace bp = boost::python;
@@ -42,5 +43,6 @@ void rogue::hardware::setup_module() {
     bp::scope io_scope = module;
 
     rogue::hardware::axi::setup_module();
+    rogue::hardware::MemWorkerPool::setup_python();
     rogue::hardware::MemMap::setup_python();
 }
@@ -161,103 +161,119 @@ bool rim::Block::blockPyTrans() {
     return blockPyTrans_;
 }
 
-// Start a transaction for this block
-void rim::Block::intStartTransaction(uint32_t type, bool forceWr, bool check, rim::Variable* var, int32_t index) {
-    uint32_t x;
-    uint32_t tOff;
-    uint32_t tSize;
-    uint8_t* tData;
+// Check if the transaction type is valid for the current block state
+bool rim::Block::validTransaction(uint32_t type, bool forceWr) {
+    return !((type == rim::Write and ((mode_ == "RO") || (!stale_ && !forceWr))) ||
+             (type == rim::Post and (mode_ == "RO")) || (type == rim::Read and ((mode_ == "WO") || stale_)) ||
+             (type == rim::Verify and ((mode_ == "WO") || (mode_ == "RO") || stale_ || !verifyReq_)));
+}
+
+// Setup the transaction range for this block, called with the lock held
+bool rim::Block::setupTransaction(uint32_t type,
+                                  rim::Variable* var,
+                                  int32_t index,
+                                  uint32_t& tOff,
+                                  uint32_t& tSize,
+                                  uint8_t*& tData) {
     uint32_t highByte;
     uint32_t lowByte;
     uint32_t minAccess = getSlave()->doMinAccess();
 
     std::vector<rim::VariablePtr>::iterator vit;
 
-    // Check for valid combinations
-    if ((type == rim::Write and ((mode_ == "RO") || (!stale_ && !forceWr))) ||
-        (type == rim::Post and (mode_ == "RO")) || (type == rim::Read and ((mode_ == "WO") || stale_)) ||
-        (type == rim::Verify and ((mode_ == "WO") || (mode_ == "RO") || stale_ || !verifyReq_)))
-        return;
-
-    {
-        rogue::GilRelease noGil;
-        std::lock_guard<std::mutex> lock(mtx_);
-        waitTransaction(0);
-        clearError();
-
-        // Determine transaction range
-        if (var == NULL) {
-            lowByte  = 0;
-            highByte = size_ - 1;
-            if (type == rim::Write || type == rim::Post) {
-                stale_ = false;
-                for (vit = variables_.begin(); vit != variables_.end(); ++vit) { (*vit)->stale_ = false; }
+    // Determine transaction range
+    if (var == NULL) {
+        lowByte  = 0;
+        highByte = size_ - 1;
+        if (type == rim::Write || type == rim::Post) {
+            stale_ = false;
+            for (vit = variables_.begin(); vit != variables_.end(); ++vit) { (*vit)->stale_ = false; }
+        }
+    } else {
+        if (type == rim::Read || type == rim::Verify) {
+            if (index < 0 || index >= var->numValues_) {
+                lowByte  = var->lowTranByte_;
+                highByte = var->highTranByte_;
+            } else {
+                lowByte  = var->listLowTranByte_[index];
+                highByte = var->listHighTranByte_[index];
             }
         } else {
-            if (type == rim::Read || type == rim::Verify) {
-                if (index < 0 || index >= var->numValues_) {
-                    lowByte  = var->lowTranByte_;
-                    highByte = var->highTranByte_;
-                } else {
-                    lowByte  = var->listLowTranByte_[index];
-                    highByte = var->listHighTranByte_[index];
-                }
-            } else {
-                lowByte  = var->staleLowByte_;
-                highByte = var->staleHighByte_;
-
-                // Catch case where fewer stale bytes than min access or non-aligned
-                if (lowByte % minAccess != 0) lowByte -= lowByte % minAccess;
-                if ((highByte + 1) % minAccess != 0) highByte += minAccess - ((highByte + 1) % minAccess);
-                stale_ = false;
-                for (vit = variables_.begin(); vit != variables_.end(); ++vit) {
-                    if ((*vit)->stale_) {
-                        if ((*vit)->staleLowByte_ < lowByte) lowByte = (*vit)->staleLowByte_;
-                        if ((*vit)->staleHighByte_ > highByte) highByte = (*vit)->staleHighByte_;
-                        (*vit)->stale_ = false;
-                    }
+            lowByte  = var->staleLowByte_;
+            highByte = var->staleHighByte_;
+
+            // Catch case where fewer stale bytes than min access or non-aligned
+            if (lowByte % minAccess != 0) lowByte -= lowByte % minAccess;
+            if ((highByte + 1) % minAccess != 0) highByte += minAccess - ((highByte + 1) % minAccess);
+            stale_ = false;
+            for (vit = variables_.begin(); vit != variables_.end(); ++vit) {
+                if ((*vit)->stale_) {
+                    if ((*vit)->staleLowByte_ < lowByte) lowByte = (*vit)->staleLowByte_;
+                    if ((*vit)->staleHighByte_ > highByte) highByte = (*vit)->staleHighByte_;
+                    (*vit)->stale_ = false;
                 }
             }
         }
+    }
 
-        // Device is disabled, check after clearing stale states
-        if (!enable_) return;
+    // Device is disabled, check after clearing stale states
+    if (!enable_) return false;
 
-        // Setup verify data, clear verify write flag if verify transaction
-        if (type == rim::Verify) {
-            tOff       = verifyBase_;
-            tSize      = verifySize_;
-            tData      = verifyData_ + verifyBase_;
-            verifyInp_ = true;
-        }
+    // Setup verify data, clear verify write flag if verify transaction
+    if (type == rim::Verify) {
+        tOff       = verifyBase_;
+        tSize      = verifySize_;
+        tData      = verifyData_ + verifyBase_;
+        verifyInp_ = true;
+    }
 
-        // Not a verify transaction
-        else {
-            // Derive offset and size based upon min transaction size
-            tOff  = lowByte;
-            tSize = (highByte - lowByte) + 1;
-
-            // Set transaction pointer
-            tData = blockData_ + tOff;
-
-            // Track verify after writes.
-            // Only verify blocks that have been written since last verify
-            if (type == rim::Write) {
-                verifyBase_ = tOff;
-                verifySize_ = tSize;
-                verifyReq_  = verifyEn_;
-            }
+    // Not a verify transaction
+    else {
+        // Derive offset and size based upon min transaction size
+        tOff  = lowByte;
+        tSize = (highByte - lowByte) + 1;
+
+        // Set transaction pointer
+        tData = blockData_ + tOff;
+
+        // Track verify after writes.
+        // Only verify blocks that have been written since last verify
+        if (type == rim::Write) {
+            verifyBase_ = tOff;
+            verifySize_ = tSize;
+            verifyReq_  = verifyEn_;
         }
-        doUpdate_ = updateEn_;
+    }
+    doUpdate_ = updateEn_;
+
+    bLog_->debug("Start transaction type = %" PRIu32 ", Offset=0x%" PRIx64 ", lByte=%" PRIu32 ", hByte=%" PRIu32
+                 ", tOff=0x%" PRIx32 ", tSize=%" PRIu32,
+                 type,
+                 offset_,
+                 lowByte,
+                 highByte,
+                 tOff,
+                 tSize);
+
+    return true;
+}
 
-        bLog_->debug("Start transaction type = %" PRIu32 ", Offset=0x%" PRIx64 ", lByte=%" PRIu32 ", hByte=%" PRIu32
-                     ", tOff=0x%" PRIx32 ", tSize=%" PRIu32,
-                     type,
-                     offset_,
-                     lowByte,
-                     highByte,
-                     tOff,
-                     tSize);
+// Start a transaction for this block
+void rim::Block::intStartTransaction(uint32_t type, bool forceWr, bool check, rim::Variable* var, int32_t index) {
+    uint32_t tOff;
+    uint32_t tSize;
+    uint8_t* tData;
+
+    // Check for valid combinations
+    if (!validTransaction(type, forceWr)) return;
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+        waitTransaction(0);
+        clearError();
+
+        if (!setupTransaction(type, var, index, tOff, tSize, tData)) return;
 
         // Start transaction
         reqTransaction(offset_ + tOff, tSize, tData, type);
@@ -633,6 +649,9 @@ void rim::Block::setBytes(const uint8_t* data, rim::Variable* var, uint32_t inde
         if (var->fastByte_ != NULL)
             memcpy(blockData_ + var->fastByte_[0], buff, var->valueBytes_);
 
+        else if (var->bitPlanEn_)
+            depositBits(blockData_ + var->bitPlanByte_, var->bitPlanBytes_, var->bitPlanMask_, buff, var->valueBytes_);
+
         else if (var->bitOffset_.size() == 1)
             copyBits(blockData_, var->bitOffset_[0], buff, 0, var->bitSize_[0]);
 
@@ -678,6 +697,9 @@ void rim::Block::getBytes(uint8_t* data, rim::Variable* var, uint32_t index) {
         if (var->fastByte_ != NULL)
             memcpy(data, blockData_ + var->fastByte_[0], var->valueBytes_);
 
+        else if (var->bitPlanEn_)
+            extractBits(data, var->valueBytes_, blockData_ + var->bitPlanByte_, var->bitPlanBytes_, var->bitPlanMask_);
+
         else if (var->bitOffset_.size() == 1)
             copyBits(data, 0, blockData_, var->bitOffset_[0], var->bitSize_[0]);
 
@@ -694,6 +716,518 @@ void rim::Block::getBytes(uint8_t* data, rim::Variable* var, uint32_t index) {
     if (var->byteReverse_) { reverseBytes(data, var->valueBytes_); }
 }
 
+//////////////////////////////////////////
+// Bulk list helpers
+//////////////////////////////////////////
+
+namespace {
+
+// Byte swap a value of a given width
+inline uint8_t swapValue(uint8_t value) {
+    return value;
+}
+
+inline uint16_t swapValue(uint16_t value) {
+    return __builtin_bswap16(value);
+}
+
+inline uint32_t swapValue(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+inline uint64_t swapValue(uint64_t value) {
+    return __builtin_bswap64(value);
+}
+
+// Load byte aligned values of type W which are step bytes apart
+// The dense loops are kept separate so that the compiler can vectorize them
+template <typename W, typename T, typename F>
+void loadValues(T* dst, const uint8_t* src, uint32_t step, uint32_t count, bool swap, F conv) {
+    uint32_t x;
+    W value;
+
+    if (step == sizeof(W) && !swap) {
+        for (x = 0; x < count; x++) {
+            memcpy(&value, src + x * sizeof(W), sizeof(W));
+            dst[x] = conv((uint64_t)value);
+        }
+    } else if (step == sizeof(W)) {
+        for (x = 0; x < count; x++) {
+            memcpy(&value, src + x * sizeof(W), sizeof(W));
+            dst[x] = conv((uint64_t)swapValue(value));
+        }
+    } else {
+        for (x = 0; x < count; x++) {
+            memcpy(&value, src + x * step, sizeof(W));
+            dst[x] = conv((uint64_t)(swap ? swapValue(value) : value));
+        }
+    }
+}
+
+// Store byte aligned values of type W which are step bytes apart
+template <typename W, typename T, typename F>
+void storeValues(uint8_t* dst, const T* src, uint32_t step, uint32_t count, bool swap, F conv) {
+    uint32_t x;
+    W value;
+
+    if (step == sizeof(W) && !swap) {
+        for (x = 0; x < count; x++) {
+            value = (W)conv(src[x]);
+            memcpy(dst + x * sizeof(W), &value, sizeof(W));
+        }
+    } else if (step == sizeof(W)) {
+        for (x = 0; x < count; x++) {
+            value = swapValue((W)conv(src[x]));
+            memcpy(dst + x * sizeof(W), &value, sizeof(W));
+        }
+    } else {
+        for (x = 0; x < count; x++) {
+            value = (W)conv(src[x]);
+            if (swap) value = swapValue(value);
+            memcpy(dst + x * step, &value, sizeof(W));
+        }
+    }
+}
+
+// Sign extend a raw value with the passed number of bits
+inline int64_t signExtend(uint64_t value, uint32_t bits) {
+    return (bits >= 64) ? (int64_t)value : ((int64_t)(value << (64 - bits))) >> (64 - bits);
+}
+
+// Raw value conversions for each model
+struct UIntConv {
+    uint64_t operator()(uint64_t raw) const {
+        return raw;
+    }
+};
+
+struct UInt32Conv {
+    uint32_t operator()(uint64_t raw) const {
+        return (uint32_t)raw;
+    }
+};
+
+struct IntConv {
+    uint32_t bits;
+    explicit IntConv(uint32_t valueBits) : bits(valueBits) {}
+    int64_t operator()(uint64_t raw) const {
+        return signExtend(raw, bits);
+    }
+    uint64_t operator()(int64_t value) const {
+        return (uint64_t)value;
+    }
+    uint64_t operator()(int32_t value) const {
+        return (uint64_t)(int64_t)value;
+    }
+};
+
+struct BoolConv {
+    bool operator()(uint64_t raw) const {
+        return raw != 0;
+    }
+    uint64_t operator()(bool value) const {
+        return value ? 1 : 0;
+    }
+};
+
+struct FloatConv {
+    float operator()(uint64_t raw) const {
+        uint32_t tmp = (uint32_t)raw;
+        float ret;
+        memcpy(&ret, &tmp, sizeof(ret));
+        return ret;
+    }
+    uint64_t operator()(float value) const {
+        uint32_t tmp;
+        memcpy(&tmp, &value, sizeof(tmp));
+        return tmp;
+    }
+};
+
+struct DoubleConv {
+    double operator()(uint64_t raw) const {
+        double ret;
+        memcpy(&ret, &raw, sizeof(ret));
+        return ret;
+    }
+    uint64_t operator()(double value) const {
+        uint64_t tmp;
+        memcpy(&tmp, &value, sizeof(tmp));
+        return tmp;
+    }
+};
+
+struct FixedConv {
+    uint32_t bits;
+    double toFixed;
+    double fromFixed;
+    explicit FixedConv(uint32_t valueBits, uint32_t binPoint)
+        : bits(valueBits), toFixed(pow(2, binPoint)), fromFixed(1.0 / pow(2, binPoint)) {}
+    double operator()(uint64_t raw) const {
+        return (double)signExtend(raw, bits) * fromFixed;
+    }
+    uint64_t operator()(double value) const {
+        int64_t fPoint = (int64_t)round(value * toFixed);
+
+        // Check for positive edge case
+        if (value > 0 && ((fPoint >> (bits - 1)) & 0x1) != 0) fPoint -= 1;
+        return (uint64_t)fPoint;
+    }
+};
+
+}  // namespace
+
+// Verify a list range for bulk access
+void rim::Block::checkList(const char* func, rim::Variable* var, uint32_t index, uint32_t count) {
+    if (var->numValues_ == 0)
+        throw(rogue::GeneralError::create(func, "Variable %s is not a list variable", var->name_.c_str()));
+
+    if (((uint64_t)index + count) > var->numValues_)
+        throw(rogue::GeneralError::create(func,
+                                          "Overflow error for passed array with length %" PRIu32
+                                          " at index %" PRIu32 ". Variable length = %" PRIu32 " for %s",
+                                          count,
+                                          index,
+                                          var->numValues_,
+                                          var->name_.c_str()));
+
+    if (var->valueBits_ > 64)
+        throw(rogue::GeneralError::create(func,
+                                          "Bulk access is not supported for %" PRIu32 " bit values of %s",
+                                          var->valueBits_,
+                                          var->name_.c_str()));
+}
+
+// Verify the range of values passed for bulk access
+template <typename T>
+void rim::Block::checkListValues(const char* func, rim::Variable* var, const T* src, uint32_t count) {
+    uint32_t x;
+
+    if (var->minValue_ == 0 && var->maxValue_ == 0) return;
+
+    for (x = 0; x < count; x++) {
+        if (src[x] > var->maxValue_ || src[x] < var->minValue_)
+            throw(rogue::GeneralError::create(func,
+                                              "Value range error for %s. Value=%f, Min=%f, Max=%f",
+                                              var->name_.c_str(),
+                                              (double)src[x],
+                                              var->minValue_,
+                                              var->maxValue_));
+    }
+}
+
+// Decode count list values starting at index with a single lock
+template <typename T, typename F>
+void rim::Block::getListValues(T* dst, rim::Variable* var, uint32_t index, uint32_t count, F conv) {
+    uint64_t mask;
+    uint64_t raw;
+    uint32_t bit;
+    uint32_t revShift;
+    uint32_t x;
+
+    if (count == 0) return;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    bit      = var->bitOffset_[0] + index * var->valueStride_;
+    revShift = 64 - var->valueBytes_ * 8;
+
+    // Byte aligned values of a native width
+    if ((bit % 8) == 0 && (var->valueStride_ % 8) == 0 && var->valueBits_ == var->valueBytes_ * 8) {
+        uint8_t* src  = blockData_ + bit / 8;
+        uint32_t step = var->valueStride_ / 8;
+
+        switch (var->valueBytes_) {
+            case 1:
+                loadValues<uint8_t>(dst, src, step, count, false, conv);
+                return;
+            case 2:
+                loadValues<uint16_t>(dst, src, step, count, var->byteReverse_, conv);
+                return;
+            case 4:
+                loadValues<uint32_t>(dst, src, step, count, var->byteReverse_, conv);
+                return;
+            case 8:
+                loadValues<uint64_t>(dst, src, step, count, var->byteReverse_, conv);
+                return;
+        }
+    }
+
+    // Shift and mask a 64-bit window for each value which is not byte aligned
+    mask = (var->valueBits_ >= 64) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << var->valueBits_) - 1);
+
+    for (x = 0; x < count; x++) {
+        if (var->valueBits_ <= 56 && (bit / 8 + 8) <= size_) {
+            memcpy(&raw, blockData_ + bit / 8, 8);
+            raw = (raw >> (bit % 8)) & mask;
+        } else {
+            raw = 0;
+            copyBits((uint8_t*)&raw, 0, blockData_, bit, var->valueBits_);
+        }
+
+        if (var->byteReverse_) raw = swapValue(raw) >> revShift;
+        dst[x] = conv(raw);
+        bit += var->valueStride_;
+    }
+}
+
+// Encode count list values starting at index with a single lock
+template <typename T, typename F>
+void rim::Block::setListValues(const T* src, rim::Variable* var, uint32_t index, uint32_t count, F conv) {
+    uint64_t mask;
+    uint64_t raw;
+    uint64_t word;
+    uint32_t bit;
+    uint32_t revShift;
+    uint32_t x;
+
+    if (count == 0) return;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // Set stale flag
+    stale_ = true;
+
+    // List values are in ascending order, one range covers all of them
+    if (var->stale_) {
+        if (var->listLowTranByte_[index] < var->staleLowByte_) var->staleLowByte_ = var->listLowTranByte_[index];
+
+        if (var->listHighTranByte_[index + count - 1] > var->staleHighByte_)
+            var->staleHighByte_ = var->listHighTranByte_[index + count - 1];
+    } else {
+        var->staleLowByte_  = var->listLowTranByte_[index];
+        var->staleHighByte_ = var->listHighTranByte_[index + count - 1];
+    }
+    var->stale_ = true;
+
+    bit      = var->bitOffset_[0] + index * var->valueStride_;
+    revShift = 64 - var->valueBytes_ * 8;
+
+    // Byte aligned values of a native width
+    if ((bit % 8) == 0 && (var->valueStride_ % 8) == 0 && var->valueBits_ == var->valueBytes_ * 8) {
+        uint8_t* dst  = blockData_ + bit / 8;
+        uint32_t step = var->valueStride_ / 8;
+
+        switch (var->valueBytes_) {
+            case 1:
+                storeValues<uint8_t>(dst, src, step, count, false, conv);
+                return;
+            case 2:
+                storeValues<uint16_t>(dst, src, step, count, var->byteReverse_, conv);
+                return;
+            case 4:
+                storeValues<uint32_t>(dst, src, step, count, var->byteReverse_, conv);
+                return;
+            case 8:
+                storeValues<uint64_t>(dst, src, step, count, var->byteReverse_, conv);
+                return;
+        }
+    }
+
+    // Read, modify and write a 64-bit window for each value which is not byte aligned
+    mask = (var->valueBits_ >= 64) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << var->valueBits_) - 1);
+
+    for (x = 0; x < count; x++) {
+        raw = conv(src[x]);
+        if (var->byteReverse_) raw = swapValue(raw) >> revShift;
+
+        if (var->valueBits_ <= 56 && (bit / 8 + 8) <= size_) {
+            memcpy(&word, blockData_ + bit / 8, 8);
+            word = (word & ~(mask << (bit % 8))) | ((raw & mask) << (bit % 8));
+            memcpy(blockData_ + bit / 8, &word, 8);
+        } else {
+            copyBits(blockData_, bit, (uint8_t*)&raw, 0, var->valueBits_);
+        }
+        bit += var->valueStride_;
+    }
+}
+
+//////////////////////////////////////////
+// Bulk list access
+//////////////////////////////////////////
+
+#ifndef NO_PYTHON
+
+namespace {
+
+// Return a C contiguous version of a numpy array, the passed array is returned when already contiguous
+bp::object contiguousArray(bp::object& value) {
+    PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(value.ptr());
+
+    if (PyArray_ISCARRAY_RO(arr)) return value;
+
+    bp::handle<> handle(reinterpret_cast<PyObject*>(PyArray_GETCONTIGUOUS(arr)));
+    return bp::object(handle);
+}
+
+}  // namespace
+
+// Get a range of a list variable as a numpy array
+bp::object rim::Block::getArrayPy(rim::Variable* var, int32_t index, int32_t count) {
+    PyArrayObject* arr;
+    PyObject* obj;
+    int32_t type;
+    uint32_t x;
+
+    if (index < 0) index = 0;
+    if (count < 0) count = ((uint32_t)index < var->numValues_) ? (int32_t)(var->numValues_ - (uint32_t)index) : 0;
+
+    switch (var->modelId_) {
+        case rim::UInt:
+            type = (var->valueBits_ > 32) ? NPY_UINT64 : NPY_UINT32;
+            break;
+        case rim::Int:
+            type = (var->valueBits_ > 32) ? NPY_INT64 : NPY_INT32;
+            break;
+        case rim::Bool:
+            type = NPY_BOOL;
+            break;
+        case rim::Float:
+            type = NPY_FLOAT32;
+            break;
+        case rim::Double:
+        case rim::Fixed:
+            type = NPY_FLOAT64;
+            break;
+        default:
+            type = NPY_NOTYPE;
+            break;
+    }
+
+    // Models without a numpy representation are returned as a list
+    if (type == NPY_NOTYPE || var->valueBits_ > 64) {
+        if (var->getFuncPy_ == NULL || ((uint64_t)index + count) > var->numValues_)
+            throw(rogue::GeneralError::create("Block::getArrayPy",
+                                              "Invalid range at index %" PRIi32 " with length %" PRIi32 " for %s",
+                                              index,
+                                              count,
+                                              var->name_.c_str()));
+        bp::list ret;
+        for (x = 0; x < (uint32_t)count; x++) ret.append((this->*(var->getFuncPy_))(var, index + x));
+        return ret;
+    }
+
+    checkList("Block::getArrayPy", var, index, count);
+
+    npy_intp dims[1] = {count};
+    obj              = PyArray_SimpleNew(1, dims, type);
+    arr              = reinterpret_cast<PyArrayObject*>(obj);
+    bp::handle<> handle(obj);
+
+    switch (type) {
+        case NPY_UINT64:
+            getListValues(reinterpret_cast<uint64_t*>(PyArray_DATA(arr)), var, index, count, UIntConv());
+            break;
+        case NPY_UINT32:
+            getListValues(reinterpret_cast<uint32_t*>(PyArray_DATA(arr)), var, index, count, UInt32Conv());
+            break;
+        case NPY_INT64:
+            getListValues(reinterpret_cast<int64_t*>(PyArray_DATA(arr)), var, index, count, IntConv(var->valueBits_));
+            break;
+        case NPY_INT32:
+            getListValues(reinterpret_cast<int32_t*>(PyArray_DATA(arr)), var, index, count, IntConv(var->valueBits_));
+            break;
+        case NPY_BOOL:
+            getListValues(reinterpret_cast<bool*>(PyArray_DATA(arr)), var, index, count, BoolConv());
+            break;
+        case NPY_FLOAT32:
+            getListValues(reinterpret_cast<float*>(PyArray_DATA(arr)), var, index, count, FloatConv());
+            break;
+        default:
+            if (var->modelId_ == rim::Fixed)
+                getListValues(reinterpret_cast<double*>(PyArray_DATA(arr)),
+                              var,
+                              index,
+                              count,
+                              FixedConv(var->valueBits_, var->binPoint_));
+            else
+                getListValues(reinterpret_cast<double*>(PyArray_DATA(arr)), var, index, count, DoubleConv());
+            break;
+    }
+    return bp::object(handle);
+}
+
+#endif
+
+// Set count values of a list variable starting at index using unsigned int
+void rim::Block::setUIntArray(const uint64_t* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::setUIntArray", var, index, count);
+    checkListValues("Block::setUIntArray", var, value, count);
+    setListValues(value, var, index, count, UIntConv());
+}
+
+// Get count values of a list variable starting at index using unsigned int
+void rim::Block::getUIntArray(uint64_t* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::getUIntArray", var, index, count);
+    getListValues(value, var, index, count, UIntConv());
+}
+
+// Set count values of a list variable starting at index using int
+void rim::Block::setIntArray(const int64_t* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::setIntArray", var, index, count);
+    checkListValues("Block::setIntArray", var, value, count);
+    setListValues(value, var, index, count, IntConv(var->valueBits_));
+}
+
+// Get count values of a list variable starting at index using int
+void rim::Block::getIntArray(int64_t* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::getIntArray", var, index, count);
+    getListValues(value, var, index, count, IntConv(var->valueBits_));
+}
+
+// Set count values of a list variable starting at index using bool
+void rim::Block::setBoolArray(const bool* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::setBoolArray", var, index, count);
+    setListValues(value, var, index, count, BoolConv());
+}
+
+// Get count values of a list variable starting at index using bool
+void rim::Block::getBoolArray(bool* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::getBoolArray", var, index, count);
+    getListValues(value, var, index, count, BoolConv());
+}
+
+// Set count values of a list variable starting at index using float
+void rim::Block::setFloatArray(const float* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::setFloatArray", var, index, count);
+    checkListValues("Block::setFloatArray", var, value, count);
+    setListValues(value, var, index, count, FloatConv());
+}
+
+// Get count values of a list variable starting at index using float
+void rim::Block::getFloatArray(float* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::getFloatArray", var, index, count);
+    getListValues(value, var, index, count, FloatConv());
+}
+
+// Set count values of a list variable starting at index using double
+void rim::Block::setDoubleArray(const double* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::setDoubleArray", var, index, count);
+    checkListValues("Block::setDoubleArray", var, value, count);
+    setListValues(value, var, index, count, DoubleConv());
+}
+
+// Get count values of a list variable starting at index using double
+void rim::Block::getDoubleArray(double* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::getDoubleArray", var, index, count);
+    getListValues(value, var, index, count, DoubleConv());
+}
+
+// Set count values of a list variable starting at index using fixed point
+void rim::Block::setFixedArray(const double* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::setFixedArray", var, index, count);
+    checkListValues("Block::setFixedArray", var, value, count);
+    setListValues(value, var, index, count, FixedConv(var->valueBits_, var->binPoint_));
+}
+
+// Get count values of a list variable starting at index using fixed point
+void rim::Block::getFixedArray(double* value, rim::Variable* var, uint32_t index, uint32_t count) {
+    checkList("Block::getFixedArray", var, index, count);
+    getListValues(value, var, index, count, FixedConv(var->valueBits_, var->binPoint_));
+}
+
 //////////////////////////////////////////
 // Python functions
 //////////////////////////////////////////
@@ -860,8 +1394,9 @@ void rim::Block::setUIntPy(bp::object& value, rim::Variable* var, int32_t index)
 
     // Passed value is a numpy value
     if (PyArray_Check(value.ptr())) {
-        // Cast to an array object and check that the numpy array
-        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(value.ptr());
+        // Cast to a contiguous array object and check that the numpy array
+        bp::object cont    = contiguousArray(value);
+        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(cont.ptr());
         npy_intp ndims     = PyArray_NDIM(arr);
         npy_intp* dims     = PyArray_SHAPE(arr);
 
@@ -882,10 +1417,12 @@ void rim::Block::setUIntPy(bp::object& value, rim::Variable* var, int32_t index)
 
         if (PyArray_TYPE(arr) == NPY_UINT64) {
             uint64_t* src = reinterpret_cast<uint64_t*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setUInt(src[x], var, index + x);
+            checkListValues("Block::setUIntPy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], UIntConv());
         } else if (PyArray_TYPE(arr) == NPY_UINT32) {
             uint32_t* src = reinterpret_cast<uint32_t*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setUInt(src[x], var, index + x);
+            checkListValues("Block::setUIntPy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], UIntConv());
         } else
             throw(rogue::GeneralError::create("Block::setUIntPy",
                                               "Passed nparray is not of type (uint64 or uint32) for %s",
@@ -946,29 +1483,10 @@ void rim::Block::setUIntPy(bp::object& value, rim::Variable* var, int32_t index)
 // Get data using unsigned int
 bp::object rim::Block::getUIntPy(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
-    PyObject* obj;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
-        // Create a numpy array to receive it and locate the destination data buffer
-        npy_intp dims[1] = {var->numValues_};
-
-        if (var->valueBits_ > 32) {
-            obj                = PyArray_SimpleNew(1, dims, NPY_UINT64);
-            PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-            uint64_t* dst      = reinterpret_cast<uint64_t*>(PyArray_DATA(arr));
-
-            for (x = 0; x < var->numValues_; x++) dst[x] = getUInt(var, x);
-        } else {
-            obj                = PyArray_SimpleNew(1, dims, NPY_UINT32);
-            PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-            uint32_t* dst      = reinterpret_cast<uint32_t*>(PyArray_DATA(arr));
-
-            for (x = 0; x < var->numValues_; x++) dst[x] = (uint32_t)getUInt(var, x);
-        }
-        boost::python::handle<> handle(obj);
-        ret = bp::object(handle);
+        ret = getArrayPy(var, 0, var->numValues_);
     } else {
         PyObject* val = Py_BuildValue("K", getUInt(var, index));
 
@@ -1019,8 +1537,9 @@ void rim::Block::setIntPy(bp::object& value, rim::Variable* var, int32_t index)
 
     // Passed value is a numpy value
     if (PyArray_Check(value.ptr())) {
-        // Cast to an array object and check that the numpy array
-        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(value.ptr());
+        // Cast to a contiguous array object and check that the numpy array
+        bp::object cont    = contiguousArray(value);
+        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(cont.ptr());
         npy_intp ndims     = PyArray_NDIM(arr);
         npy_intp* dims     = PyArray_SHAPE(arr);
 
@@ -1041,10 +1560,12 @@ void rim::Block::setIntPy(bp::object& value, rim::Variable* var, int32_t index)
 
         if (PyArray_TYPE(arr) == NPY_INT64) {
             int64_t* src = reinterpret_cast<int64_t*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setInt(src[x], var, index + x);
+            checkListValues("Block::setIntPy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], IntConv(var->valueBits_));
         } else if (PyArray_TYPE(arr) == NPY_INT32) {
             int32_t* src = reinterpret_cast<int32_t*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setInt(src[x], var, index + x);
+            checkListValues("Block::setIntPy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], IntConv(var->valueBits_));
         } else
             throw(rogue::GeneralError::create("Block::setIntPy",
                                               "Passed nparray is not of type (int64 or int32) for %s",
@@ -1105,29 +1626,10 @@ void rim::Block::setIntPy(bp::object& value, rim::Variable* var, int32_t index)
 // Get data using int
 bp::object rim::Block::getIntPy(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
-    PyObject* obj;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
-        // Create a numpy array to receive it and locate the destination data buffer
-        npy_intp dims[1] = {var->numValues_};
-
-        if (var->valueBits_ > 32) {
-            obj                = PyArray_SimpleNew(1, dims, NPY_INT64);
-            PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-            int64_t* dst       = reinterpret_cast<int64_t*>(PyArray_DATA(arr));
-
-            for (x = 0; x < var->numValues_; x++) dst[x] = getInt(var, x);
-        } else {
-            obj                = PyArray_SimpleNew(1, dims, NPY_INT32);
-            PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-            int32_t* dst       = reinterpret_cast<int32_t*>(PyArray_DATA(arr));
-
-            for (x = 0; x < var->numValues_; x++) dst[x] = (int32_t)getInt(var, x);
-        }
-        boost::python::handle<> handle(obj);
-        ret = bp::object(handle);
+        ret = getArrayPy(var, 0, var->numValues_);
     } else {
         PyObject* val = Py_BuildValue("L", getInt(var, index));
 
@@ -1182,8 +1684,9 @@ void rim::Block::setBoolPy(bp::object& value, rim::Variable* var, int32_t index)
 
     // Passed value is a numpy value
     if (PyArray_Check(value.ptr())) {
-        // Cast to an array object and check that the numpy array
-        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(value.ptr());
+        // Cast to a contiguous array object and check that the numpy array
+        bp::object cont    = contiguousArray(value);
+        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(cont.ptr());
         npy_intp ndims     = PyArray_NDIM(arr);
         npy_intp* dims     = PyArray_SHAPE(arr);
 
@@ -1204,7 +1707,7 @@ void rim::Block::setBoolPy(bp::object& value, rim::Variable* var, int32_t index)
 
         if (PyArray_TYPE(arr) == NPY_BOOL) {
             bool* src = reinterpret_cast<bool*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setBool(src[x], var, index + x);
+            setListValues(src, var, index, dims[0], BoolConv());
         } else
             throw(rogue::GeneralError::create("Block::setBoolPy",
                                               "Passed nparray is not of type (bool) for %s",
@@ -1261,20 +1764,10 @@ void rim::Block::setBoolPy(bp::object& value, rim::Variable* var, int32_t index)
 // Get data using bool
 bp::object rim::Block::getBoolPy(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
-        // Create a numpy array to receive it and locate the destination data buffer
-        npy_intp dims[1]   = {var->numValues_};
-        PyObject* obj      = PyArray_SimpleNew(1, dims, NPY_BOOL);
-        PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-        bool* dst          = reinterpret_cast<bool*>(PyArray_DATA(arr));
-
-        for (x = 0; x < var->numValues_; x++) dst[x] = getBool(var, x);
-
-        boost::python::handle<> handle(obj);
-        ret = bp::object(handle);
+        ret = getArrayPy(var, 0, var->numValues_);
     }
 
     else {
@@ -1392,8 +1885,9 @@ void rim::Block::setFloatPy(bp::object& value, rim::Variable* var, int32_t index
 
     // Passed value is a numpy value
     if (PyArray_Check(value.ptr())) {
-        // Cast to an array object and check that the numpy array
-        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(value.ptr());
+        // Cast to a contiguous array object and check that the numpy array
+        bp::object cont    = contiguousArray(value);
+        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(cont.ptr());
         npy_intp ndims     = PyArray_NDIM(arr);
         npy_intp* dims     = PyArray_SHAPE(arr);
 
@@ -1414,7 +1908,8 @@ void rim::Block::setFloatPy(bp::object& value, rim::Variable* var, int32_t index
 
         if (PyArray_TYPE(arr) == NPY_FLOAT32) {
             float* src = reinterpret_cast<float*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setFloat(src[x], var, index + x);
+            checkListValues("Block::setFloatPy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], FloatConv());
         } else
             throw(rogue::GeneralError::create("Block::setFLoatPy",
                                               "Passed nparray is not of type (float32) for %s",
@@ -1472,20 +1967,10 @@ void rim::Block::setFloatPy(bp::object& value, rim::Variable* var, int32_t index
 // Get data using float
 bp::object rim::Block::getFloatPy(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
-        // Create a numpy array to receive it and locate the destination data buffer
-        npy_intp dims[1]   = {var->numValues_};
-        PyObject* obj      = PyArray_SimpleNew(1, dims, NPY_FLOAT32);
-        PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-        float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
-
-        for (x = 0; x < var->numValues_; x++) dst[x] = getFloat(var, x);
-
-        boost::python::handle<> handle(obj);
-        ret = bp::object(handle);
+        ret = getArrayPy(var, 0, var->numValues_);
     }
 
     else {
@@ -1538,8 +2023,9 @@ void rim::Block::setDoublePy(bp::object& value, rim::Variable* var, int32_t inde
 
     // Passed value is a numpy value
     if (PyArray_Check(value.ptr())) {
-        // Cast to an array object and check that the numpy array
-        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(value.ptr());
+        // Cast to a contiguous array object and check that the numpy array
+        bp::object cont    = contiguousArray(value);
+        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(cont.ptr());
         npy_intp ndims     = PyArray_NDIM(arr);
         npy_intp* dims     = PyArray_SHAPE(arr);
 
@@ -1560,7 +2046,8 @@ void rim::Block::setDoublePy(bp::object& value, rim::Variable* var, int32_t inde
 
         if (PyArray_TYPE(arr) == NPY_FLOAT64) {
             double* src = reinterpret_cast<double*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setDouble(src[x], var, index + x);
+            checkListValues("Block::setDoublePy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], DoubleConv());
         } else
             throw(rogue::GeneralError::create("Block::setFLoatPy",
                                               "Passed nparray is not of type (double) for %s",
@@ -1619,20 +2106,10 @@ void rim::Block::setDoublePy(bp::object& value, rim::Variable* var, int32_t inde
 // Get data using double
 bp::object rim::Block::getDoublePy(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
-        // Create a numpy array to receive it and locate the destination data buffer
-        npy_intp dims[1]   = {var->numValues_};
-        PyObject* obj      = PyArray_SimpleNew(1, dims, NPY_FLOAT64);
-        PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-        double* dst        = reinterpret_cast<double*>(PyArray_DATA(arr));
-
-        for (x = 0; x < var->numValues_; x++) dst[x] = getDouble(var, x);
-
-        boost::python::handle<> handle(obj);
-        ret = bp::object(handle);
+        ret = getArrayPy(var, 0, var->numValues_);
     }
 
     else {
@@ -1685,8 +2162,9 @@ void rim::Block::setFixedPy(bp::object& value, rim::Variable* var, int32_t index
 
     // Passed value is a numpy value
     if (PyArray_Check(value.ptr())) {
-        // Cast to an array object and check that the numpy array
-        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(value.ptr());
+        // Cast to a contiguous array object and check that the numpy array
+        bp::object cont    = contiguousArray(value);
+        PyArrayObject* arr = reinterpret_cast<decltype(arr)>(cont.ptr());
         npy_intp ndims     = PyArray_NDIM(arr);
         npy_intp* dims     = PyArray_SHAPE(arr);
 
@@ -1707,7 +2185,8 @@ void rim::Block::setFixedPy(bp::object& value, rim::Variable* var, int32_t index
 
         if (PyArray_TYPE(arr) == NPY_FLOAT64) {
             double* src = reinterpret_cast<double*>(PyArray_DATA(arr));
-            for (x = 0; x < dims[0]; x++) setFixed(src[x], var, index + x);
+            checkListValues("Block::setFixedPy", var, src, dims[0]);
+            setListValues(src, var, index, dims[0], FixedConv(var->valueBits_, var->binPoint_));
         } else
             throw(rogue::GeneralError::create("Block::setFixedPy",
                                               "Passed nparray is not of type (double) for %s",
@@ -1766,20 +2245,10 @@ void rim::Block::setFixedPy(bp::object& value, rim::Variable* var, int32_t index
 // Get data using fixed point
 bp::object rim::Block::getFixedPy(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
-        // Create a numpy array to receive it and locate the destination data buffer
-        npy_intp dims[1]   = {var->numValues_};
-        PyObject* obj      = PyArray_SimpleNew(1, dims, NPY_FLOAT64);
-        PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
-        double* dst        = reinterpret_cast<double*>(PyArray_DATA(arr));
-
-        for (x = 0; x < var->numValues_; x++) dst[x] = getFixed(var, x);
-
-        boost::python::handle<> handle(obj);
-        ret = bp::object(handle);
+        ret = getArrayPy(var, 0, var->numValues_);
     }
 
     else {
@@ -0,0 +1,308 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Memory Block Batch
+ * ----------------------------------------------------------------------------
+ * File       : BlockBatch.cpp
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Issues transactions for a list of blocks, merging address contiguous
+ * block ranges into larger transactions.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/memory/BlockBatch.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "rogue/GilRelease.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Slave.h"
+
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class factory which returns a pointer to a BlockBatch (BlockBatchPtr)
+rim::BlockBatchPtr rim::BlockBatch::create() {
+    rim::BlockBatchPtr b = std::make_shared<rim::BlockBatch>();
+    return (b);
+}
+
+// Setup class for use in python
+void rim::BlockBatch::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rim::BlockBatch, rim::BlockBatchPtr, boost::noncopyable>("BlockBatch", bp::init<>())
+        .def("transaction", &rim::BlockBatch::transactionPy)
+        .def("getBlockCount", &rim::BlockBatch::getBlockCount)
+        .def("getTransactionCount", &rim::BlockBatch::getTransactionCount)
+        .def("getMergeCount", &rim::BlockBatch::getMergeCount)
+        .def("getByteCount", &rim::BlockBatch::getByteCount)
+        .def("getRetryCount", &rim::BlockBatch::getRetryCount)
+        .def("getCoalesceRatio", &rim::BlockBatch::getCoalesceRatio)
+        .def("resetStats", &rim::BlockBatch::resetStats);
+#endif
+}
+
+//! Create a BlockBatch
+rim::BlockBatch::BlockBatch() : blockCount_(0), tranCount_(0), mergeCount_(0), byteCount_(0), retryCount_(0) {
+    log_ = rogue::Logging::create("memory.BlockBatch");
+}
+
+//! Destroy the BlockBatch
+rim::BlockBatch::~BlockBatch() {}
+
+// Merge address contiguous ranges into groups
+void rim::BlockBatch::buildGroups() {
+    uint32_t stage;
+    uint32_t x;
+    Group group;
+
+    // Order by slave and then address so that contiguous ranges are adjacent
+    std::sort(ranges_.begin(), ranges_.end(), [](const Range& a, const Range& b) {
+        return (a.slave != b.slave) ? (a.slave < b.slave) : (a.address < b.address);
+    });
+
+    groups_.clear();
+
+    for (x = 0; x < ranges_.size(); x++) {
+        Range& range = ranges_[x];
+
+        if (!groups_.empty()) {
+            Group& last    = groups_.back();
+            Range& lastRng = ranges_[x - 1];
+
+            if (lastRng.slave == range.slave && (lastRng.address + lastRng.size) == range.address &&
+                ((uint64_t)last.size + range.size) <= last.max) {
+                last.count++;
+                last.size += range.size;
+                continue;
+            }
+        }
+
+        group.first = x;
+        group.count = 1;
+        group.size  = range.size;
+        group.max   = range.block->reqMaxAccess();
+        group.stage = 0;
+        groups_.push_back(group);
+    }
+
+    // Staging space is only needed for merged groups
+    stage = 0;
+    for (x = 0; x < groups_.size(); x++) {
+        if (groups_[x].count > 1) {
+            groups_[x].stage = stage;
+            stage += groups_[x].size;
+        }
+    }
+    if (stage_.size() < stage) stage_.resize(stage);
+}
+
+// Issue the grouped transactions and wait for the merged ones to complete
+void rim::BlockBatch::runGroups(uint32_t type) {
+    std::string err;
+    uint8_t* data;
+    uint32_t x;
+    uint32_t y;
+
+    // Issue all transactions before waiting on any of them
+    for (x = 0; x < groups_.size(); x++) {
+        Group& group = groups_[x];
+        Range& lead  = ranges_[group.first];
+
+        if (group.count == 1) {
+            lead.block->reqTransaction(lead.address, lead.size, lead.data, type);
+        } else {
+            data = stage_.data() + group.stage;
+
+            // Gather write data
+            if (type == rim::Write || type == rim::Post) {
+                for (y = group.first; y < group.first + group.count; y++)
+                    memcpy(data + (ranges_[y].address - lead.address), ranges_[y].data, ranges_[y].size);
+            }
+
+            // The lead block issues the merged transaction to the shared slave
+            lead.block->reqTransaction(lead.address, group.size, data, type);
+            mergeCount_ += group.count;
+        }
+        tranCount_++;
+        byteCount_ += group.size;
+    }
+
+    // Complete the merged transactions
+    for (x = 0; x < groups_.size(); x++) {
+        Group& group = groups_[x];
+        Range& lead  = ranges_[group.first];
+
+        if (group.count == 1) continue;
+
+        lead.block->waitTransaction(0);
+        err  = lead.block->getError();
+        data = stage_.data() + group.stage;
+
+        // Retry as one transaction per block so errors are reported against each block
+        if (err != "") {
+            log_->warning("Merged transaction of %" PRIu32 " blocks at address 0x%" PRIx64 " failed: %s",
+                          group.count,
+                          lead.address,
+                          err.c_str());
+            lead.block->clearError();
+
+            for (y = group.first; y < group.first + group.count; y++)
+                ranges_[y].block->reqTransaction(ranges_[y].address, ranges_[y].size, ranges_[y].data, type);
+
+            retryCount_ += group.count;
+            tranCount_ += group.count;
+        }
+
+        // Scatter read data
+        else if (type == rim::Read || type == rim::Verify) {
+            for (y = group.first; y < group.first + group.count; y++)
+                memcpy(ranges_[y].data, data + (ranges_[y].address - lead.address), ranges_[y].size);
+        }
+    }
+}
+
+// Lock each block once in address order
+void rim::BlockBatch::lockBlocks(std::vector<rim::BlockPtr>& blocks) {
+    std::vector<rim::BlockPtr>::iterator it;
+    std::vector<rim::Block*>::iterator bit;
+
+    locked_.clear();
+    for (it = blocks.begin(); it != blocks.end(); ++it) locked_.push_back(it->get());
+
+    std::sort(locked_.begin(), locked_.end());
+    locked_.erase(std::unique(locked_.begin(), locked_.end()), locked_.end());
+
+    for (bit = locked_.begin(); bit != locked_.end(); ++bit) (*bit)->mtx_.lock();
+}
+
+// Release the block locks
+void rim::BlockBatch::unlockBlocks() {
+    std::vector<rim::Block*>::iterator bit;
+
+    for (bit = locked_.begin(); bit != locked_.end(); ++bit) (*bit)->mtx_.unlock();
+    locked_.clear();
+}
+
+// Run a transaction for a list of blocks
+void rim::BlockBatch::transaction(std::vector<rim::BlockPtr> blocks, uint32_t type, bool forceWr, bool check) {
+    std::vector<rim::BlockPtr>::iterator it;
+    Range range;
+    uint32_t tOff;
+    uint32_t x;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    ranges_.clear();
+
+    // Block data must not change until it has been gathered or scattered
+    lockBlocks(blocks);
+
+    try {
+        // Setup the range of each block, same as Block::intStartTransaction()
+        for (it = blocks.begin(); it != blocks.end(); ++it) {
+            rim::Block* block = it->get();
+
+            if (block->blockPyTrans_ || !block->validTransaction(type, forceWr)) continue;
+
+            block->waitTransaction(0);
+            block->clearError();
+
+            if (!block->setupTransaction(type, NULL, -1, tOff, range.size, range.data)) continue;
+
+            range.block   = block;
+            range.slave   = block->getSlave().get();
+            range.address = block->offset_ + tOff;
+            ranges_.push_back(range);
+        }
+        blockCount_ += ranges_.size();
+
+        buildGroups();
+        runGroups(type);
+    } catch (...) {
+        unlockBlocks();
+        throw;
+    }
+    unlockBlocks();
+
+    if (check) {
+        for (x = 0; x < ranges_.size(); x++) ranges_[x].block->checkTransaction();
+    }
+}
+
+#ifndef NO_PYTHON
+
+// Run a transaction for a list of blocks, python version
+void rim::BlockBatch::transactionPy(bp::object blocks, uint32_t type, bool forceWr, bool check) {
+    std::vector<rim::BlockPtr> blockList = rim::py_list_to_std_vector<rim::BlockPtr>(blocks);
+    std::vector<rim::BlockPtr>::iterator it;
+
+    transaction(blockList, type, forceWr, false);
+
+    if (check) {
+        for (it = blockList.begin(); it != blockList.end(); ++it) (*it)->checkTransactionPy();
+    }
+}
+
+#endif
+
+//! Get the number of block transactions requested
+uint64_t rim::BlockBatch::getBlockCount() {
+    return blockCount_;
+}
+
+//! Get the number of transactions issued to the slaves
+uint64_t rim::BlockBatch::getTransactionCount() {
+    return tranCount_;
+}
+
+//! Get the number of block transactions which were merged with another
+uint64_t rim::BlockBatch::getMergeCount() {
+    return mergeCount_;
+}
+
+//! Get the number of bytes transferred
+uint64_t rim::BlockBatch::getByteCount() {
+    return byteCount_;
+}
+
+//! Get the number of merged transactions retried per block after an error
+uint64_t rim::BlockBatch::getRetryCount() {
+    return retryCount_;
+}
+
+//! Get the average number of block transactions per issued transaction
+double rim::BlockBatch::getCoalesceRatio() {
+    uint64_t trans = tranCount_;
+
+    if (trans == 0) return 0.0;
+    return (double)blockCount_ / (double)trans;
+}
+
+//! Reset the statistics
+void rim::BlockBatch::resetStats() {
+    blockCount_ = 0;
+    tranCount_  = 0;
+    mergeCount_ = 0;
+    byteCount_  = 0;
+    retryCount_ = 0;
+}
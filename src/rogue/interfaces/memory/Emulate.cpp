@@ -22,11 +22,18 @@
 
 #include "rogue/interfaces/memory/Emulate.h"
 
+#include <fcntl.h>
 #include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <memory>
+#include <string>
 
+#include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Transaction.h"
@@ -39,6 +46,9 @@ namespace rim = rogue::interfaces::memory;
 namespace bp = boost::python;
 #endif
 
+const uint32_t rim::Emulate::LevelBits;
+const uint32_t rim::Emulate::LockStripes;
+
 //! Create a block, class creator
 rim::EmulatePtr rim::Emulate::create(uint32_t min, uint32_t max) {
     rim::EmulatePtr b = std::make_shared<rim::Emulate>(min, max);
@@ -46,60 +56,188 @@ rim::EmulatePtr rim::Emulate::create(uint32_t min, uint32_t max) {
 }
 
 //! Create an block
-rim::Emulate::Emulate(uint32_t min, uint32_t max) : Slave(min, max) {}
+rim::Emulate::Emulate(uint32_t min, uint32_t max) : Slave(min, max), pageCount_(0) {
+    pageBits_ = 12;
+    root_     = NULL;
+    fd_       = -1;
+    fileBase_ = NULL;
+    fileSize_ = 0;
+    initTable();
+}
 
 //! Destroy a block
 rim::Emulate::~Emulate() {
-    MAP_TYPE::iterator it = memMap_.begin();
-    while (it != memMap_.end()) {
-        free(it->second);
-        ++it;
+    freeNode(root_, 0);
+
+    if (fileBase_ != NULL) munmap(fileBase_, fileSize_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+// Allocate the page table root
+void rim::Emulate::initTable() {
+    levels_ = (64 - pageBits_ + LevelBits - 1) / LevelBits;
+    root_   = new Entry[1 << LevelBits]();
+}
+
+// Free a page table node and everything below it
+void rim::Emulate::freeNode(Entry* node, uint32_t level) {
+    uint32_t x;
+    void* next;
+
+    for (x = 0; x < (1U << LevelBits); x++) {
+        if ((next = node[x].load(std::memory_order_relaxed)) == NULL) continue;
+
+        if (level == (levels_ - 1))
+            free(next);
+        else
+            freeNode(reinterpret_cast<Entry*>(next), level + 1);
+    }
+    delete[] node;
+}
+
+// Return the data of a page, allocating it on first access
+uint8_t* rim::Emulate::findPage(uint64_t page) {
+    Entry* node = root_;
+    void* next;
+    void* alloc;
+    uint32_t level;
+    uint32_t shift;
+
+    for (level = 0; level < levels_; level++) {
+        shift      = (levels_ - 1 - level) * LevelBits;
+        Entry& ent = node[(page >> shift) & ((1 << LevelBits) - 1)];
+
+        // Entries are only ever set once, lookups do not need a lock
+        if ((next = ent.load(std::memory_order_acquire)) == NULL) {
+            if (level == (levels_ - 1))
+                alloc = calloc(1, 1ULL << pageBits_);
+            else
+                alloc = new Entry[1 << LevelBits]();
+
+            next = NULL;
+            if (ent.compare_exchange_strong(next, alloc, std::memory_order_acq_rel)) {
+                next = alloc;
+                if (level == (levels_ - 1)) pageCount_++;
+            } else if (level == (levels_ - 1)) {
+                free(alloc);
+            } else {
+                delete[] reinterpret_cast<Entry*>(alloc);
+            }
+        }
+        node = reinterpret_cast<Entry*>(next);
+    }
+    return reinterpret_cast<uint8_t*>(node);
+}
+
+//! Set the page size
+void rim::Emulate::setPageSize(uint32_t size) {
+    uint32_t bits;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    for (bits = 6; bits <= 24; bits++)
+        if (size == (1U << bits)) break;
+
+    if (bits > 24)
+        throw(rogue::GeneralError::create("Emulate::setPageSize",
+                                          "Invalid page size %" PRIu32 ", must be a power of two from 64 to 16M",
+                                          size));
+
+    if (pageCount_ != 0 || (fileSize_ % size) != 0)
+        throw(rogue::GeneralError::create("Emulate::setPageSize",
+                                          "Page size must be set before the first access and divide the file size"));
+
+    freeNode(root_, 0);
+    pageBits_ = bits;
+    initTable();
+}
+
+//! Get the page size
+uint32_t rim::Emulate::getPageSize() {
+    return (1 << pageBits_);
+}
+
+//! Get the number of allocated pages
+uint64_t rim::Emulate::getPageCount() {
+    return pageCount_;
+}
+
+//! Back the low part of the address space with a file
+void rim::Emulate::mapFile(std::string path, uint64_t size) {
+    struct stat st;
+    void* base;
+    int fd;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (fileBase_ != NULL || pageCount_ != 0)
+        throw(rogue::GeneralError::create("Emulate::mapFile", "File must be mapped before the first access"));
+
+    if (size == 0 || (size % (1ULL << pageBits_)) != 0)
+        throw(rogue::GeneralError::create("Emulate::mapFile",
+                                          "Size 0x%" PRIx64 " is not a multiple of the page size",
+                                          size));
+
+    if ((fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644)) < 0)
+        throw(rogue::GeneralError::create("Emulate::mapFile", "Failed to open file: %s", path.c_str()));
+
+    // Extend the file, the new space is sparse and reads as zero
+    if (fstat(fd, &st) != 0 || ((uint64_t)st.st_size < size && ftruncate(fd, size) != 0)) {
+        ::close(fd);
+        throw(rogue::GeneralError::create("Emulate::mapFile", "Failed to size file: %s", path.c_str()));
     }
+
+    if ((base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        ::close(fd);
+        throw(rogue::GeneralError::create("Emulate::mapFile", "Failed to map file: %s", path.c_str()));
+    }
+
+    filePath_ = path;
+    fd_       = fd;
+    fileBase_ = reinterpret_cast<uint8_t*>(base);
+    fileSize_ = size;
 }
 
 //! Post a transaction. Master will call this method with the access attributes.
 void rim::Emulate::doTransaction(rim::TransactionPtr tran) {
-    uint64_t addr4k;
-    uint64_t off4k;
-    uint64_t size4k;
+    uint64_t page;
+    uint64_t off;
+    uint64_t chunk;
+    uint8_t* mem;
     uint32_t size = tran->size();
     uint32_t type = tran->type();
     uint64_t addr = tran->address();
     uint8_t* ptr  = tran->begin();
-
-    // printf("Got transaction address=0x%" PRIx64 ", size=%" PRIu32 ", type = %" PRIu32 "\n", addr, size, type);
+    uint64_t mask = (1ULL << pageBits_) - 1;
+    bool write    = (type == rogue::interfaces::memory::Write || type == rogue::interfaces::memory::Post);
 
     rogue::interfaces::memory::TransactionLockPtr tlock = tran->lock();
-    {
-        std::lock_guard<std::mutex> lock(mtx_);
 
-        while (size > 0) {
-            addr4k = (addr / 0x1000) * 0x1000;
-            off4k  = addr % 0x1000;
-            size4k = (addr4k + 0x1000) - (addr4k + off4k);
+    while (size > 0) {
+        page  = addr >> pageBits_;
+        off   = addr & mask;
+        chunk = (mask + 1) - off;
 
-            if (size4k > size) size4k = size;
-            size -= size4k;
-            addr += size4k;
+        if (chunk > size) chunk = size;
 
-            if (memMap_.find(addr4k) == memMap_.end()) memMap_.insert(std::make_pair(addr4k, (uint8_t*)malloc(0x1000)));
+        // File backed region
+        if (addr < fileSize_)
+            mem = fileBase_ + addr;
+        else
+            mem = findPage(page) + off;
 
-            // Write or post
-            if (tran->type() == rogue::interfaces::memory::Write || tran->type() == rogue::interfaces::memory::Post) {
-                // printf("Write data to 4k=0x%" PRIx64 ", offset=0x%" PRIx64 ", size=%" PRIu64 "\n", addr4k, off4k,
-                // size4k);
-                memcpy(memMap_[addr4k] + off4k, ptr, size4k);
-            }
+        {
+            std::lock_guard<std::mutex> lock(stripes_[page % LockStripes]);
 
-            // Read or verify
-            else {
-                // printf("Read data from 4k=0x%" PRIx64 ", offset=0x%" PRIx64 ", size=%" PRIu64 "\n", addr4k, off4k,
-                // size4k);
-                memcpy(ptr, memMap_[addr4k] + off4k, size4k);
-            }
-
-            ptr += size4k;
+            if (write)
+                memcpy(mem, ptr, chunk);
+            else
+                memcpy(ptr, mem, chunk);
         }
+
+        size -= chunk;
+        addr += chunk;
+        ptr += chunk;
     }
     tran->done();
 }
@@ -108,7 +246,11 @@ void rim::Emulate::setup_python() {
 #ifndef NO_PYTHON
     bp::class_<rim::Emulate, rim::EmulatePtr, bp::bases<rim::Slave>, boost::noncopyable>(
         "Emulate",
-        bp::init<uint32_t, uint32_t>());
+        bp::init<uint32_t, uint32_t>())
+        .def("setPageSize", &rim::Emulate::setPageSize)
+        .def("getPageSize", &rim::Emulate::getPageSize)
+        .def("getPageCount", &rim::Emulate::getPageCount)
+        .def("mapFile", &rim::Emulate::mapFile);
     bp::implicitly_convertible<rim::EmulatePtr, rim::SlavePtr>();
 #endif
 }
@@ -146,9 +146,10 @@ void rim::Hub::doTransaction(rim::TransactionPtr tran) {
         // Declare all subTransactions have been created
         tran->doneSubTransactions();
 
-        // Forward the subTransactions
-        for (rim::TransactionMap::iterator it = tran->subTranMap_.begin(); it != tran->subTranMap_.end(); it++) {
-            getSlave()->doTransaction(it->second);
+        // Forward the subTransactions, a sub-transaction removes itself from the map when it completes
+        for (rim::TransactionMap::iterator it = tran->subTranMap_.begin(); it != tran->subTranMap_.end();) {
+            rim::TransactionPtr subTran = (it++)->second;
+            getSlave()->doTransaction(subTran);
         }
     } else {
         // Forward transaction
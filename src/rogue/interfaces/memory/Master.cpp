@@ -35,6 +35,11 @@
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define ROGUE_BITS_BMI2
+#endif
+
 namespace rim = rogue::interfaces::memory;
 
 #ifndef NO_PYTHON
@@ -256,6 +261,128 @@ void rim::Master::waitTransaction(uint32_t id) {
     }
 }
 
+// Wait for a single transaction and return its error status
+std::string rim::Master::waitTransactionResult(uint32_t id) {
+    TransactionMap::iterator it;
+    rim::TransactionPtr tran;
+
+    rogue::GilRelease noGil;
+    {
+        std::unique_lock<std::mutex> lock(mastMtx_);
+        if ((it = tranMap_.find(id)) == tranMap_.end()) return "";
+        tran = it->second;
+        tranMap_.erase(it);
+    }
+    return tran->wait();
+}
+
+namespace {
+
+// Load up to 8 bytes as a little endian word
+inline uint64_t loadWord(const uint8_t* src, uint32_t bytes) {
+    uint64_t ret = 0;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (bytes == 8) {
+        std::memcpy(&ret, src, 8);
+        return ret;
+    }
+#endif
+    for (uint32_t x = 0; x < bytes; x++) ret |= (uint64_t)src[x] << (x * 8);
+    return ret;
+}
+
+// Store the low bytes of a little endian word
+inline void storeWord(uint8_t* dst, uint32_t bytes, uint64_t value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (bytes == 8) {
+        std::memcpy(dst, &value, 8);
+        return;
+    }
+#endif
+    for (uint32_t x = 0; x < bytes; x++) dst[x] = (uint8_t)(value >> (x * 8));
+}
+
+// Mask of the low bits
+inline uint64_t lowMask(uint32_t bits) {
+    return (bits >= 64) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << bits) - 1);
+}
+
+// Length of the run of set bits at the bottom of the value
+inline uint32_t runLength(uint64_t value) {
+    return (~value == 0) ? 64 : __builtin_ctzll(~value);
+}
+
+// Gather the masked bits of word into the low bits of the result, one step per run of set bits
+uint64_t extractSoft(uint64_t word, uint64_t mask) {
+    uint64_t ret = 0;
+    uint32_t pos = 0;
+    uint32_t shift;
+    uint32_t run;
+
+    while (mask != 0) {
+        shift = __builtin_ctzll(mask);
+        run   = runLength(mask >> shift);
+        ret |= ((word >> shift) & lowMask(run)) << pos;
+        mask &= ~(lowMask(run) << shift);
+        pos += run;
+    }
+    return ret;
+}
+
+// Scatter the low bits of value into the masked bits of the result
+uint64_t depositSoft(uint64_t value, uint64_t mask) {
+    uint64_t ret = 0;
+    uint32_t shift;
+    uint32_t run;
+
+    while (mask != 0) {
+        shift = __builtin_ctzll(mask);
+        run   = runLength(mask >> shift);
+        ret |= (value & lowMask(run)) << shift;
+        mask &= ~(lowMask(run) << shift);
+        value = (run == 64) ? 0 : (value >> run);
+    }
+    return ret;
+}
+
+#ifdef ROGUE_BITS_BMI2
+__attribute__((target("bmi2"))) uint64_t extractBmi2(uint64_t word, uint64_t mask) {
+    return _pext_u64(word, mask);
+}
+
+__attribute__((target("bmi2"))) uint64_t depositBmi2(uint64_t value, uint64_t mask) {
+    return _pdep_u64(value, mask);
+}
+#endif
+
+typedef uint64_t (*BitsFunc)(uint64_t, uint64_t);
+
+// Use pext/pdep when the cpu has fast versions, they are microcoded on AMD family 17h
+bool useBmi2() {
+#ifdef ROGUE_BITS_BMI2
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam17h");
+#else
+    return false;
+#endif
+}
+
+BitsFunc selectExtract() {
+#ifdef ROGUE_BITS_BMI2
+    if (useBmi2()) return extractBmi2;
+#endif
+    return extractSoft;
+}
+
+BitsFunc selectDeposit() {
+#ifdef ROGUE_BITS_BMI2
+    if (useBmi2()) return depositBmi2;
+#endif
+    return depositSoft;
+}
+}  // namespace
+
 //! Copy bits from src to dst with lsbs and size
 void rim::Master::copyBits(uint8_t* dstData, uint32_t dstLsb, uint8_t* srcData, uint32_t srcLsb, uint32_t size) {
     uint32_t srcBit;
@@ -264,6 +391,9 @@ void rim::Master::copyBits(uint8_t* dstData, uint32_t dstLsb, uint8_t* srcData,
     uint32_t dstByte;
     uint32_t rem;
     uint32_t bytes;
+    uint32_t num;
+    uint64_t mask;
+    uint64_t value;
 
     srcByte = srcLsb / 8;
     srcBit  = srcLsb % 8;
@@ -271,28 +401,33 @@ void rim::Master::copyBits(uint8_t* dstData, uint32_t dstLsb, uint8_t* srcData,
     dstBit  = dstLsb % 8;
     rem     = size;
 
-    do {
+    // Aligned
+    if ((srcBit == 0) && (dstBit == 0) && (rem >= 8)) {
         bytes = rem / 8;
+        std::memcpy(&(dstData[dstByte]), &(srcData[srcByte]), bytes);
+        dstByte += bytes;
+        srcByte += bytes;
+        rem -= (bytes * 8);
+    }
 
-        // Aligned
-        if ((srcBit == 0) && (dstBit == 0) && (bytes > 0)) {
-            std::memcpy(&(dstData[dstByte]), &(srcData[srcByte]), bytes);
-            dstByte += bytes;
-            srcByte += bytes;
-            rem -= (bytes * 8);
-        }
-
-        // Not aligned
-        else {
-            dstData[dstByte] &= ((0x1 << dstBit) ^ 0xFF);
-            dstData[dstByte] |= ((srcData[srcByte] >> srcBit) & 0x1) << dstBit;
-            srcByte += (++srcBit / 8);
-            dstByte += (++dstBit / 8);
-            srcBit %= 8;
-            dstBit %= 8;
-            rem -= 1;
-        }
-    } while (rem != 0);
+    // Not aligned, up to 56 bits per step so that both sides fit in a word
+    while (rem != 0) {
+        num   = (rem > 56) ? 56 : rem;
+        mask  = lowMask(num);
+        value = (loadWord(&(srcData[srcByte]), (srcBit + num + 7) / 8) >> srcBit) & mask;
+        bytes = (dstBit + num + 7) / 8;
+        storeWord(&(dstData[dstByte]),
+                  bytes,
+                  (loadWord(&(dstData[dstByte]), bytes) & ~(mask << dstBit)) | (value << dstBit));
+
+        srcBit += num;
+        dstBit += num;
+        srcByte += srcBit / 8;
+        dstByte += dstBit / 8;
+        srcBit %= 8;
+        dstBit %= 8;
+        rem -= num;
+    }
 }
 
 #ifndef NO_PYTHON
@@ -349,12 +484,13 @@ void rim::Master::setBits(uint8_t* dstData, uint32_t lsb, uint32_t size) {
     uint32_t dstByte;
     uint32_t rem;
     uint32_t bytes;
+    uint32_t num;
 
     dstByte = lsb / 8;
     dstBit  = lsb % 8;
     rem     = size;
 
-    do {
+    while (rem != 0) {
         bytes = rem / 8;
 
         // Aligned
@@ -366,12 +502,15 @@ void rim::Master::setBits(uint8_t* dstData, uint32_t lsb, uint32_t size) {
 
         // Not aligned
         else {
-            dstData[dstByte] |= (0x1 << dstBit);
-            dstByte += (++dstBit / 8);
+            num   = (rem > 56) ? 56 : rem;
+            bytes = (dstBit + num + 7) / 8;
+            storeWord(&(dstData[dstByte]), bytes, loadWord(&(dstData[dstByte]), bytes) | (lowMask(num) << dstBit));
+            dstBit += num;
+            dstByte += dstBit / 8;
             dstBit %= 8;
-            rem -= 1;
+            rem -= num;
         }
-    } while (rem != 0);
+    }
 }
 
 #ifndef NO_PYTHON
@@ -405,34 +544,21 @@ bool rim::Master::anyBits(uint8_t* dstData, uint32_t lsb, uint32_t size) {
     uint32_t dstBit;
     uint32_t dstByte;
     uint32_t rem;
-    uint32_t bytes;
-    bool ret;
+    uint32_t num;
 
     dstByte = lsb / 8;
     dstBit  = lsb % 8;
     rem     = size;
-    ret     = false;
 
-    do {
-        bytes = rem / 8;
-
-        // Aligned
-        if ((dstBit == 0) && (bytes > 0)) {
-            if (dstData[dstByte] != 0) ret = true;
-            dstByte += 1;
-            rem -= 8;
-        }
-
-        // Not aligned
-        else {
-            if ((dstData[dstByte] & (0x1 << dstBit)) != 0) ret = true;
-            dstByte += (++dstBit / 8);
-            dstBit %= 8;
-            rem -= 1;
-        }
-    } while (ret == false && rem != 0);
-
-    return ret;
+    while (rem != 0) {
+        num = (rem > 56) ? 56 : rem;
+        if ((loadWord(&(dstData[dstByte]), (dstBit + num + 7) / 8) & (lowMask(num) << dstBit)) != 0) return true;
+        dstBit += num;
+        dstByte += dstBit / 8;
+        dstBit %= 8;
+        rem -= num;
+    }
+    return false;
 }
 
 #ifndef NO_PYTHON
@@ -461,6 +587,24 @@ bool rim::Master::anyBitsPy(boost::python::object dst, uint32_t lsb, uint32_t si
     return ret;
 }
 
+#endif
+
+//! Gather the bits selected by mask from a window of up to 8 bytes
+void rim::Master::extractBits(uint8_t* dstData, uint32_t dstBytes, uint8_t* srcData, uint32_t srcBytes, uint64_t mask) {
+    static const BitsFunc func = selectExtract();
+    storeWord(dstData, dstBytes, func(loadWord(srcData, srcBytes), mask));
+}
+
+//! Scatter bits into the positions selected by mask in a window of up to 8 bytes
+void rim::Master::depositBits(uint8_t* dstData, uint32_t dstBytes, uint64_t mask, uint8_t* srcData, uint32_t srcBytes) {
+    static const BitsFunc func = selectDeposit();
+    storeWord(dstData,
+              dstBytes,
+              (loadWord(dstData, dstBytes) & ~mask) | (func(loadWord(srcData, srcBytes), mask) & mask));
+}
+
+#ifndef NO_PYTHON
+
 void rim::Master::rshiftPy(bp::object p) {
     rim::SlavePtr slv;
 
@@ -21,7 +21,10 @@
 
 #include "rogue/interfaces/memory/Slave.h"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -37,9 +40,16 @@ namespace bp = boost::python;
 
 namespace rim = rogue::interfaces::memory;
 
+// Initial and maximum slot table size
+static const uint32_t InitSlots = 1024;
+static const uint32_t MaxSlots  = 1048576;
+
 // Init class counter
 uint32_t rim::Slave::classIdx_ = 0;
 
+//! Number of completion latency histogram bins
+const uint32_t rim::Slave::LatencyBins;
+
 //! Class instance lock
 std::mutex rim::Slave::classMtx_;
 
@@ -61,6 +71,13 @@ rim::Slave::Slave(uint32_t min, uint32_t max) {
     classMtx_.unlock();
 
     name_ = std::string("Unnamed_") + std::to_string(id_);
+
+    slotMask_       = 0;
+    curTick_        = currentTick();
+    wheelCount_     = 0;
+    outstanding_    = 0;
+    maxOutstanding_ = 0;
+    latencyHist_.resize(LatencyBins, 0);
 }
 
 //! Destroy object
@@ -69,44 +86,209 @@ rim::Slave::~Slave() {}
 //! Stop the interface
 void rim::Slave::stop() {}
 
+//! Current wheel tick time
+uint64_t rim::Slave::currentTick() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+//! Ticks between timer refreshes of a transaction, an eighth of the timeout
+uint64_t rim::Slave::timerTicks(rim::TransactionPtr tran) {
+    uint64_t ticks = ((uint64_t)tran->timeout_.tv_sec * 1000 + tran->timeout_.tv_usec / 1000) / 8;
+    return (ticks == 0) ? 1 : ticks;
+}
+
+//! Double the slot table
+void rim::Slave::growSlots() {
+    std::vector<rim::Slave::Slot> old;
+
+    old.swap(slots_);
+    slots_.resize(old.size() * 2);
+    slotMask_ = slots_.size() - 1;
+
+    for (std::vector<rim::Slave::Slot>::iterator it = old.begin(); it != old.end(); ++it)
+        if (it->tran != NULL) slots_[it->id & slotMask_] = *it;
+}
+
+//! Remove a transaction from the slot table
+void rim::Slave::clearSlot(rim::Slave::Slot& slot) {
+    slot.tran.reset();
+    outstanding_--;
+}
+
+//! Schedule a timer refresh
+void rim::Slave::addTimer(uint32_t id, uint64_t due) {
+    uint64_t delta;
+
+    // The current tick has already been processed
+    delta = (due > curTick_) ? (due - curTick_) : 1;
+    if (delta > 65535) delta = 65535;
+    due = curTick_ + delta;
+
+    if (delta < 256)
+        wheel_[0][due & 0xFF].push_back({id, due});
+    else
+        wheel_[1][(due >> 8) & 0xFF].push_back({id, due});
+    wheelCount_++;
+}
+
+//! Refresh or expire the transaction of a timer which is due
+void rim::Slave::runTimer(uint32_t id, rim::TransactionPtr ref) {
+    rim::Slave::Slot& slot = slots_[id & slotMask_];
+
+    // Transaction has completed
+    if (slot.tran == NULL || slot.id != id) return;
+
+    if (slot.tran->expired())
+        clearSlot(slot);
+    else {
+        slot.tran->refreshTimer(ref);
+        addTimer(id, curTick_ + timerTicks(slot.tran));
+    }
+}
+
+//! Advance the timer wheel
+void rim::Slave::advanceTimers(uint64_t tick, rim::TransactionPtr ref) {
+    std::vector<rim::Slave::TimerEntry>& due = timerDue_;
+    std::vector<rim::Slave::TimerEntry>::iterator it;
+    uint32_t x;
+
+    if (wheelCount_ == 0) {
+        curTick_ = tick;
+        return;
+    }
+
+    // The whole wheel has passed, everything is due
+    if (tick - curTick_ > 65535) {
+        due.clear();
+        for (x = 0; x < 256; x++) {
+            due.insert(due.end(), wheel_[0][x].begin(), wheel_[0][x].end());
+            due.insert(due.end(), wheel_[1][x].begin(), wheel_[1][x].end());
+            wheel_[0][x].clear();
+            wheel_[1][x].clear();
+        }
+        wheelCount_ = 0;
+        curTick_    = tick;
+        for (it = due.begin(); it != due.end(); ++it) runTimer(it->id, ref);
+        return;
+    }
+
+    while (curTick_ < tick) {
+        curTick_++;
+
+        // Move the next block of the upper level into the lower level
+        if ((curTick_ & 0xFF) == 0) {
+            due.clear();
+            due.swap(wheel_[1][(curTick_ >> 8) & 0xFF]);
+            wheelCount_ -= due.size();
+            for (it = due.begin(); it != due.end(); ++it) addTimer(it->id, it->due);
+        }
+
+        due.clear();
+        due.swap(wheel_[0][curTick_ & 0xFF]);
+        wheelCount_ -= due.size();
+        for (it = due.begin(); it != due.end(); ++it) runTimer(it->id, ref);
+    }
+}
+
 //! Register a master.
 void rim::Slave::addTransaction(rim::TransactionPtr tran) {
+    uint32_t id;
+    uint64_t tick;
+
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(slaveMtx_);
-    tranMap_[tran->id()] = tran;
+
+    // Hubs and other pass through slaves never track transactions
+    if (slots_.empty()) {
+        slots_.resize(InitSlots);
+        slotMask_ = InitSlots - 1;
+        wheel_[0].resize(256);
+        wheel_[1].resize(256);
+    }
+
+    id   = tran->id();
+    tick = currentTick();
+    if (wheelCount_ == 0) curTick_ = tick;
+
+    // Grow the table while the slot is held by another live transaction
+    while (slots_[id & slotMask_].tran != NULL && slots_[id & slotMask_].id != id &&
+           !slots_[id & slotMask_].tran->expired() && slots_.size() < MaxSlots)
+        growSlots();
+
+    // Stale or replaced transactions are dropped
+    rim::Slave::Slot& slot = slots_[id & slotMask_];
+    if (slot.tran != NULL) clearSlot(slot);
+
+    slot.tran  = tran;
+    slot.id    = id;
+    slot.start = std::chrono::steady_clock::now();
+    if (++outstanding_ > maxOutstanding_) maxOutstanding_ = outstanding_;
+
+    addTimer(id, tick + timerTicks(tran));
 }
 
 //! Get transaction with index, called by sub classes
 rim::TransactionPtr rim::Slave::getTransaction(uint32_t index) {
     rim::TransactionPtr ret;
-    TransactionMap::iterator it;
-    TransactionMap::iterator exp;
+    uint64_t latency;
+    uint32_t bin;
 
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(slaveMtx_);
 
-    if ((it = tranMap_.find(index)) != tranMap_.end()) {
-        ret = it->second;
+    if (slots_.empty()) return ret;
+
+    rim::Slave::Slot& slot = slots_[index & slotMask_];
+
+    if (slot.tran != NULL && slot.id == index) {
+        ret = slot.tran;
+
+        // Update latency histogram
+        latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - slot.start).count();
+        bin = (latency < 2) ? 0 : (63 - __builtin_clzll(latency));
+        if (bin >= LatencyBins) bin = LatencyBins - 1;
+        latencyHist_[bin]++;
 
         // Remove from list
-        tranMap_.erase(it);
-
-        // Update any timers for transactions started after received transaction
-        exp = tranMap_.end();
-        for (it = tranMap_.begin(); it != tranMap_.end(); ++it) {
-            if (it->second->expired())
-                exp = it;
-            else
-                it->second->refreshTimer(ret);
-        }
+        clearSlot(slot);
 
-        // Clean up if we found an expired transaction, overtime this will clean up
-        // the list, even if it deletes one expired transaction per call
-        if (exp != tranMap_.end()) { tranMap_.erase(exp); }
+        // Update timers for transactions started after received transaction and clean up expired transactions
+        advanceTimers(currentTick(), ret);
     }
     return ret;
 }
 
+//! Get the number of outstanding transactions
+uint32_t rim::Slave::getOutstanding() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+    return outstanding_;
+}
+
+//! Get the peak number of outstanding transactions
+uint32_t rim::Slave::getMaxOutstanding() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+    return maxOutstanding_;
+}
+
+//! Get the completion latency histogram
+std::vector<uint64_t> rim::Slave::getLatencyHistogram() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+    return latencyHist_;
+}
+
+//! Reset the completion latency histogram and peak outstanding count
+void rim::Slave::resetStats() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+    std::fill(latencyHist_.begin(), latencyHist_.end(), 0);
+    maxOutstanding_ = outstanding_;
+}
+
 //! Get min size from slave
 uint32_t rim::Slave::min() {
     return min_;
@@ -168,6 +350,10 @@ void rim::Slave::setup_python() {
         .def("setName", &rim::Slave::setName)
         .def("_addTransaction", &rim::Slave::addTransaction)
         .def("_getTransaction", &rim::Slave::getTransaction)
+        .def("getOutstanding", &rim::Slave::getOutstanding)
+        .def("getMaxOutstanding", &rim::Slave::getMaxOutstanding)
+        .def("getLatencyHistogram", &rim::Slave::getLatencyHistogramPy)
+        .def("resetStats", &rim::Slave::resetStats)
         .def("_doMinAccess", &rim::Slave::doMinAccess, &rim::SlaveWrap::defDoMinAccess)
         .def("_doMaxAccess", &rim::Slave::doMaxAccess, &rim::SlaveWrap::defDoMaxAccess)
         .def("_doAddress", &rim::Slave::doAddress, &rim::SlaveWrap::defDoAddress)
@@ -259,6 +445,15 @@ void rim::SlaveWrap::defDoTransaction(rim::TransactionPtr transaction) {
     rim::Slave::doTransaction(transaction);
 }
 
+//! Get the completion latency histogram as a python list
+bp::object rim::Slave::getLatencyHistogramPy() {
+    std::vector<uint64_t> hist = getLatencyHistogram();
+    bp::list ret;
+
+    for (std::vector<uint64_t>::iterator it = hist.begin(); it != hist.end(); ++it) ret.append(*it);
+    return ret;
+}
+
 void rim::Slave::lshiftPy(boost::python::object p) {
     rim::MasterPtr mst;
 
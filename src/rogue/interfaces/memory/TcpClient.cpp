@@ -25,6 +25,7 @@
 #include <string.h>
 #include <zmq.h>
 
+#include <chrono>
 #include <cstring>
 #include <memory>
 
@@ -37,6 +38,9 @@
 
 namespace rim = rogue::interfaces::memory;
 
+// Outstanding send times which are tracked before the oldest are discarded
+static const uint32_t MaxSendTimes = 65536;
+
 #ifndef NO_PYTHON
 #include <boost/python.hpp>
 namespace bp = boost::python;
@@ -105,6 +109,11 @@ rim::TcpClient::TcpClient(std::string addr, uint16_t port) : rim::Slave(4, 0xFFF
                                           port,
                                           addr.c_str()));
 
+    maxInFlight_  = 0;
+    tranCount_    = 0;
+    latencyTotal_ = 0;
+    latencyMax_   = 0;
+
     // Start rx thread
     threadEn_     = true;
     this->thread_ = new std::thread(&rim::TcpClient::runThread, this);
@@ -193,9 +202,15 @@ void rim::TcpClient::doTransaction(rim::TransactionPtr tran) {
     // Add transaction
     if (type == rim::Post)
         tran->done();
-    else
+    else {
         addTransaction(tran);
 
+        // Responses which never arrive must not grow the table forever, ids increase with time
+        if (sendTime_.size() >= MaxSendTimes) sendTime_.erase(sendTime_.begin());
+        sendTime_[id] = std::chrono::steady_clock::now();
+        if (sendTime_.size() > maxInFlight_) maxInFlight_ = sendTime_.size();
+    }
+
     // Send message
     for (x = 0; x < msgCnt; x++) {
         if (zmq_sendmsg(this->zmqReq_, &(msg[x]), ((x == (msgCnt - 1) ? 0 : ZMQ_SNDMORE)) | ZMQ_DONTWAIT) < 0) {
@@ -218,6 +233,8 @@ void rim::TcpClient::runThread() {
     uint32_t size;
     uint32_t type;
     char result[1000];
+    uint64_t latency;
+    std::map<uint32_t, std::chrono::steady_clock::time_point>::iterator it;
 
     bridgeLog_->logThreadId();
 
@@ -260,6 +277,20 @@ void rim::TcpClient::runThread() {
             memset(result, 0, 1000);
             std::strncpy(result, (char*)zmq_msg_data(&(msg[5])), zmq_msg_size(&(msg[5])));
 
+            // Update statistics
+            {
+                std::lock_guard<std::mutex> block(bridgeMtx_);
+                if ((it = sendTime_.find(id)) != sendTime_.end()) {
+                    latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                                    it->second)
+                                  .count();
+                    sendTime_.erase(it);
+                    tranCount_++;
+                    latencyTotal_ += latency;
+                    if (latency > latencyMax_) latencyMax_ = latency;
+                }
+            }
+
             // Find Transaction
             if ((tran = getTransaction(id)) == NULL) {
                 bridgeLog_->warning("Failed to find transaction id=%" PRIu32, id);
@@ -313,13 +344,60 @@ void rim::TcpClient::runThread() {
     }
 }
 
+//! Get the number of transactions waiting for a response
+uint32_t rim::TcpClient::getInFlight() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> block(bridgeMtx_);
+    return sendTime_.size();
+}
+
+//! Get the peak number of transactions waiting for a response
+uint32_t rim::TcpClient::getMaxInFlight() {
+    return maxInFlight_;
+}
+
+//! Get the number of responses received
+uint64_t rim::TcpClient::getTransactionCount() {
+    return tranCount_;
+}
+
+//! Get the average round trip latency in seconds
+double rim::TcpClient::getLatencyAvg() {
+    uint64_t count = tranCount_;
+    return (count == 0) ? 0.0 : ((double)latencyTotal_ / (double)count) / 1.0e6;
+}
+
+//! Get the maximum round trip latency in seconds
+double rim::TcpClient::getLatencyMax() {
+    return (double)latencyMax_ / 1.0e6;
+}
+
+//! Reset the in-flight and latency statistics
+void rim::TcpClient::resetStats() {
+    rim::Slave::resetStats();
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> block(bridgeMtx_);
+    sendTime_.clear();
+    maxInFlight_  = 0;
+    tranCount_    = 0;
+    latencyTotal_ = 0;
+    latencyMax_   = 0;
+}
+
 void rim::TcpClient::setup_python() {
 #ifndef NO_PYTHON
 
     bp::class_<rim::TcpClient, rim::TcpClientPtr, bp::bases<rim::Slave>, boost::noncopyable>(
         "TcpClient",
         bp::init<std::string, uint16_t>())
-        .def("close", &rim::TcpClient::close);
+        .def("close", &rim::TcpClient::close)
+        .def("getInFlight", &rim::TcpClient::getInFlight)
+        .def("getMaxInFlight", &rim::TcpClient::getMaxInFlight)
+        .def("getTransactionCount", &rim::TcpClient::getTransactionCount)
+        .def("getLatencyAvg", &rim::TcpClient::getLatencyAvg)
+        .def("getLatencyMax", &rim::TcpClient::getLatencyMax)
+        .def("resetStats", &rim::TcpClient::resetStats);
 
     bp::implicitly_convertible<rim::TcpClientPtr, rim::SlavePtr>();
 #endif
@@ -25,8 +25,10 @@
 #include <string.h>
 #include <zmq.h>
 
+#include <chrono>
 #include <cstring>
 #include <memory>
+#include <string>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -40,6 +42,25 @@ namespace rim = rogue::interfaces::memory;
 namespace bp = boost::python;
 #endif
 
+// Default number of outstanding transactions
+static const uint32_t DefaultWindow = 16;
+
+//! Outstanding request, message parts are id, address, size, type, data and result
+struct rim::TcpServer::Request {
+    zmq_msg_t msg[6];
+    uint32_t tranId;
+    std::chrono::steady_clock::time_point start;
+
+    Request() {
+        for (uint32_t x = 0; x < 6; x++) zmq_msg_init(&(msg[x]));
+    }
+
+    // Parts which have been sent are empty
+    ~Request() {
+        for (uint32_t x = 0; x < 6; x++) zmq_msg_close(&(msg[x]));
+    }
+};
+
 //! Class creation
 rim::TcpServerPtr rim::TcpServer::create(std::string addr, uint16_t port) {
     rim::TcpServerPtr r = std::make_shared<rim::TcpServer>(addr, port);
@@ -100,6 +121,10 @@ rim::TcpServer::TcpServer(std::string addr, uint16_t port) {
                                           port,
                                           addr.c_str()));
 
+    window_   = 0;
+    inFlight_ = 0;
+    resetStats();
+
     // Start rx thread
     threadEn_     = true;
     this->thread_ = new std::thread(&rim::TcpServer::runThread, this);
@@ -108,6 +133,8 @@ rim::TcpServer::TcpServer(std::string addr, uint16_t port) {
 #ifndef __MACH__
     pthread_setname_np(thread_->native_handle(), "TcpServer");
 #endif
+
+    setWindow(DefaultWindow);
 }
 
 //! Destructor
@@ -120,41 +147,118 @@ void rim::TcpServer::close() {
 }
 
 void rim::TcpServer::stop() {
+    std::vector<std::thread*>::iterator it;
+
     if (threadEn_) {
         rogue::GilRelease noGil;
         threadEn_ = false;
+        windowCond_.notify_all();
         thread_->join();
+
+        // Outstanding requests are completed before the reply threads exit
+        for (it = replyThreads_.begin(); it != replyThreads_.end(); ++it) pending_.push(NULL);
+        for (it = replyThreads_.begin(); it != replyThreads_.end(); ++it) {
+            (*it)->join();
+            delete *it;
+        }
+        replyThreads_.clear();
+
         zmq_close(this->zmqResp_);
         zmq_close(this->zmqReq_);
         zmq_ctx_destroy(this->zmqCtx_);
     }
 }
 
+//! Set the number of transactions which can be outstanding at once
+void rim::TcpServer::setWindow(uint32_t window) {
+    std::thread* thread;
+
+    if (window == 0)
+        throw(rogue::GeneralError("memory::TcpServer::setWindow", "Window size must be at least 1"));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(windowMtx_);
+
+    // Reply threads are added as needed and kept when the window is reduced
+    while (threadEn_ && replyThreads_.size() < window) {
+        thread = new std::thread(&rim::TcpServer::runReply, this);
+        replyThreads_.push_back(thread);
+
+        // Set a thread name
+#ifndef __MACH__
+        pthread_setname_np(thread->native_handle(), "TcpServerReply");
+#endif
+    }
+
+    window_ = window;
+    windowCond_.notify_all();
+}
+
+//! Get the number of transactions which can be outstanding at once
+uint32_t rim::TcpServer::getWindow() {
+    return window_;
+}
+
+//! Get the number of outstanding transactions
+uint32_t rim::TcpServer::getInFlight() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(windowMtx_);
+    return inFlight_;
+}
+
+//! Get the peak number of outstanding transactions
+uint32_t rim::TcpServer::getMaxInFlight() {
+    return maxInFlight_;
+}
+
+//! Get the number of completed transactions
+uint64_t rim::TcpServer::getTransactionCount() {
+    return tranCount_;
+}
+
+//! Get average transaction latency in seconds
+double rim::TcpServer::getLatencyAvg() {
+    uint64_t count = tranCount_;
+    return (count == 0) ? 0.0 : ((double)latencyTotal_ / (double)count) / 1.0e6;
+}
+
+//! Get maximum transaction latency in seconds
+double rim::TcpServer::getLatencyMax() {
+    return (double)latencyMax_ / 1.0e6;
+}
+
+//! Reset statistics
+void rim::TcpServer::resetStats() {
+    maxInFlight_  = 0;
+    tranCount_    = 0;
+    latencyTotal_ = 0;
+    latencyMax_   = 0;
+}
+
 //! Run thread
 void rim::TcpServer::runThread() {
+    std::shared_ptr<rim::TcpServer::Request> req;
     uint8_t* data;
     uint64_t more;
     size_t moreSize;
     uint32_t x;
     uint32_t msgCnt;
-    zmq_msg_t msg[6];
     uint32_t id;
     uint64_t addr;
     uint32_t size;
     uint32_t type;
-    std::string result;
 
     bridgeLog_->logThreadId();
 
     while (threadEn_) {
-        for (x = 0; x < 6; x++) zmq_msg_init(&(msg[x]));
+        req    = std::make_shared<rim::TcpServer::Request>();
         msgCnt = 0;
         x      = 0;
 
         // Get message
         do {
             // Get the message
-            if (zmq_recvmsg(this->zmqReq_, &(msg[x]), 0) > 0) {
+            if (zmq_recvmsg(this->zmqReq_, &(req->msg[x]), 0) > 0) {
                 if (x != 4) x++;
                 msgCnt++;
 
@@ -169,31 +273,39 @@ void rim::TcpServer::runThread() {
         // Proper message received
         if (threadEn_ && (msgCnt == 4 || msgCnt == 5)) {
             // Check sizes
-            if ((zmq_msg_size(&(msg[0])) != 4) || (zmq_msg_size(&(msg[1])) != 8) || (zmq_msg_size(&(msg[2])) != 4) ||
-                (zmq_msg_size(&(msg[3])) != 4)) {
+            if ((zmq_msg_size(&(req->msg[0])) != 4) || (zmq_msg_size(&(req->msg[1])) != 8) ||
+                (zmq_msg_size(&(req->msg[2])) != 4) || (zmq_msg_size(&(req->msg[3])) != 4)) {
                 bridgeLog_->warning("Bad message sizes");
-                for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
                 continue;  // while (1)
             }
 
             // Get return fields
-            std::memcpy(&id, zmq_msg_data(&(msg[0])), 4);
-            std::memcpy(&addr, zmq_msg_data(&(msg[1])), 8);
-            std::memcpy(&size, zmq_msg_data(&(msg[2])), 4);
-            std::memcpy(&type, zmq_msg_data(&(msg[3])), 4);
+            std::memcpy(&id, zmq_msg_data(&(req->msg[0])), 4);
+            std::memcpy(&addr, zmq_msg_data(&(req->msg[1])), 8);
+            std::memcpy(&size, zmq_msg_data(&(req->msg[2])), 4);
+            std::memcpy(&type, zmq_msg_data(&(req->msg[3])), 4);
 
             // Write data is expected
             if ((type == rim::Write) || (type == rim::Post)) {
-                if ((msgCnt != 5) || (zmq_msg_size(&(msg[4])) != size)) {
+                if ((msgCnt != 5) || (zmq_msg_size(&(req->msg[4])) != size)) {
                     bridgeLog_->warning("Transaction write data error. Id=%" PRIu32, id);
-                    for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
                     continue;  // while (1)
                 }
-            } else
-                zmq_msg_init_size(&(msg[4]), size);
+            } else {
+                zmq_msg_close(&(req->msg[4]));
+                zmq_msg_init_size(&(req->msg[4]), size);
+            }
 
             // Data pointer
-            data = (uint8_t*)zmq_msg_data(&(msg[4]));
+            data = (uint8_t*)zmq_msg_data(&(req->msg[4]));
+
+            // Wait for a free slot in the window
+            {
+                std::unique_lock<std::mutex> lock(windowMtx_);
+                while (threadEn_ && inFlight_ >= window_) windowCond_.wait_for(lock, std::chrono::milliseconds(100));
+                if (!threadEn_) break;
+                if (++inFlight_ > maxInFlight_) maxInFlight_ = inFlight_;
+            }
 
             bridgeLog_->debug("Starting transaction id=%" PRIu32 ", addr=0x%" PRIx64 ", size=%" PRIu32
                               ", type=%" PRIu32,
@@ -202,29 +314,55 @@ void rim::TcpServer::runThread() {
                               size,
                               type);
 
-            // Execute transaction and wait for result
-            this->clearError();
-            reqTransaction(addr, size, data, type);
-            waitTransaction(0);
-            result = getError();
+            // Start transaction in request order, the reply is sent by a reply thread
+            req->start  = std::chrono::steady_clock::now();
+            req->tranId = reqTransaction(addr, size, data, type);
+            pending_.push(req);
+        }
+    }
+}
 
-            bridgeLog_->debug("Done transaction id=%" PRIu32 ", addr=0x%" PRIx64 ", size=%" PRIu32 ", type=%" PRIu32
-                              ", result=(%s)",
-                              id,
-                              addr,
-                              size,
-                              type,
-                              result.c_str());
-
-            // Result message, at least one char needs to be sent
-            if (result.length() == 0) result = "OK";
-            zmq_msg_init_size(&(msg[5]), result.length());
-            std::memcpy(zmq_msg_data(&(msg[5])), result.c_str(), result.length());
-
-            // Send message
-            for (x = 0; x < 6; x++) zmq_sendmsg(this->zmqResp_, &(msg[x]), (x == 5) ? 0 : ZMQ_SNDMORE);
-        } else
-            for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
+//! Reply thread
+void rim::TcpServer::runReply() {
+    std::shared_ptr<rim::TcpServer::Request> req;
+    std::string result;
+    uint64_t latency;
+    uint32_t id;
+    uint32_t x;
+
+    bridgeLog_->logThreadId();
+
+    while ((req = pending_.pop()) != NULL) {
+        result = waitTransactionResult(req->tranId);
+
+        latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - req->start)
+                      .count();
+
+        std::memcpy(&id, zmq_msg_data(&(req->msg[0])), 4);
+        bridgeLog_->debug("Done transaction id=%" PRIu32 ", result=(%s)", id, result.c_str());
+
+        // Result message, at least one char needs to be sent
+        if (result.length() == 0) result = "OK";
+        zmq_msg_init_size(&(req->msg[5]), result.length());
+        std::memcpy(zmq_msg_data(&(req->msg[5])), result.c_str(), result.length());
+
+        // Statistics are updated before the client can see the response
+        tranCount_++;
+        latencyTotal_ += latency;
+        if (latency > latencyMax_) latencyMax_ = latency;
+
+        {
+            std::lock_guard<std::mutex> lock(windowMtx_);
+            inFlight_--;
+        }
+        windowCond_.notify_all();
+
+        // Send message
+        {
+            std::lock_guard<std::mutex> lock(respMtx_);
+            for (x = 0; x < 6; x++) zmq_sendmsg(this->zmqResp_, &(req->msg[x]), (x == 5) ? 0 : ZMQ_SNDMORE);
+        }
+        req.reset();
     }
 }
 
@@ -234,7 +372,15 @@ void rim::TcpServer::setup_python() {
     bp::class_<rim::TcpServer, rim::TcpServerPtr, bp::bases<rim::Master>, boost::noncopyable>(
         "TcpServer",
         bp::init<std::string, uint16_t>())
-        .def("close", &rim::TcpServer::close);
+        .def("close", &rim::TcpServer::close)
+        .def("setWindow", &rim::TcpServer::setWindow)
+        .def("getWindow", &rim::TcpServer::getWindow)
+        .def("getInFlight", &rim::TcpServer::getInFlight)
+        .def("getMaxInFlight", &rim::TcpServer::getMaxInFlight)
+        .def("getTransactionCount", &rim::TcpServer::getTransactionCount)
+        .def("getLatencyAvg", &rim::TcpServer::getLatencyAvg)
+        .def("getLatencyMax", &rim::TcpServer::getLatencyMax)
+        .def("resetStats", &rim::TcpServer::resetStats);
 
     bp::implicitly_convertible<rim::TcpServerPtr, rim::MasterPtr>();
 #endif
@@ -44,14 +44,12 @@ namespace bp = boost::python;
 #endif
 
 // Init class counter
-uint32_t rim::Transaction::classIdx_ = 0;
-
-//! Class instance lock
-std::mutex rim::Transaction::classMtx_;
+std::atomic<uint32_t> rim::Transaction::classIdx_(1);
 
 //! Create a master container
 rim::TransactionPtr rim::Transaction::create(struct timeval timeout) {
-    rim::TransactionPtr m = std::make_shared<rim::Transaction>(timeout);
+    rim::TransactionPtr m =
+        std::allocate_shared<rim::Transaction>(rogue::CacheAllocator<rim::Transaction>(), timeout);
     return (m);
 }
 
@@ -92,13 +90,13 @@ rim::Transaction::Transaction(struct timeval timeout) : timeout_(timeout) {
     isSubTransaction_            = false;
     doneCreatingSubTransactions_ = false;
 
-    log_ = rogue::Logging::create("memory.Transaction", true);
+    // Logger is shared by all transactions and follows later level changes
+    static std::shared_ptr<rogue::Logging> log = rogue::Logging::create("memory.Transaction", true);
+    log_                                       = log;
+    log_->refreshLevel();
 
-    classMtx_.lock();
-    if (classIdx_ == 0) classIdx_ = 1;
-    id_ = classIdx_;
-    classIdx_++;
-    classMtx_.unlock();
+    // Zero is not a valid id
+    while ((id_ = classIdx_.fetch_add(1)) == 0) {}
 }
 
 //! Destroy object
@@ -139,7 +137,7 @@ uint32_t rim::Transaction::type() {
 //! Create a subtransaction
 rim::TransactionPtr rim::Transaction::createSubTransaction() {
     // Create a new transaction and set up pointers back and forth
-    rim::TransactionPtr subTran = std::make_shared<rim::Transaction>(timeout_);
+    rim::TransactionPtr subTran = create(timeout_);
     subTran->parentTransaction_ = shared_from_this();
     subTran->isSubTransaction_  = true;
     subTranMap_[subTran->id()]  = subTran;
@@ -23,6 +23,7 @@
 
 #include <memory>
 
+#include "rogue/CacheAllocator.h"
 #include "rogue/GilRelease.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
@@ -35,7 +36,8 @@ namespace bp = boost::python;
 
 //! Create a container
 rim::TransactionLockPtr rim::TransactionLock::create(rim::TransactionPtr tran) {
-    rim::TransactionLockPtr tranLock = std::make_shared<rim::TransactionLock>(tran);
+    rim::TransactionLockPtr tranLock =
+        std::allocate_shared<rim::TransactionLock>(rogue::CacheAllocator<rim::TransactionLock>(), tran);
     return (tranLock);
 }
 
@@ -115,6 +115,7 @@ void rim::Variable::setup_python() {
         .def("_bitSize", &rim::VariableWrap::bitSize)
         .def("_get", &rim::VariableWrap::get)
         .def("_set", &rim::VariableWrap::set)
+        .def("_getArray", &rim::VariableWrap::getArray)
         .def("_rateTest", &rim::VariableWrap::rateTest)
         .def("_queueUpdate", &rim::Variable::queueUpdate, &rim::VariableWrap::defQueueUpdate)
         .def("_setLogLevel", &rim::Variable::setLogLevel)
@@ -229,6 +230,9 @@ rim::Variable::Variable(std::string name,
         }
     }
 
+    // Extract and insert plan for other standard variables
+    buildBitPlan();
+
     // Custom data is NULL for now
     customData_ = NULL;
 
@@ -494,6 +498,42 @@ void rim::Variable::shiftOffsetDown(uint32_t shift, uint32_t minSize) {
             for (x = 0; x < numValues_; x++) fastByte_[x] = (bitOffset_[0] + (valueStride_ * x)) / 8;
         }
     }
+
+    // Adjust bit plan
+    buildBitPlan();
+}
+
+// Compute the bit plan from the bit offsets and sizes
+void rim::Variable::buildBitPlan() {
+    uint32_t base;
+    uint32_t x;
+
+    bitPlanEn_    = false;
+    bitPlanByte_  = 0;
+    bitPlanBytes_ = 0;
+    bitPlanMask_  = 0;
+
+    // Only for standard variables which can not use a fast copy and fit in a word
+    if (fastByte_ != NULL || numValues_ != 0 || bitTotal_ > 64) return;
+
+    // Fields must be in ascending order without overlap so that they pack in order
+    for (x = 1; x < bitOffset_.size(); x++)
+        if (bitOffset_[x] < (bitOffset_[x - 1] + bitSize_[x - 1])) return;
+
+    // All fields must be within one 64-bit window
+    base = bitOffset_[0] / 8;
+    if ((bitOffset_[bitOffset_.size() - 1] + bitSize_[bitSize_.size() - 1] + 7) / 8 - base > 8) return;
+
+    for (x = 0; x < bitOffset_.size(); x++) {
+        if (bitSize_[x] == 64)
+            bitPlanMask_ = 0xFFFFFFFFFFFFFFFFULL;
+        else
+            bitPlanMask_ |= ((1ULL << bitSize_[x]) - 1) << (bitOffset_[x] - base * 8);
+    }
+
+    bitPlanEn_    = true;
+    bitPlanByte_  = base;
+    bitPlanBytes_ = (bitOffset_[bitOffset_.size() - 1] + bitSize_[bitSize_.size() - 1] + 7) / 8 - base;
 }
 
 void rim::Variable::updatePath(std::string path) {
@@ -589,6 +629,11 @@ bp::object rim::VariableWrap::get(int32_t index) {
     return (block_->*getFuncPy_)(this, index);
 }
 
+//! Get a range of values from a list RemoteVariable
+bp::object rim::VariableWrap::getArray(int32_t index, int32_t count) {
+    return block_->getArrayPy(this, index, count);
+}
+
 // Set data using python function
 bp::object rim::VariableWrap::toBytes(bp::object& value) {
     return model_.attr("toBytes")(value);
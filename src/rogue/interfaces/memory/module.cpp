@@ -25,6 +25,7 @@
 #include <boost/python.hpp>
 
 #include "rogue/interfaces/memory/Block.h"
+#include "rogue/interfaces/memory/BlockBatch.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Emulate.h"
 #include "rogue/interfaces/memory/Hub.h"
@@ -75,6 +76,7 @@ void rim::setup_module() {
     rim::TcpClient::setup_python();
     rim::TcpServer::setup_python();
     rim::Block::setup_python();
+    rim::BlockBatch::setup_python();
     rim::Variable::setup_python();
     rim::Emulate::setup_python();
 }
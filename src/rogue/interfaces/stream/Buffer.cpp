@@ -27,6 +27,7 @@
 
 #include <memory>
 
+#include "rogue/CacheAllocator.h"
 #include "rogue/GeneralError.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/Pool.h"
@@ -38,7 +39,8 @@ namespace ris = rogue::interfaces::stream;
  * Pass owner, raw data buffer, and meta data
  */
 ris::BufferPtr ris::Buffer::create(ris::PoolPtr source, void* data, uint32_t meta, uint32_t size, uint32_t alloc) {
-    ris::BufferPtr buff = std::make_shared<ris::Buffer>(source, data, meta, size, alloc);
+    ris::BufferPtr buff =
+        std::allocate_shared<ris::Buffer>(rogue::CacheAllocator<ris::Buffer>(), source, data, meta, size, alloc);
     return (buff);
 }
 
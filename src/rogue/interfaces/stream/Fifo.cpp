@@ -22,11 +22,18 @@
 
 #include "rogue/interfaces/stream/Fifo.h"
 
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdint.h>
 
 #include <memory>
+#include <exception>
+#include <mutex>
+#include <string>
 #include <thread>
 
+#include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
 #include "rogue/interfaces/stream/Buffer.h"
@@ -43,9 +50,18 @@ namespace ris = rogue::interfaces::stream;
 namespace bp = boost::python;
 #endif
 
+const uint32_t ris::Fifo::DropNew;
+const uint32_t ris::Fifo::DropOldest;
+const uint32_t ris::Fifo::Block;
+
 //! Class creation
-ris::FifoPtr ris::Fifo::create(uint32_t maxDepth, uint32_t trimSize, bool noCopy) {
-    ris::FifoPtr p = std::make_shared<ris::Fifo>(maxDepth, trimSize, noCopy);
+ris::FifoPtr ris::Fifo::create(uint32_t maxDepth,
+                               uint32_t trimSize,
+                               bool noCopy,
+                               bool lockFree,
+                               uint32_t workers,
+                               bool ordered) {
+    ris::FifoPtr p = std::make_shared<ris::Fifo>(maxDepth, trimSize, noCopy, lockFree, workers, ordered);
     return (p);
 }
 
@@ -54,44 +70,78 @@ void ris::Fifo::setup_python() {
 #ifndef NO_PYTHON
     bp::class_<ris::Fifo, ris::FifoPtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>(
         "Fifo",
-        bp::init<uint32_t, uint32_t, bool>())
+        bp::init<uint32_t, uint32_t, bool, bp::optional<bool, uint32_t, bool>>())
         .def("size", &Fifo::size)
         .def("dropCnt", &Fifo::dropCnt)
-        .def("clearCnt", &Fifo::clearCnt);
+        .def("clearCnt", &Fifo::clearCnt)
+        .def("setDropPolicy", &Fifo::setDropPolicy)
+        .def("getDropPolicy", &Fifo::getDropPolicy)
+        .def("getWorkers", &Fifo::getWorkers)
+        .def("setWorkerAffinity", &Fifo::setWorkerAffinity)
+        .def_readonly("DropNew", &Fifo::DropNew)
+        .def_readonly("DropOldest", &Fifo::DropOldest)
+        .def_readonly("Block", &Fifo::Block);
 #endif
 }
 
 //! Creator with version constant
-ris::Fifo::Fifo(uint32_t maxDepth, uint32_t trimSize, bool noCopy)
+ris::Fifo::Fifo(uint32_t maxDepth, uint32_t trimSize, bool noCopy, bool lockFree, uint32_t workers, bool ordered)
     : ris::Master(),
       ris::Slave(),
       log_(rogue::Logging::create("stream.Fifo")),
       maxDepth_(maxDepth),
       trimSize_(trimSize),
       noCopy_(noCopy),
+      ordered_(ordered),
+      dropPolicy_(DropNew),
       dropFrameCnt_(0),
+      ring_(lockFree ? new rogue::RingQueue<ris::FramePtr>(maxDepth == 0 ? rogue::RingQueue<ris::FramePtr>::DefaultCapacity
+                                                                         : maxDepth * 2)
+                     : NULL),
       threadEn_(true),
-      thread_(new std::thread(&ris::Fifo::runThread, this)) {
+      popSeq_(0) {
+    std::thread* thread;
+    uint32_t x;
+
     queue_.setThold(maxDepth);
+    if (ring_) ring_->setThold(maxDepth);
+
+    if (workers == 0) workers = 1;
 
-    // Set a thread name
+    for (x = 0; x < workers; x++) {
+        thread = new std::thread(&ris::Fifo::runThread, this);
+        threads_.push_back(thread);
+
+        // Set a thread name
 #ifndef __MACH__
-    pthread_setname_np(thread_->native_handle(), "Fifo");
+        pthread_setname_np(thread->native_handle(), (workers == 1) ? "Fifo" : ("Fifo" + std::to_string(x)).c_str());
 #endif
+    }
 }
 
 //! Deconstructor
 ris::Fifo::~Fifo() {
+    std::vector<std::thread*>::iterator it;
+
     threadEn_ = false;
     rogue::GilRelease noGil;
     queue_.stop();
-    thread_->join();
-    delete thread_;
+    if (ring_) ring_->stop();
+
+    {
+        std::lock_guard<std::mutex> lock(orderMtx_);
+        orderCond_.notify_all();
+    }
+
+    for (it = threads_.begin(); it != threads_.end(); ++it) {
+        (*it)->join();
+        delete *it;
+    }
 }
 
 //! Return the number of elements in the Fifo
 std::size_t ris::Fifo::size() {
-    return queue_.size();
+    return ring_ ? ring_->size() : queue_.size();
 };
 
 //! Return the number of dropped frames
@@ -104,6 +154,58 @@ void ris::Fifo::clearCnt() {
     dropFrameCnt_ = 0;
 }
 
+//! Set drop policy
+void ris::Fifo::setDropPolicy(uint32_t policy) {
+    if (policy > Block)
+        throw(rogue::GeneralError::create("stream::Fifo::setDropPolicy", "Invalid drop policy %" PRIu32, policy));
+
+    dropPolicy_ = policy;
+
+    // Queue blocks the Master once the depth is reached
+    queue_.setMax((policy == Block) ? maxDepth_ : 0);
+    if (ring_) ring_->setMax((policy == Block) ? maxDepth_ : 0);
+}
+
+//! Get drop policy
+uint32_t ris::Fifo::getDropPolicy() {
+    return dropPolicy_;
+}
+
+//! Get number of worker threads
+uint32_t ris::Fifo::getWorkers() {
+    return threads_.size();
+}
+
+//! Set CPU affinity of a worker thread
+void ris::Fifo::setWorkerAffinity(uint32_t index, int32_t cpu) {
+    if (index >= threads_.size())
+        throw(rogue::GeneralError::create("stream::Fifo::setWorkerAffinity",
+                                          "Invalid worker index %" PRIu32 ", worker count is %" PRIu32,
+                                          index,
+                                          (uint32_t)threads_.size()));
+
+#ifndef __MACH__
+    cpu_set_t set;
+    uint32_t x;
+
+    CPU_ZERO(&set);
+
+    if (cpu < 0) {
+        for (x = 0; x < CPU_SETSIZE; x++) CPU_SET(x, &set);
+    } else {
+        CPU_SET(cpu, &set);
+    }
+
+    if (pthread_setaffinity_np(threads_[index]->native_handle(), sizeof(cpu_set_t), &set) != 0)
+        throw(rogue::GeneralError::create("stream::Fifo::setWorkerAffinity",
+                                          "Failed to set worker %" PRIu32 " affinity to cpu %" PRIi32,
+                                          index,
+                                          cpu));
+#else
+    log_->warning("Worker affinity is not supported on this platform");
+#endif
+}
+
 //! Accept a frame from master
 void ris::Fifo::acceptFrame(ris::FramePtr frame) {
     uint32_t size;
@@ -111,10 +213,15 @@ void ris::Fifo::acceptFrame(ris::FramePtr frame) {
     ris::FrameIterator src;
     ris::FrameIterator dst;
 
-    // FIFO is full, drop frame
-    if (queue_.busy()) {
-        ++dropFrameCnt_;
-        return;
+    // FIFO is full, drop a frame unless the Master is to be blocked
+    if (ring_ ? ring_->busy() : queue_.busy()) {
+        if (dropPolicy_ == DropNew) {
+            ++dropFrameCnt_;
+            return;
+        } else if (dropPolicy_ == DropOldest) {
+            if (ring_ ? ring_->tryPop(nFrame) : queue_.tryPop(nFrame)) ++dropFrameCnt_;
+            nFrame.reset();
+        }
     }
 
     rogue::GilRelease noGil;
@@ -144,15 +251,102 @@ void ris::Fifo::acceptFrame(ris::FramePtr frame) {
     }
 
     // Append to buffer
-    queue_.push(nFrame);
+    if (ring_)
+        ring_->push(nFrame);
+    else
+        queue_.push(nFrame);
+}
+
+//! Get the next frame from the queue
+ris::FramePtr ris::Fifo::pop() {
+    return ring_ ? ring_->pop() : queue_.pop();
 }
 
 //! Thread background
 void ris::Fifo::runThread() {
     ris::FramePtr frame;
+    uint64_t seq = 0;
     log_->logThreadId();
 
     while (threadEn_) {
-        if ((frame = queue_.pop()) != NULL) sendFrame(frame);
+        // Sequence numbers are assigned in queue order
+        if (ordered_) {
+            std::lock_guard<std::mutex> lock(popMtx_);
+            if ((frame = pop()) != NULL) {
+                seq = popSeq_++;
+
+                std::lock_guard<std::mutex> oLock(orderMtx_);
+                inFlight_.insert(seq);
+            }
+        } else {
+            frame = pop();
+        }
+
+        if (frame == NULL) continue;
+
+        if (ordered_)
+            sendOrdered(frame, seq);
+        else
+            sendFrame(frame);
+
+        frame.reset();
     }
 }
+
+//! Pass a frame to each slave in sequence order
+void ris::Fifo::sendOrdered(ris::FramePtr frame, uint64_t seq) {
+    std::vector<ris::SlavePtr> slaves;
+    uint32_t x;
+
+    slaves = getSlaves();
+
+    // Same order as sendFrame(), primary slave last
+    for (x = slaves.size(); x > 0; x--) {
+        {
+            std::unique_lock<std::mutex> lock(orderMtx_);
+
+            // Slaves attached later start at the oldest frame still in flight
+            if (slaveSeq_.size() < x) slaveSeq_.resize(x, *inFlight_.begin());
+
+            while (threadEn_ && slaveSeq_[x - 1] < seq) orderCond_.wait(lock);
+        }
+
+        // A failed slave drops the frame for it and the remaining slaves, the
+        // sequence still advances so the other workers do not wait forever
+        try {
+            slaves[x - 1]->acceptFrame(frame);
+        } catch (std::exception& e) {
+            log_->error("Slave failed to accept frame %" PRIu64 ": %s", seq, e.what());
+            break;
+        } catch (...) {
+            log_->error("Slave failed to accept frame %" PRIu64, seq);
+            break;
+        }
+        advanceSeq(x - 1, seq);
+    }
+
+    // Release the failed slave and every slave after it, in turn
+    for (; x > 0; x--) {
+        {
+            std::unique_lock<std::mutex> lock(orderMtx_);
+            while (threadEn_ && slaveSeq_[x - 1] < seq) orderCond_.wait(lock);
+        }
+        advanceSeq(x - 1, seq);
+    }
+
+    // Release slaves attached after the slave list was read for this frame
+    std::unique_lock<std::mutex> lock(orderMtx_);
+    for (x = slaves.size(); x < slaveSeq_.size(); x++) {
+        while (threadEn_ && slaveSeq_[x] < seq) orderCond_.wait(lock);
+        if (slaveSeq_[x] <= seq) slaveSeq_[x] = seq + 1;
+    }
+    inFlight_.erase(seq);
+    orderCond_.notify_all();
+}
+
+//! Mark a frame as passed to a slave and wake the waiting workers
+void ris::Fifo::advanceSeq(uint32_t slave, uint64_t seq) {
+    std::lock_guard<std::mutex> lock(orderMtx_);
+    if (slaveSeq_[slave] <= seq) slaveSeq_[slave] = seq + 1;
+    orderCond_.notify_all();
+}
@@ -26,6 +26,7 @@
 
 #include <memory>
 
+#include "rogue/CacheAllocator.h"
 #include "rogue/GeneralError.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
@@ -43,7 +44,7 @@ namespace bp = boost::python;
 
 //! Create an empty frame
 ris::FramePtr ris::Frame::create() {
-    ris::FramePtr frame = std::make_shared<ris::Frame>();
+    ris::FramePtr frame = std::allocate_shared<ris::Frame>(rogue::CacheAllocator<ris::Frame>());
     return (frame);
 }
 
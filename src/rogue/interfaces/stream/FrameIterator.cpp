@@ -19,9 +19,18 @@
  **/
 #include "rogue/interfaces/stream/FrameIterator.h"
 
+#include <stdint.h>
+
+#include <cstring>
+
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define ROGUE_BULK_COPY_X86
+#endif
+
 namespace ris = rogue::interfaces::stream;
 
 ris::FrameIterator::FrameIterator(ris::FramePtr frame, bool write, bool end) {
@@ -263,3 +272,87 @@ ris::FrameIterator& ris::FrameIterator::operator-=(const int32_t sub) {
         this->increment(-1 * sub);
     return *this;
 }
+
+namespace {
+
+#ifdef ROGUE_BULK_COPY_X86
+// Copy until the destination is aligned to the vector size
+inline void alignDest(uint8_t*& dst, const uint8_t*& src, uint32_t& size, uint32_t align) {
+    uint32_t head = (align - ((uintptr_t)dst & (align - 1))) & (align - 1);
+
+    if (head > size) head = size;
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    size -= head;
+}
+
+__attribute__((target("avx512f"))) void copyAvx512(void* dst, const void* src, uint32_t size) {
+    uint8_t* d       = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+
+    alignDest(d, s, size, 64);
+
+    while (size >= 256) {
+        __m512i v0 = _mm512_loadu_si512((const void*)(s));
+        __m512i v1 = _mm512_loadu_si512((const void*)(s + 64));
+        __m512i v2 = _mm512_loadu_si512((const void*)(s + 128));
+        __m512i v3 = _mm512_loadu_si512((const void*)(s + 192));
+        _mm512_stream_si512((__m512i*)(d), v0);
+        _mm512_stream_si512((__m512i*)(d + 64), v1);
+        _mm512_stream_si512((__m512i*)(d + 128), v2);
+        _mm512_stream_si512((__m512i*)(d + 192), v3);
+        d += 256;
+        s += 256;
+        size -= 256;
+    }
+    _mm_sfence();
+    std::memcpy(d, s, size);
+}
+
+__attribute__((target("avx2"))) void copyAvx2(void* dst, const void* src, uint32_t size) {
+    uint8_t* d       = reinterpret_cast<uint8_t*>(dst);
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+
+    alignDest(d, s, size, 32);
+
+    while (size >= 128) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i*)(s));
+        __m256i v1 = _mm256_loadu_si256((const __m256i*)(s + 32));
+        __m256i v2 = _mm256_loadu_si256((const __m256i*)(s + 64));
+        __m256i v3 = _mm256_loadu_si256((const __m256i*)(s + 96));
+        _mm256_stream_si256((__m256i*)(d), v0);
+        _mm256_stream_si256((__m256i*)(d + 32), v1);
+        _mm256_stream_si256((__m256i*)(d + 64), v2);
+        _mm256_stream_si256((__m256i*)(d + 96), v3);
+        d += 128;
+        s += 128;
+        size -= 128;
+    }
+    _mm_sfence();
+    std::memcpy(d, s, size);
+}
+#endif
+
+void copyDefault(void* dst, const void* src, uint32_t size) {
+    std::memcpy(dst, src, size);
+}
+
+typedef void (*CopyFunc)(void*, const void*, uint32_t);
+
+// Select the copy routine for the running CPU
+CopyFunc selectCopy() {
+#ifdef ROGUE_BULK_COPY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return copyAvx512;
+    if (__builtin_cpu_supports("avx2")) return copyAvx2;
+#endif
+    return copyDefault;
+}
+}  // namespace
+
+//! Copy a large block of memory
+void ris::bulkCopy(void* dst, const void* src, uint32_t size) {
+    static const CopyFunc func = selectCopy();
+    func(dst, src, size);
+}
@@ -57,6 +57,13 @@ uint32_t ris::Master::slaveCount() {
     return slaves_.size();
 }
 
+//! Get a copy of the slave list
+std::vector<ris::SlavePtr> ris::Master::getSlaves() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+    return slaves_;
+}
+
 //! Add slave
 void ris::Master::addSlave(ris::SlavePtr slave) {
     rogue::GilRelease noGil;
@@ -24,10 +24,14 @@
 #include "rogue/interfaces/stream/Pool.h"
 
 #include <inttypes.h>
+#include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -41,6 +45,105 @@ namespace ris = rogue::interfaces::stream;
 namespace bp = boost::python;
 #endif
 
+namespace {
+
+// Number of pools cached per thread and buffers cached per pool
+const uint32_t PoolCacheEntries = 8;
+const uint32_t PoolMagazineSize = 16;
+
+// Source of unique free list ids, 0 marks an unused cache entry
+std::atomic<uint64_t> poolDepotId(1);
+
+struct PoolCache;
+
+// All thread caches, so a free list can be flushed from every thread when it is retired.
+// Never destroyed since threads may exit after static destruction.
+struct PoolCacheList {
+    std::mutex mtx;
+    std::vector<PoolCache*> caches;
+};
+
+PoolCacheList& poolCacheList() {
+    static PoolCacheList* list = new PoolCacheList();
+    return *list;
+}
+
+// Per thread buffer cache, entries are looked up by free list id. The mutex is
+// only contended when a free list is being retired by another thread.
+struct PoolCache {
+    struct Entry {
+        uint64_t id;
+        uint32_t count;
+        uint8_t* data[PoolMagazineSize];
+    };
+
+    bool valid;
+    std::mutex mtx;
+    Entry entries[PoolCacheEntries];
+    uint32_t victim;
+
+    PoolCache() : valid(true), victim(0) {
+        memset(entries, 0, sizeof(entries));
+
+        PoolCacheList& list = poolCacheList();
+        std::lock_guard<std::mutex> lock(list.mtx);
+        list.caches.push_back(this);
+    }
+
+    // The owning pool may no longer exist, cached buffers go back to the heap
+    static void flush(Entry& entry) {
+        while (entry.count > 0) free(entry.data[--entry.count]);
+        entry.id = 0;
+    }
+
+    // Find the entry for a free list, taking a free or the oldest entry when not present
+    Entry* find(uint64_t id) {
+        uint32_t x;
+        uint32_t slot = PoolCacheEntries;
+
+        for (x = 0; x < PoolCacheEntries; x++) {
+            if (entries[x].id == id) return &entries[x];
+            if (entries[x].id == 0 && slot == PoolCacheEntries) slot = x;
+        }
+
+        if (slot == PoolCacheEntries) {
+            slot   = victim;
+            victim = (victim + 1) % PoolCacheEntries;
+            flush(entries[slot]);
+        }
+        entries[slot].id = id;
+        return &entries[slot];
+    }
+
+    ~PoolCache() {
+        PoolCacheList& list = poolCacheList();
+        {
+            std::lock_guard<std::mutex> lock(list.mtx);
+            list.caches.erase(std::find(list.caches.begin(), list.caches.end(), this));
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        valid = false;
+        for (uint32_t x = 0; x < PoolCacheEntries; x++) flush(entries[x]);
+    }
+};
+
+// Release the buffers of a retired free list from all thread caches
+void poolCacheFlush(uint64_t id) {
+    PoolCacheList& list = poolCacheList();
+    std::lock_guard<std::mutex> lock(list.mtx);
+
+    for (std::vector<PoolCache*>::iterator it = list.caches.begin(); it != list.caches.end(); ++it) {
+        std::lock_guard<std::mutex> cLock((*it)->mtx);
+        for (uint32_t x = 0; x < PoolCacheEntries; x++)
+            if ((*it)->entries[x].id == id) PoolCache::flush((*it)->entries[x]);
+    }
+}
+
+thread_local PoolCache poolCache;
+
+}  // namespace
+
 //! Creator
 ris::Pool::Pool() {
     allocMeta_  = 0;
@@ -48,11 +151,18 @@ ris::Pool::Pool() {
     allocCount_ = 0;
     fixedSize_  = 0;
     poolSize_   = 0;
+    depot_      = NULL;
 }
 
 //! Destructor
 ris::Pool::~Pool() {
-    while (!dataQ_.empty()) { free(dataQ_.front()); }
+    uint8_t* data;
+
+    for (std::vector<Depot*>::iterator it = depots_.begin(); it != depots_.end(); ++it) {
+        poolCacheFlush((*it)->id);
+        while ((*it)->ring.tryPop(data)) free(data);
+        delete *it;
+    }
 }
 
 //! Get allocated memory
@@ -87,12 +197,11 @@ ris::FramePtr ris::Pool::acceptReq(uint32_t size, bool zeroCopyEn) {
  * Called when this instance is marked as owner of a Buffer entity
  */
 void ris::Pool::retBuffer(uint8_t* data, uint32_t meta, uint32_t rawSize) {
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
+    Depot* depot = depot_.load(std::memory_order_acquire);
 
     if (data != NULL) {
-        if (rawSize == fixedSize_ && poolSize_ > dataQ_.size())
-            dataQ_.push(data);
+        if (depot != NULL && rawSize == depot->size)
+            cachePut(depot, data);
         else
             free(data);
     }
@@ -118,10 +227,13 @@ void ris::Pool::setFixedSize(uint32_t size) {
     std::lock_guard<std::mutex> lock(mtx_);
 
     fixedSize_ = size;
+    updateDepot();
 }
 
 //! Get fixed size mode
 uint32_t ris::Pool::getFixedSize() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
     return fixedSize_;
 }
 
@@ -131,43 +243,110 @@ void ris::Pool::setPoolSize(uint32_t size) {
     std::lock_guard<std::mutex> lock(mtx_);
 
     poolSize_ = size;
+    updateDepot();
 }
 
 //! Get pool size
 uint32_t ris::Pool::getPoolSize() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
     return poolSize_;
 }
 
+//! Create a new free list for the current configuration
+/*
+ * Buffers in the previous free list and the thread caches are released. The
+ * previous list is kept until the pool is destroyed since other threads may
+ * still reference it.
+ */
+void ris::Pool::updateDepot() {
+    Depot* old   = depot_.load();
+    Depot* depot = NULL;
+    uint8_t* data;
+
+    if (fixedSize_ > 0 && poolSize_ > 0) {
+        depot = new Depot(poolDepotId.fetch_add(1), fixedSize_, poolSize_);
+        depot->ring.setMax(poolSize_);
+        depots_.push_back(depot);
+    }
+    depot_.store(depot, std::memory_order_release);
+
+    if (old != NULL) {
+        poolCacheFlush(old->id);
+        while (old->ring.tryPop(data)) free(data);
+    }
+}
+
+//! Get a buffer from the thread cache, refilling from the free list when empty
+uint8_t* ris::Pool::cacheGet(Depot* depot) {
+    PoolCache::Entry* entry;
+    uint8_t* data = NULL;
+
+    if (!poolCache.valid) {
+        depot->ring.tryPop(data);
+        return data;
+    }
+
+    std::lock_guard<std::mutex> lock(poolCache.mtx);
+    entry = poolCache.find(depot->id);
+
+    while (entry->count < PoolMagazineSize / 2 && depot->ring.tryPop(data)) entry->data[entry->count++] = data;
+
+    return (entry->count > 0) ? entry->data[--entry->count] : NULL;
+}
+
+//! Return a buffer to the thread cache, spilling to the free list when full
+void ris::Pool::cachePut(Depot* depot, uint8_t* data) {
+    PoolCache::Entry* entry;
+    uint8_t* spill;
+
+    if (!poolCache.valid) {
+        if (!depot->ring.tryPush(data)) free(data);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(poolCache.mtx);
+    entry = poolCache.find(depot->id);
+
+    if (entry->count == PoolMagazineSize) {
+        while (entry->count > PoolMagazineSize / 2) {
+            spill = entry->data[--entry->count];
+            if (!depot->ring.tryPush(spill)) free(spill);
+        }
+    }
+    entry->data[entry->count++] = data;
+}
+
 //! Allocate a buffer passed size
 // Buffer container and raw data should be allocated from shared memory pool
 ris::BufferPtr ris::Pool::allocBuffer(uint32_t size, uint32_t* total) {
-    uint8_t* data;
+    uint8_t* data = NULL;
     uint32_t bAlloc;
     uint32_t bSize;
     uint32_t meta = 0;
+    Depot* depot;
 
     bAlloc = size;
     bSize  = size;
 
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (fixedSize_ > 0) {
-        bAlloc = fixedSize_;
-        if (bSize > bAlloc) bSize = bAlloc;
+    // Fixed size and pool configuration are taken from the active free list when enabled
+    if ((depot = depot_.load(std::memory_order_acquire)) != NULL) {
+        bAlloc = depot->size;
+        data   = cacheGet(depot);
+    } else {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (fixedSize_ > 0) bAlloc = fixedSize_;
     }
+    if (bSize > bAlloc) bSize = bAlloc;
 
-    if (dataQ_.size() > 0) {
-        data = dataQ_.front();
-        dataQ_.pop();
-    } else if ((data = (uint8_t*)malloc(bAlloc)) == NULL)
+    if (data == NULL && (data = (uint8_t*)malloc(bAlloc)) == NULL)
         throw(
             rogue::GeneralError::create("Pool::allocBuffer", "Failed to allocate buffer with size = %" PRIu32, bAlloc));
 
     // Only use lower 24 bits of meta.
     // Upper 8 bits may have special meaning to sub-class
-    meta = allocMeta_;
-    allocMeta_++;
-    allocMeta_ &= 0xFFFFFF;
+    meta = allocMeta_.fetch_add(1) & 0xFFFFFF;
     allocBytes_ += bAlloc;
     allocCount_++;
     if (total != NULL) *total += bSize;
@@ -178,9 +357,6 @@ ris::BufferPtr ris::Pool::allocBuffer(uint32_t size, uint32_t* total) {
 ris::BufferPtr ris::Pool::createBuffer(void* data, uint32_t meta, uint32_t size, uint32_t alloc) {
     ris::BufferPtr buff;
 
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
-
     buff = ris::Buffer::create(shared_from_this(), data, meta, size, alloc);
 
     allocBytes_ += alloc;
@@ -190,8 +366,6 @@ ris::BufferPtr ris::Pool::createBuffer(void* data, uint32_t meta, uint32_t size,
 
 //! Track buffer deletion
 void ris::Pool::decCounter(uint32_t alloc) {
-    rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(mtx_);
     allocBytes_ -= alloc;
     allocCount_--;
 }
@@ -41,13 +41,13 @@ namespace bp = boost::python;
 #endif
 
 //! Class creation
-ris::TcpClientPtr ris::TcpClient::create(std::string addr, uint16_t port) {
-    ris::TcpClientPtr r = std::make_shared<ris::TcpClient>(addr, port);
+ris::TcpClientPtr ris::TcpClient::create(std::string addr, uint16_t port, bool zeroCopy) {
+    ris::TcpClientPtr r = std::make_shared<ris::TcpClient>(addr, port, zeroCopy);
     return (r);
 }
 
 //! Creator
-ris::TcpClient::TcpClient(std::string addr, uint16_t port) : ris::TcpCore(addr, port, false) {}
+ris::TcpClient::TcpClient(std::string addr, uint16_t port, bool zeroCopy) : ris::TcpCore(addr, port, false, zeroCopy) {}
 
 //! Destructor
 ris::TcpClient::~TcpClient() {}
@@ -57,7 +57,7 @@ void ris::TcpClient::setup_python() {
 
     bp::class_<ris::TcpClient, ris::TcpClientPtr, bp::bases<ris::TcpCore>, boost::noncopyable>(
         "TcpClient",
-        bp::init<std::string, uint16_t>());
+        bp::init<std::string, uint16_t, bp::optional<bool>>());
 
     bp::implicitly_convertible<ris::TcpClientPtr, ris::TcpCorePtr>();
 #endif
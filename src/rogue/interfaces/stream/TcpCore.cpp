@@ -21,11 +21,17 @@
 
 #include "rogue/interfaces/stream/TcpCore.h"
 
+#include <errno.h>
 #include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 #include <zmq.h>
 
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -42,14 +48,107 @@ namespace ris = rogue::interfaces::stream;
 namespace bp = boost::python;
 #endif
 
+namespace {
+// Record header at the start of each message
+struct TcpHeader {
+    uint32_t size;
+    uint16_t flags;
+    uint8_t chan;
+    uint8_t err;
+};
+
+// Called by ZeroMQ once a zero copy part has been sent
+void tcpFreeFrame(void* data, void* hint) {
+    delete static_cast<ris::FramePtr*>(hint);
+}
+
+// Called by ZeroMQ once a coalesced message has been sent
+void tcpFreeBatch(void* data, void* hint) {
+    free(data);
+}
+
+// Pool for received frames, wraps message parts as frame buffers. Received frames do
+// not reference the bridge so it is never destroyed from within its receive thread.
+class TcpMsgPool : public ris::Pool {
+    static const uint32_t WrapFlag = 0x80000000;
+
+    std::mutex mtx_;
+    std::vector<zmq_msg_t*> msgs_;
+    std::vector<uint32_t> free_;
+
+  public:
+    ~TcpMsgPool() {
+        std::vector<zmq_msg_t*>::iterator it;
+
+        for (it = msgs_.begin(); it != msgs_.end(); ++it) {
+            if (*it != NULL) {
+                zmq_msg_close(*it);
+                delete *it;
+            }
+        }
+    }
+
+    // Take ownership of a message part and return a buffer referencing its data
+    ris::BufferPtr wrap(zmq_msg_t* msg) {
+        ris::BufferPtr buff;
+        zmq_msg_t* part;
+        uint32_t size;
+        uint32_t slot;
+
+        part = new zmq_msg_t;
+        zmq_msg_init(part);
+        zmq_msg_move(part, msg);
+        size = zmq_msg_size(part);
+
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (free_.empty()) {
+                slot = msgs_.size();
+                msgs_.push_back(part);
+            } else {
+                slot = free_.back();
+                free_.pop_back();
+                msgs_[slot] = part;
+            }
+        }
+
+        buff = createBuffer(zmq_msg_data(part), slot | WrapFlag, size, size);
+        buff->setPayload(size);
+        return buff;
+    }
+
+    // Release the message part when the buffer is freed
+    void retBuffer(uint8_t* data, uint32_t meta, uint32_t size) {
+        zmq_msg_t* part;
+
+        if ((meta & WrapFlag) == 0) {
+            ris::Pool::retBuffer(data, meta, size);
+            return;
+        }
+        meta &= ~WrapFlag;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            part        = msgs_[meta];
+            msgs_[meta] = NULL;
+            free_.push_back(meta);
+        }
+
+        zmq_msg_close(part);
+        delete part;
+        decCounter(size);
+    }
+};
+}  // namespace
+
 //! Class creation
-ris::TcpCorePtr ris::TcpCore::create(std::string addr, uint16_t port, bool server) {
-    ris::TcpCorePtr r = std::make_shared<ris::TcpCore>(addr, port, server);
+ris::TcpCorePtr ris::TcpCore::create(std::string addr, uint16_t port, bool server, bool zeroCopy) {
+    ris::TcpCorePtr r = std::make_shared<ris::TcpCore>(addr, port, server, zeroCopy);
     return (r);
 }
 
 //! Creator
-ris::TcpCore::TcpCore(std::string addr, uint16_t port, bool server) {
+ris::TcpCore::TcpCore(std::string addr, uint16_t port, bool server, bool zeroCopy) {
     int32_t opt;
     std::string logstr;
 
@@ -70,6 +169,17 @@ ris::TcpCore::TcpCore(std::string addr, uint16_t port, bool server) {
     this->pullAddr_.append(":");
     this->pushAddr_ = this->pullAddr_;
 
+    this->rxPool_   = std::make_shared<TcpMsgPool>();
+    this->zeroCopy_ = zeroCopy;
+
+    this->batch_        = NULL;
+    this->batchMax_     = 0;
+    this->batchUsed_    = 0;
+    this->batchFrames_  = 0;
+    this->batchLatency_ = 0;
+    this->flushThread_  = NULL;
+    resetBatchCounters();
+
     this->zmqCtx_  = zmq_ctx_new();
     this->zmqPull_ = zmq_socket(this->zmqCtx_, ZMQ_PULL);
     this->zmqPush_ = zmq_socket(this->zmqCtx_, ZMQ_PUSH);
@@ -157,10 +267,31 @@ void ris::TcpCore::close() {
 }
 
 void ris::TcpCore::stop() {
+    int32_t linger;
+
     if (threadEn_) {
         rogue::GilRelease noGil;
+
+        // A stalled transmit gives up once the stop timeout has passed
+        stopTime_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(StopTimeout);
         threadEn_ = false;
+
+        // Send pending frames
+        {
+            std::lock_guard<std::mutex> lock(bridgeMtx_);
+            flushBatch();
+        }
+        flushCond_.notify_all();
+
         thread_->join();
+        if (flushThread_ != NULL) flushThread_->join();
+        free(batch_);
+        batch_ = NULL;
+
+        // Queued messages are given up to the stop timeout to be sent
+        linger = StopTimeout;
+        zmq_setsockopt(this->zmqPush_, ZMQ_LINGER, &linger, sizeof(int32_t));
+
         zmq_close(this->zmqPull_);
         zmq_close(this->zmqPush_);
         zmq_ctx_destroy(this->zmqCtx_);
@@ -169,17 +300,117 @@ void ris::TcpCore::stop() {
 
 //! Accept a frame from master
 void ris::TcpCore::acceptFrame(ris::FramePtr frame) {
+    ris::Frame::BufferIterator it;
+    std::vector<zmq_msg_t> msg;
+    TcpHeader hdr;
+    uint32_t parts;
     uint32_t x;
     uint8_t* data;
-    uint16_t flags;
-    uint8_t chan;
-    uint8_t err;
-    zmq_msg_t msg[4];
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr frLock = frame->lock();
     std::lock_guard<std::mutex> lock(bridgeMtx_);
 
+    hdr.size  = frame->getPayload();
+    hdr.flags = frame->getFlags();
+    hdr.chan  = frame->getChannel();
+    hdr.err   = frame->getError();
+
+    // Small frames are appended to the pending batch when coalescing is enabled
+    if (batchMax_ > 0 && hdr.size <= InlineSize && (sizeof(TcpHeader) + hdr.size) <= batchMax_) {
+        if ((batchUsed_ + sizeof(TcpHeader) + hdr.size) > batchMax_) flushBatch();
+
+        // Wake the flush thread to track the latency of the new batch
+        if (batchUsed_ == 0) {
+            batchStart_ = std::chrono::steady_clock::now();
+            flushCond_.notify_all();
+        }
+
+        std::memcpy(batch_ + batchUsed_, &hdr, sizeof(TcpHeader));
+        batchUsed_ += sizeof(TcpHeader);
+
+        ris::FrameIterator iter = frame->begin();
+        ris::fromFrame(iter, hdr.size, batch_ + batchUsed_);
+        batchUsed_ += hdr.size;
+        batchFrames_++;
+
+        // No room for another record
+        if ((batchUsed_ + sizeof(TcpHeader)) > batchMax_) flushBatch();
+        return;
+    }
+
+    // Pending batch is sent first to preserve frame order
+    flushBatch();
+
+    if (!zeroCopy_) {
+        sendLegacy(frame);
+        return;
+    }
+
+    // Small frames are copied after the header, larger frames send one part per buffer
+    parts = 1;
+    if (hdr.size > InlineSize) {
+        for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it)
+            if ((*it)->getPayload() > 0) parts++;
+    }
+
+    msg.resize(parts);
+
+    if (zmq_msg_init_size(&(msg[0]), sizeof(TcpHeader) + ((parts == 1) ? hdr.size : 0)) < 0) {
+        bridgeLog_->warning("Failed to init message with size %" PRIu32, hdr.size);
+        return;
+    }
+
+    data = (uint8_t*)zmq_msg_data(&(msg[0]));
+    std::memcpy(data, &hdr, sizeof(TcpHeader));
+
+    // Copy data
+    if (parts == 1) {
+        ris::FrameIterator iter = frame->begin();
+        ris::fromFrame(iter, hdr.size, data + sizeof(TcpHeader));
+    }
+
+    // Each part holds a reference to the frame until ZeroMQ has sent it
+    else {
+        x = 1;
+        for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
+            if ((*it)->getPayload() == 0) continue;
+
+            ris::FramePtr* ref = new ris::FramePtr(frame);
+
+            if (zmq_msg_init_data(&(msg[x]), (*it)->begin(), (*it)->getPayload(), tcpFreeFrame, ref) < 0) {
+                bridgeLog_->warning("Failed to init message with size %" PRIu32, (*it)->getPayload());
+                delete ref;
+                for (parts = 0; parts < x; parts++) zmq_msg_close(&(msg[parts]));
+                return;
+            }
+            x++;
+        }
+    }
+
+    // Send data
+    for (x = 0; x < parts; x++) {
+        if (sendPart(&(msg[x]), (x == (parts - 1)) ? 0 : ZMQ_SNDMORE) < 0) {
+            bridgeLog_->warning("Failed to push message with size %" PRIu32 " on %s",
+                                hdr.size,
+                                this->pushAddr_.c_str());
+            zmq_msg_close(&(msg[x]));
+        }
+    }
+    txBatchCount_++;
+    txBatchTotal_++;
+    bridgeLog_->debug("Pushed TCP frame with size %" PRIu32 " on %s", hdr.size, this->pushAddr_.c_str());
+}
+
+//! Send a frame with the legacy four part format, bridgeMtx_ must be held
+void ris::TcpCore::sendLegacy(ris::FramePtr frame) {
+    uint32_t x;
+    uint8_t* data;
+    uint16_t flags;
+    uint8_t chan;
+    uint8_t err;
+    zmq_msg_t msg[4];
+
     if ((zmq_msg_init_size(&(msg[0]), 2) < 0) ||  // Flags
         (zmq_msg_init_size(&(msg[1]), 1) < 0) ||  // Channel
         (zmq_msg_init_size(&(msg[2]), 1) < 0)) {  // Error
@@ -208,85 +439,282 @@ void ris::TcpCore::acceptFrame(ris::FramePtr frame) {
 
     // Send data
     for (x = 0; x < 4; x++) {
-        if (zmq_sendmsg(this->zmqPush_, &(msg[x]), (x == 3) ? 0 : ZMQ_SNDMORE) < 0)
+        if (sendPart(&(msg[x]), (x == 3) ? 0 : ZMQ_SNDMORE) < 0) {
             bridgeLog_->warning("Failed to push message with size %" PRIu32 " on %s",
                                 frame->getPayload(),
                                 this->pushAddr_.c_str());
+            zmq_msg_close(&(msg[x]));
+        }
     }
+    txBatchCount_++;
+    txBatchTotal_++;
     bridgeLog_->debug("Pushed TCP frame with size %" PRIu32 " on %s", frame->getPayload(), this->pushAddr_.c_str());
 }
 
+//! Send a message part, bridgeMtx_ must be held
+/*
+ * Blocks while the remote side is back pressuring or not connected. Once the
+ * threads are disabled the wait ends after the stop timeout.
+ */
+int32_t ris::TcpCore::sendPart(void* msg, int32_t flags) {
+    zmq_pollitem_t item;
+
+    item.socket  = this->zmqPush_;
+    item.fd      = 0;
+    item.events  = ZMQ_POLLOUT;
+    item.revents = 0;
+
+    while (zmq_sendmsg(this->zmqPush_, (zmq_msg_t*)msg, flags | ZMQ_DONTWAIT) < 0) {
+        if (zmq_errno() != EAGAIN) return -1;
+        if (!threadEn_ && std::chrono::steady_clock::now() >= stopTime_) return -1;
+        zmq_poll(&item, 1, 100);
+    }
+    return 0;
+}
+
+//! Send the pending batch, bridgeMtx_ must be held
+void ris::TcpCore::flushBatch() {
+    zmq_msg_t msg;
+    uint32_t frames;
+
+    if (batchUsed_ == 0) return;
+
+    frames       = batchFrames_;
+    batchFrames_ = 0;
+
+    // Buffer is passed to ZeroMQ and freed once sent
+    if (zmq_msg_init_data(&msg, batch_, batchUsed_, tcpFreeBatch, NULL) < 0) {
+        bridgeLog_->warning("Failed to init batch message with size %" PRIu32, batchUsed_);
+        batchUsed_ = 0;
+        return;
+    }
+
+    batchUsed_ = 0;
+    if ((batch_ = (uint8_t*)malloc(batchMax_)) == NULL) batchMax_ = 0;
+
+    if (sendPart(&msg, 0) < 0) {
+        bridgeLog_->warning("Failed to push batch of %" PRIu32 " frames on %s", frames, this->pushAddr_.c_str());
+        zmq_msg_close(&msg);
+    } else {
+        txBatchCount_++;
+        txBatchTotal_ += frames;
+        bridgeLog_->debug("Pushed TCP batch of %" PRIu32 " frames on %s", frames, this->pushAddr_.c_str());
+    }
+
+    if (batchMax_ == 0) bridgeLog_->error("Failed to allocate batch buffer, coalescing disabled");
+}
+
+//! Flush thread
+void ris::TcpCore::runFlush() {
+    std::unique_lock<std::mutex> lock(bridgeMtx_);
+
+    while (threadEn_) {
+        if (batchUsed_ == 0)
+            flushCond_.wait_for(lock, std::chrono::milliseconds(100));
+        else if (std::chrono::steady_clock::now() >= (batchStart_ + std::chrono::microseconds(batchLatency_)))
+            flushBatch();
+        else
+            flushCond_.wait_until(lock, batchStart_ + std::chrono::microseconds(batchLatency_));
+    }
+}
+
+//! Set coalescing parameters
+void ris::TcpCore::setCoalesce(uint32_t size, uint32_t latency) {
+    uint8_t* data;
+
+    if (size != 0 && size < (sizeof(TcpHeader) + 1))
+        throw(rogue::GeneralError::create("stream::TcpCore::setCoalesce",
+                                          "Invalid coalesce size %" PRIu32 ", must be zero or at least %" PRIu32,
+                                          size,
+                                          (uint32_t)(sizeof(TcpHeader) + 1)));
+
+    data = NULL;
+    if (size != 0 && (data = (uint8_t*)malloc(size)) == NULL)
+        throw(rogue::GeneralError::create("stream::TcpCore::setCoalesce",
+                                          "Failed to allocate batch buffer with size %" PRIu32,
+                                          size));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(bridgeMtx_);
+
+    // Pending frames are sent with the old settings
+    flushBatch();
+    free(batch_);
+
+    batch_        = data;
+    batchMax_     = size;
+    batchLatency_ = latency;
+
+    // Start flush thread on first use
+    if (size != 0 && flushThread_ == NULL && threadEn_) {
+        flushThread_ = new std::thread(&ris::TcpCore::runFlush, this);
+
+        // Set a thread name
+#ifndef __MACH__
+        pthread_setname_np(flushThread_->native_handle(), "TcpCoreFlush");
+#endif
+    }
+    flushCond_.notify_all();
+}
+
+//! Get maximum coalesced message size, zero when disabled
+uint32_t ris::TcpCore::getCoalesceSize() {
+    return batchMax_;
+}
+
+//! Get maximum coalescing latency in microseconds
+uint32_t ris::TcpCore::getCoalesceLatency() {
+    return batchLatency_;
+}
+
+//! Get number of messages received
+uint64_t ris::TcpCore::getRxBatchCount() {
+    return rxBatchCount_;
+}
+
+//! Get average number of frames per received message
+double ris::TcpCore::getRxBatchAvg() {
+    uint64_t count = rxBatchCount_;
+    return (count == 0) ? 0.0 : (double)rxBatchTotal_ / (double)count;
+}
+
+//! Get number of messages sent
+uint64_t ris::TcpCore::getTxBatchCount() {
+    return txBatchCount_;
+}
+
+//! Get average number of frames per sent message
+double ris::TcpCore::getTxBatchAvg() {
+    uint64_t count = txBatchCount_;
+    return (count == 0) ? 0.0 : (double)txBatchTotal_ / (double)count;
+}
+
+//! Reset batch counters
+void ris::TcpCore::resetBatchCounters() {
+    rxBatchCount_ = 0;
+    rxBatchTotal_ = 0;
+    txBatchCount_ = 0;
+    txBatchTotal_ = 0;
+}
+
+//! Create a frame from a block of received data
+ris::FramePtr ris::TcpCore::rxCopy(uint8_t* data, uint32_t size) {
+    ris::FramePtr frame;
+
+    frame = rxPool_->acceptReq(size, false);
+    frame->setPayload(size);
+
+    ris::FrameIterator iter = frame->begin();
+    ris::toFrame(iter, size, data);
+    return frame;
+}
+
 //! Run thread
 void ris::TcpCore::runThread() {
+    std::deque<zmq_msg_t> msg;
     ris::FramePtr frame;
-    uint64_t more;
-    size_t moreSize;
+    TcpHeader hdr;
     uint8_t* data;
     uint32_t size;
+    uint32_t pos;
     uint32_t msgCnt;
+    uint32_t total;
+    uint32_t frames;
     uint32_t x;
-    zmq_msg_t msg[4];
-    uint16_t flags;
-    uint8_t chan;
-    uint8_t err;
+    bool more;
+
+    TcpMsgPool* pool = static_cast<TcpMsgPool*>(rxPool_.get());
 
     bridgeLog_->logThreadId();
 
     while (threadEn_) {
-        for (x = 0; x < 4; x++) zmq_msg_init(&(msg[x]));
         msgCnt = 0;
-        x      = 0;
 
-        // Get message
+        // Get message, parts are stored in a deque so they are never relocated
         do {
+            if (msgCnt == msg.size()) msg.emplace_back();
+            zmq_msg_init(&(msg[msgCnt]));
+
             // Get the message
-            if (zmq_recvmsg(this->zmqPull_, &(msg[x]), 0) > 0) {
-                if (x != 3) x++;
+            if (zmq_recvmsg(this->zmqPull_, &(msg[msgCnt]), 0) >= 0) {
+                more = zmq_msg_more(&(msg[msgCnt]));
                 msgCnt++;
-
-                // Is there more data?
-                more     = 0;
-                moreSize = 8;
-                zmq_getsockopt(this->zmqPull_, ZMQ_RCVMORE, &more, &moreSize);
-            } else
-                more = 1;
-        } while (threadEn_ && more);
-
-        // Proper message received
-        if (threadEn_ && (msgCnt == 4)) {
-            // Check sizes
-            if ((zmq_msg_size(&(msg[0])) != 2) || (zmq_msg_size(&(msg[1])) != 1) || (zmq_msg_size(&(msg[2])) != 1)) {
-                bridgeLog_->warning("Bad message sizes");
-                for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
-                continue;  // while (1)
+            } else {
+                zmq_msg_close(&(msg[msgCnt]));
+                more = true;
             }
+        } while (threadEn_ && more);
 
-            // Get fields
-            std::memcpy(&flags, zmq_msg_data(&(msg[0])), 2);
-            std::memcpy(&chan, zmq_msg_data(&(msg[1])), 1);
-            std::memcpy(&err, zmq_msg_data(&(msg[2])), 1);
-
-            // Get message info
-            data = (uint8_t*)zmq_msg_data(&(msg[3]));
-            size = zmq_msg_size(&(msg[3]));
+        if (!threadEn_ || msgCnt == 0) {
+            for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
+            continue;
+        }
 
-            // Generate frame
-            frame = reqLocalFrame(size, false);
-            frame->setPayload(size);
+        data   = (uint8_t*)zmq_msg_data(&(msg[0]));
+        size   = zmq_msg_size(&(msg[0]));
+        frames = 0;
 
-            // Copy data
-            ris::FrameIterator iter = frame->begin();
-            ris::toFrame(iter, size, data);
+        // Legacy format with separate flags, channel and error parts
+        if (msgCnt == 4 && size == 2 && zmq_msg_size(&(msg[1])) == 1 && zmq_msg_size(&(msg[2])) == 1) {
+            std::memcpy(&hdr.flags, data, 2);
+            std::memcpy(&hdr.chan, zmq_msg_data(&(msg[1])), 1);
+            std::memcpy(&hdr.err, zmq_msg_data(&(msg[2])), 1);
 
-            // Set frame meta data and send
-            frame->setFlags(flags);
-            frame->setChannel(chan);
-            frame->setError(err);
+            frame = rxCopy((uint8_t*)zmq_msg_data(&(msg[3])), zmq_msg_size(&(msg[3])));
+            frame->setFlags(hdr.flags);
+            frame->setChannel(hdr.chan);
+            frame->setError(hdr.err);
 
             bridgeLog_->debug("Pulled frame with size %" PRIu32, frame->getPayload());
             sendFrame(frame);
+            frames++;
         }
 
+        // Header part followed by either inline data or one part per buffer
+        else {
+            pos = 0;
+
+            while ((pos + sizeof(TcpHeader)) <= size) {
+                std::memcpy(&hdr, data + pos, sizeof(TcpHeader));
+                pos += sizeof(TcpHeader);
+
+                // Payload follows header
+                if (hdr.size <= (size - pos)) {
+                    frame = rxCopy(data + pos, hdr.size);
+                    pos += hdr.size;
+                }
+
+                // Payload is in the remaining parts, used without a copy
+                else if (pos == size && msgCnt > 1) {
+                    for (total = 0, x = 1; x < msgCnt; x++) total += zmq_msg_size(&(msg[x]));
+
+                    if (total != hdr.size) {
+                        bridgeLog_->warning("Bad message size. Got %" PRIu32 " expected %" PRIu32, total, hdr.size);
+                        break;
+                    }
+
+                    frame = ris::Frame::create();
+                    for (x = 1; x < msgCnt; x++) frame->appendBuffer(pool->wrap(&(msg[x])));
+                } else {
+                    bridgeLog_->warning("Bad message sizes");
+                    break;
+                }
+
+                frame->setFlags(hdr.flags);
+                frame->setChannel(hdr.chan);
+                frame->setError(hdr.err);
+
+                bridgeLog_->debug("Pulled frame with size %" PRIu32, frame->getPayload());
+                sendFrame(frame);
+                frames++;
+            }
+        }
+
+        rxBatchCount_++;
+        rxBatchTotal_ += frames;
+
+        // Release the last frame before blocking
+        frame.reset();
         for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
     }
 }
@@ -296,7 +724,15 @@ void ris::TcpCore::setup_python() {
 
     bp::class_<ris::TcpCore, ris::TcpCorePtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>("TcpCore",
                                                                                                       bp::no_init)
-        .def("close", &ris::TcpCore::close);
+        .def("close", &ris::TcpCore::close)
+        .def("setCoalesce", &ris::TcpCore::setCoalesce)
+        .def("getCoalesceSize", &ris::TcpCore::getCoalesceSize)
+        .def("getCoalesceLatency", &ris::TcpCore::getCoalesceLatency)
+        .def("getRxBatchCount", &ris::TcpCore::getRxBatchCount)
+        .def("getRxBatchAvg", &ris::TcpCore::getRxBatchAvg)
+        .def("getTxBatchCount", &ris::TcpCore::getTxBatchCount)
+        .def("getTxBatchAvg", &ris::TcpCore::getTxBatchAvg)
+        .def("resetBatchCounters", &ris::TcpCore::resetBatchCounters);
 
     bp::implicitly_convertible<ris::TcpCorePtr, ris::MasterPtr>();
     bp::implicitly_convertible<ris::TcpCorePtr, ris::SlavePtr>();
@@ -41,13 +41,13 @@ namespace bp = boost::python;
 #endif
 
 //! Class creation
-ris::TcpServerPtr ris::TcpServer::create(std::string addr, uint16_t port) {
-    ris::TcpServerPtr r = std::make_shared<ris::TcpServer>(addr, port);
+ris::TcpServerPtr ris::TcpServer::create(std::string addr, uint16_t port, bool zeroCopy) {
+    ris::TcpServerPtr r = std::make_shared<ris::TcpServer>(addr, port, zeroCopy);
     return (r);
 }
 
 //! Creator
-ris::TcpServer::TcpServer(std::string addr, uint16_t port) : ris::TcpCore(addr, port, true) {}
+ris::TcpServer::TcpServer(std::string addr, uint16_t port, bool zeroCopy) : ris::TcpCore(addr, port, true, zeroCopy) {}
 
 //! Destructor
 ris::TcpServer::~TcpServer() {}
@@ -57,7 +57,7 @@ void ris::TcpServer::setup_python() {
 
     bp::class_<ris::TcpServer, ris::TcpServerPtr, bp::bases<ris::TcpCore>, boost::noncopyable>(
         "TcpServer",
-        bp::init<std::string, uint16_t>());
+        bp::init<std::string, uint16_t, bp::optional<bool>>());
 
     bp::implicitly_convertible<ris::TcpServerPtr, ris::TcpCorePtr>();
 #endif
@@ -48,10 +48,14 @@
 #include <math.h>
 #include <stdint.h>
 
+#include <string.h>
+
+#include <chrono>
 #include <memory>
 #include <thread>
 
 #include "rogue/GeneralError.h"
+#include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
 #include "rogue/protocols/batcher/Data.h"
@@ -59,6 +63,11 @@
 namespace rpb = rogue::protocols::batcher;
 namespace ris = rogue::interfaces::stream;
 
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
 //! Class creation
 rpb::CoreV1Ptr rpb::CoreV1::create() {
     rpb::CoreV1Ptr p = std::make_shared<rpb::CoreV1>();
@@ -66,15 +75,29 @@ rpb::CoreV1Ptr rpb::CoreV1::create() {
 }
 
 //! Setup class in python
-void rpb::CoreV1::setup_python() {}
+void rpb::CoreV1::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rpb::CoreV1, rpb::CoreV1Ptr, boost::noncopyable>("CoreV1", bp::init<>())
+        .def("getFrameCount", &rpb::CoreV1::getFrameCount)
+        .def("getFastCount", &rpb::CoreV1::getFastCount)
+        .def("getRecordCount", &rpb::CoreV1::getRecordCount)
+        .def("getByteCount", &rpb::CoreV1::getByteCount)
+        .def("getParseTime", &rpb::CoreV1::getParseTime)
+        .def("getParseRate", &rpb::CoreV1::getParseRate)
+        .def("resetStats", &rpb::CoreV1::resetStats);
+#endif
+}
 
 //! Creator with version constant
 rpb::CoreV1::CoreV1() {
     log_ = rogue::Logging::create("batcher.CoreV1");
 
+    count_      = 0;
     headerSize_ = 0;
     tailSize_   = 0;
     seq_        = 0;
+
+    resetStats();
 }
 
 //! Deconstructor
@@ -88,7 +111,7 @@ void rpb::CoreV1::initSize(uint32_t size) {
 
 //! Record count
 uint32_t rpb::CoreV1::count() {
-    return list_.size();
+    return count_;
 }
 
 //! Get header size
@@ -120,7 +143,7 @@ ris::FrameIterator rpb::CoreV1::beginTail(uint32_t index) {
                                           tails_.size()));
 
     // Invert order on return
-    return tails_[(tails_.size() - 1) - index];
+    return frame_->begin() + tails_[(tails_.size() - 1) - index];
 }
 
 //! Get end of tail iterator
@@ -132,19 +155,19 @@ ris::FrameIterator rpb::CoreV1::endTail(uint32_t index) {
                                           tails_.size());
 
     // Invert order on return
-    return tails_[(tails_.size() - 1) - index] + tailSize_;
+    return frame_->begin() + (tails_[(tails_.size() - 1) - index] + tailSize_);
 }
 
 //! Get data
 rpb::DataPtr& rpb::CoreV1::record(uint32_t index) {
-    if (index >= list_.size())
+    if (index >= count_)
         throw rogue::GeneralError::create("batcher::CoreV1::record",
                                           "Attempt to access record %" PRIu32 " in frame with %" PRIu32 " records",
                                           index,
-                                          tails_.size());
+                                          count_);
 
     // Invert order on return
-    return list_[(list_.size() - 1) - index];
+    return list_[(count_ - 1) - index];
 }
 
 //! Return sequence
@@ -154,6 +177,24 @@ uint32_t rpb::CoreV1::sequence() {
 
 //! Process a frame
 bool rpb::CoreV1::processFrame(ris::FramePtr frame) {
+    bool ret;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ret = parseFrame(frame);
+
+    std::chrono::nanoseconds dur = std::chrono::steady_clock::now() - start;
+    parseTime_ += dur.count();
+    frameCount_++;
+    recordCount_ += count_;
+    byteCount_ += frame->getPayload();
+    return ret;
+}
+
+//! Parse header and tails
+bool rpb::CoreV1::parseFrame(ris::FramePtr frame) {
+    uint8_t* data;
+    uint32_t pos;
     uint8_t temp;
     uint32_t rem;
     uint32_t fSize;
@@ -181,6 +222,9 @@ bool rpb::CoreV1::processFrame(ris::FramePtr frame) {
         return false;
     }
 
+    // Header and tail iterators reference the frame
+    frame_ = frame;
+
     // Get version & size
     beg = frame->begin();
     ris::fromFrame(beg, 1, &temp);
@@ -250,6 +294,52 @@ bool rpb::CoreV1::processFrame(ris::FramePtr frame) {
     beg += (headerSize_ - 2);  // Already read 2 bytes from frame
     rem -= headerSize_;
 
+    // Single buffer frames are parsed with direct loads from the buffer memory
+    if (frame->bufferCount() == 1) {
+        data = (*frame->beginBuffer())->begin();
+        beg  = frame->begin();
+        pos  = headerSize_ + rem;
+
+        // Process each frame, stop when we have reached just after the header
+        while (pos != headerSize_) {
+            // sanity check
+            if ((pos - headerSize_) < tailSize_) {
+                log_->error("Not enough space (%" PRIu32 ") for tail (%" PRIu32 ")", pos - headerSize_, tailSize_);
+                reset();
+                return false;
+            }
+
+            // Jump to start of the tail and add it to the list
+            pos -= tailSize_;
+            tails_.push_back(pos);
+
+            // Get tail data
+            memcpy(&fSize, data + pos, 4);
+            dest  = data[pos + 4];
+            fUser = data[pos + 5];
+            lUser = data[pos + 6];
+
+            // Round up rewind amount to width
+            if ((fSize % headerSize_) == 0)
+                fJump = fSize;
+            else
+                fJump = ((fSize / headerSize_) + 1) * headerSize_;
+
+            // Not enough data for rewind value
+            if (fJump > (pos - headerSize_)) {
+                log_->error("Not enough space (%" PRIu32 ") for frame (%" PRIu32 ")", pos - headerSize_, fJump);
+                reset();
+                return false;
+            }
+
+            // Set position to start of data and add the record
+            pos -= fJump;
+            addRecord(beg, pos, fSize, dest, fUser, lUser);
+        }
+        fastCount_++;
+        return true;
+    }
+
     // Set marker to end of frame
     mark = frame->end();
 
@@ -266,8 +356,8 @@ bool rpb::CoreV1::processFrame(ris::FramePtr frame) {
         mark -= tailSize_;
         rem -= tailSize_;
 
-        // Add tail iterator to end of list
-        tails_.push_back(mark);
+        // Add tail offset to end of list
+        tails_.push_back(headerSize_ + rem);
 
         // Get tail data, use a new iterator
         tail = mark;
@@ -293,19 +383,82 @@ bool rpb::CoreV1::processFrame(ris::FramePtr frame) {
         mark -= fJump;
         rem -= fJump;
 
-        // Create data record and add it to end of list
-        list_.push_back(rpb::Data::create(mark, fSize, dest, fUser, lUser));
+        // Add data record to end of list
+        addRecord(mark, 0, fSize, dest, fUser, lUser);
     }
     return true;
 }
 
+//! Add a record at the passed offset from the iterator, reusing unreferenced records
+void rpb::CoreV1::addRecord(const ris::FrameIterator& it,
+                            uint32_t offset,
+                            uint32_t size,
+                            uint8_t dest,
+                            uint8_t fUser,
+                            uint8_t lUser) {
+    if (count_ == list_.size())
+        list_.push_back(rpb::Data::create(it + offset, size, dest, fUser, lUser));
+    else if (list_[count_].use_count() == 1)
+        list_[count_]->update(it, offset, size, dest, fUser, lUser);
+    else
+        list_[count_] = rpb::Data::create(it + offset, size, dest, fUser, lUser);
+    count_++;
+}
+
 //! Reset data
 void rpb::CoreV1::reset() {
+    uint32_t x;
+
+    // Records are kept for reuse, drop their frame references
+    for (x = 0; x < count_; x++) list_[x]->release();
+
     frame_.reset();
-    list_.clear();
     tails_.clear();
 
+    count_      = 0;
     headerSize_ = 0;
     tailSize_   = 0;
     seq_        = 0;
 }
+
+//! Get number of frames processed
+uint64_t rpb::CoreV1::getFrameCount() {
+    return frameCount_;
+}
+
+//! Get number of frames parsed with direct buffer loads
+uint64_t rpb::CoreV1::getFastCount() {
+    return fastCount_;
+}
+
+//! Get number of records found
+uint64_t rpb::CoreV1::getRecordCount() {
+    return recordCount_;
+}
+
+//! Get number of frame bytes processed
+uint64_t rpb::CoreV1::getByteCount() {
+    return byteCount_;
+}
+
+//! Get time spent parsing frames in seconds
+double rpb::CoreV1::getParseTime() {
+    return (double)parseTime_ / 1.0e9;
+}
+
+//! Get parse rate in records per second
+double rpb::CoreV1::getParseRate() {
+    uint64_t time = parseTime_;
+
+    if (time == 0) return 0.0;
+    return (double)recordCount_ * 1.0e9 / (double)time;
+}
+
+//! Reset the statistics
+void rpb::CoreV1::resetStats() {
+    frameCount_  = 0;
+    fastCount_   = 0;
+    recordCount_ = 0;
+    byteCount_   = 0;
+    parseTime_   = 0;
+}
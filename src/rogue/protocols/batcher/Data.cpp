@@ -49,6 +49,27 @@ rpb::Data::Data(ris::FrameIterator it, uint32_t size, uint8_t dest, uint8_t fUse
 //! Deconstructor
 rpb::Data::~Data() {}
 
+//! Update record with data at the passed offset from the iterator
+void rpb::Data::update(const ris::FrameIterator& it,
+                       uint32_t offset,
+                       uint32_t size,
+                       uint8_t dest,
+                       uint8_t fUser,
+                       uint8_t lUser) {
+    it_  = it;
+    it_ += offset;
+
+    size_  = size;
+    dest_  = dest;
+    fUser_ = fUser;
+    lUser_ = lUser;
+}
+
+//! Release the frame reference
+void rpb::Data::release() {
+    it_ = ris::FrameIterator();
+}
+
 //! Return Begin Data Iterator
 ris::FrameIterator rpb::Data::begin() {
     return it_;
@@ -24,13 +24,16 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "rogue/GilRelease.h"
 #include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
 #include "rogue/interfaces/stream/FrameLock.h"
 #include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Pool.h"
 #include "rogue/interfaces/stream/Slave.h"
 #include "rogue/protocols/batcher/CoreV1.h"
 #include "rogue/protocols/batcher/Data.h"
@@ -43,6 +46,44 @@ namespace ris = rogue::interfaces::stream;
 namespace bp = boost::python;
 #endif
 
+namespace {
+
+// Location and flags of a record within the super frame
+struct SplitterRecord {
+    uint32_t offset;
+    uint32_t size;
+    uint8_t dest;
+    uint8_t fUser;
+    uint8_t lUser;
+};
+
+// Pool for frames which reference the memory of a super frame. Each emitted
+// buffer holds the pool, which holds the super frame until all are released.
+class SplitterSlicePool : public ris::Pool {
+    ris::FramePtr parent_;
+
+  public:
+    explicit SplitterSlicePool(ris::FramePtr parent) : parent_(parent) {}
+
+    // Create a frame referencing a contiguous block of the super frame
+    ris::FramePtr slice(uint8_t* data, uint32_t size) {
+        ris::FramePtr frame;
+        ris::BufferPtr buff;
+
+        frame = ris::Frame::create();
+        buff  = createBuffer(data, 0, size, size);
+        buff->setPayload(size);
+        frame->appendBuffer(buff);
+        return frame;
+    }
+
+    // Buffers reference the super frame, nothing to free
+    void retBuffer(uint8_t*, uint32_t, uint32_t size) {
+        decCounter(size);
+    }
+};
+}  // namespace
+
 //! Class creation
 rpb::SplitterV1Ptr rpb::SplitterV1::create() {
     rpb::SplitterV1Ptr p = std::make_shared<rpb::SplitterV1>();
@@ -54,45 +95,119 @@ void rpb::SplitterV1::setup_python() {
 #ifndef NO_PYTHON
     bp::class_<rpb::SplitterV1, rpb::SplitterV1Ptr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>(
         "SplitterV1",
-        bp::init<>());
+        bp::init<>())
+        .def("setZeroCopy", &rpb::SplitterV1::setZeroCopy)
+        .def("getZeroCopy", &rpb::SplitterV1::getZeroCopy)
+        .def("getSliceCount", &rpb::SplitterV1::getSliceCount)
+        .def("getCopyCount", &rpb::SplitterV1::getCopyCount)
+        .def("getCore", &rpb::SplitterV1::getCore);
 #endif
 }
 
 //! Creator
-rpb::SplitterV1::SplitterV1() : ris::Master(), ris::Slave() {}
+rpb::SplitterV1::SplitterV1() : ris::Master(), ris::Slave() {
+    core_       = rpb::CoreV1::create();
+    zeroCopy_   = false;
+    sliceCount_ = 0;
+    copyCount_  = 0;
+}
 
 //! Deconstructor
 rpb::SplitterV1::~SplitterV1() {}
 
 //! Accept a frame from master
 void rpb::SplitterV1::acceptFrame(ris::FramePtr frame) {
-    rpb::CoreV1 core;
+    std::shared_ptr<SplitterSlicePool> pool;
+    std::vector<SplitterRecord> records;
+    std::vector<SplitterRecord>::iterator it;
+    ris::FrameIterator dIter;
     ris::FramePtr nFrame;
-    rpb::DataPtr data;
+    rpb::Data* data;
+    uint32_t pos;
     uint32_t x;
 
-    // Lock frame
     rogue::GilRelease noGil;
     ris::FrameLockPtr lock = frame->lock();
 
-    core.processFrame(frame);
+    // Parse under the lock, only the record locations are kept
+    {
+        std::lock_guard<std::mutex> cLock(mtx_);
 
-    for (x = 0; x < core.count(); x++) {
-        data = core.record(x);
+        core_->processFrame(frame);
 
-        // Create a new frame
-        nFrame = reqFrame(data->size(), true);
-        nFrame->setPayload(data->size());
+        records.resize(core_->count());
+        dIter = frame->begin();
 
-        ris::FrameIterator fIter = nFrame->begin();
-        ris::FrameIterator dIter = data->begin();
-        ris::copyFrame(dIter, data->size(), fIter);
+        for (x = 0; x < core_->count(); x++) {
+            data = core_->record(x).get();
+
+            records[x].offset = data->begin() - dIter;
+            records[x].size   = data->size();
+            records[x].dest   = data->dest();
+            records[x].fUser  = data->fUser();
+            records[x].lUser  = data->lUser();
+        }
+        core_->reset();
+    }
+
+    if (zeroCopy_ && !records.empty()) pool = std::make_shared<SplitterSlicePool>(frame);
+
+    // Build and send one record at a time
+    pos = 0;
+    for (it = records.begin(); it != records.end(); ++it) {
+        if (it->offset < pos) {
+            dIter = frame->begin();
+            pos   = 0;
+        }
+        if (it->offset > pos) dIter += (it->offset - pos);
+        pos = it->offset;
+
+        // Reference the super frame when the record is contained in a single buffer
+        if (pool && it->size > 0 && dIter.remBuffer() >= it->size) {
+            nFrame = pool->slice(dIter.ptr(), it->size);
+            sliceCount_++;
+        } else {
+            // Create a new frame
+            nFrame = reqFrame(it->size, true);
+            nFrame->setPayload(it->size);
+
+            ris::FrameIterator sIter = dIter;
+            ris::FrameIterator fIter = nFrame->begin();
+            ris::copyFrame(sIter, it->size, fIter);
+            copyCount_++;
+        }
 
         // Set flags
-        nFrame->setFirstUser(data->fUser());
-        nFrame->setLastUser(data->lUser());
-        nFrame->setChannel(data->dest());
+        nFrame->setFirstUser(it->fUser);
+        nFrame->setLastUser(it->lUser);
+        nFrame->setChannel(it->dest);
 
         sendFrame(nFrame);
+        nFrame.reset();
     }
 }
+
+//! Set zero copy mode
+void rpb::SplitterV1::setZeroCopy(bool enable) {
+    zeroCopy_ = enable;
+}
+
+//! Get zero copy mode
+bool rpb::SplitterV1::getZeroCopy() {
+    return zeroCopy_;
+}
+
+//! Get number of frames emitted as views of the super frame
+uint64_t rpb::SplitterV1::getSliceCount() {
+    return sliceCount_;
+}
+
+//! Get number of frames emitted as copies
+uint64_t rpb::SplitterV1::getCopyCount() {
+    return copyCount_;
+}
+
+//! Get the parser, used to read parse statistics
+rpb::CoreV1Ptr rpb::SplitterV1::getCore() {
+    return core_;
+}
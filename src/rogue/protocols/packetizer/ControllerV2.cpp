@@ -33,17 +33,12 @@
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
 #include "rogue/protocols/packetizer/Application.h"
+#include "rogue/protocols/packetizer/Crc32.h"
 #include "rogue/protocols/packetizer/Transport.h"
 
 namespace rpp = rogue::protocols::packetizer;
 namespace ris = rogue::interfaces::stream;
 
-// Local CRC library
-#include "rogue/protocols/packetizer/CRC.h"
-
-// CRC Lookup table for later use
-static const CRC::Table<uint32_t, 32> crcTable_(CRC::CRC_32());
-
 //! Class creation
 rpp::ControllerV2Ptr rpp::ControllerV2::create(bool enIbCrc,
                                                bool enObCrc,
@@ -139,9 +134,9 @@ void rpp::ControllerV2::transportRx(ris::FramePtr frame) {
 
         // Compute CRC
         if (tmpSof)
-            crc_[tmpDest] = CRC::Calculate(data, size - 4, crcTable_);
+            crc_[tmpDest] = rpp::Crc32::calculate(data, size - 4);
         else
-            crc_[tmpDest] = CRC::Calculate(data, size - 4, crcTable_, crc_[tmpDest]);
+            crc_[tmpDest] = rpp::Crc32::calculate(data, size - 4, crc_[tmpDest]);
 
         crcErr = (tmpCrc != crc_[tmpDest]);
     } else
@@ -336,9 +331,9 @@ void rpp::ControllerV2::applicationRx(ris::FramePtr frame, uint8_t tDest) {
         if (enObCrc_) {
             // Compute CRC
             if (segment == 0)
-                crc = CRC::Calculate(data, size - 4, crcTable_);
+                crc = rpp::Crc32::calculate(data, size - 4);
             else
-                crc = CRC::Calculate(data, size - 4, crcTable_, crc);
+                crc = rpp::Crc32::calculate(data, size - 4, crc);
 
             // Tail  word 1
             data[size - 1] = (crc >> 0) & 0xFF;
@@ -0,0 +1,263 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Packetizer CRC32
+ * ----------------------------------------------------------------------------
+ * File       : Crc32.cpp
+ * ----------------------------------------------------------------------------
+ * Description:
+ * CRC-32 engine used by the packetizer version 2 protocol.
+ *
+ * The carry-less multiply engine follows "Fast CRC Computation for Generic
+ * Polynomials Using PCLMULQDQ Instruction" (Intel, 2009), using the bit
+ * reflected constants for the CRC-32 polynomial.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/protocols/packetizer/Crc32.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "rogue/GeneralError.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define ROGUE_CRC32_CLMUL
+#endif
+
+namespace rpp = rogue::protocols::packetizer;
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+namespace {
+
+// Slicing-by-8 lookup tables, table 0 is the byte wise table
+struct CrcTables {
+    uint32_t t[8][256];
+
+    CrcTables() {
+        uint32_t crc;
+        uint32_t x;
+        uint32_t y;
+
+        for (x = 0; x < 256; x++) {
+            crc = x;
+            for (y = 0; y < 8; y++) crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+            t[0][x] = crc;
+        }
+
+        for (x = 0; x < 256; x++) {
+            for (y = 1; y < 8; y++) t[y][x] = (t[y - 1][x] >> 8) ^ t[0][t[y - 1][x] & 0xFF];
+        }
+    }
+};
+
+const CrcTables crcTables;
+
+// Update an inverted CRC state with table lookups
+uint32_t tableUpdate(uint32_t state, const uint8_t* data, uint32_t size) {
+    const uint32_t(*t)[256] = crcTables.t;
+    uint32_t lo;
+    uint32_t hi;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    while (size >= 8) {
+        memcpy(&lo, data, 4);
+        memcpy(&hi, data + 4, 4);
+        lo ^= state;
+
+        state = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+
+        data += 8;
+        size -= 8;
+    }
+#endif
+
+    while (size > 0) {
+        state = (state >> 8) ^ t[0][(state ^ *data) & 0xFF];
+        data++;
+        size--;
+    }
+    return state;
+}
+
+#ifdef ROGUE_CRC32_CLMUL
+
+// Fold a block of at least 64 bytes, with a size that is a multiple of 16, into an inverted CRC state
+__attribute__((target("pclmul,sse4.1"))) uint32_t clmulFold(uint32_t state, const uint8_t* data, uint32_t size) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+    const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+    // Load the first 64 bytes into four lanes
+    x1 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(state));
+
+    data += 64;
+    size -= 64;
+
+    // Fold four lanes in parallel, 64 bytes at a time
+    while (size >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(data + 0x30)));
+
+        data += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // Fold the remaining 16 byte blocks
+    while (size >= 16) {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)data)), x5);
+
+        data += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return _mm_extract_epi32(x1, 1);
+}
+
+#endif
+
+// Detect carry-less multiply support for the running CPU
+bool detectClmul() {
+#ifdef ROGUE_CRC32_CLMUL
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#else
+    return false;
+#endif
+}
+
+const bool clmulEn = detectClmul();
+
+}  // namespace
+
+// Setup class for use in python
+void rpp::Crc32::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rpp::Crc32, boost::noncopyable>("Crc32", bp::no_init)
+        .def("calculate", &rpp::Crc32::calculatePy)
+        .staticmethod("calculate")
+        .def("clmulSupported", &rpp::Crc32::clmulSupported)
+        .staticmethod("clmulSupported");
+#endif
+}
+
+//! Compute CRC using the fastest engine for the running CPU
+uint32_t rpp::Crc32::calculate(const void* data, uint32_t size, uint32_t crc) {
+    if (clmulEn && size >= 64) return calculateClmul(data, size, crc);
+    return ~tableUpdate(~crc, (const uint8_t*)data, size);
+}
+
+//! Compute CRC using slicing-by-8 table lookups
+uint32_t rpp::Crc32::calculateTable(const void* data, uint32_t size, uint32_t crc) {
+    return ~tableUpdate(~crc, (const uint8_t*)data, size);
+}
+
+//! Compute CRC using carry-less multiply folding
+uint32_t rpp::Crc32::calculateClmul(const void* data, uint32_t size, uint32_t crc) {
+    const uint8_t* ptr = (const uint8_t*)data;
+    uint32_t state     = ~crc;
+
+#ifdef ROGUE_CRC32_CLMUL
+    if (clmulEn && size >= 64) {
+        uint32_t fold = size & ~0xF;
+        state         = clmulFold(state, ptr, fold);
+        ptr += fold;
+        size -= fold;
+    }
+#endif
+
+    return ~tableUpdate(state, ptr, size);
+}
+
+//! Return true if the running CPU supports carry-less multiply folding
+bool rpp::Crc32::clmulSupported() {
+    return clmulEn;
+}
+
+#ifndef NO_PYTHON
+
+//! Compute CRC of a python buffer
+uint32_t rpp::Crc32::calculatePy(bp::object data, uint32_t crc, uint32_t engine) {
+    Py_buffer pyBuf;
+    uint32_t ret;
+
+    if (PyObject_GetBuffer(data.ptr(), &pyBuf, PyBUF_SIMPLE) < 0)
+        throw(rogue::GeneralError("Crc32::calculatePy", "Python Buffer Error"));
+
+    if (engine == 1)
+        ret = calculateTable(pyBuf.buf, pyBuf.len, crc);
+    else if (engine == 2)
+        ret = calculateClmul(pyBuf.buf, pyBuf.len, crc);
+    else
+        ret = calculate(pyBuf.buf, pyBuf.len, crc);
+
+    PyBuffer_Release(&pyBuf);
+    return ret;
+}
+
+#endif
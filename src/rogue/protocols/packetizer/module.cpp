@@ -29,6 +29,7 @@
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/Core.h"
 #include "rogue/protocols/packetizer/CoreV2.h"
+#include "rogue/protocols/packetizer/Crc32.h"
 #include "rogue/protocols/packetizer/Transport.h"
 
 namespace bp  = boost::python;
@@ -48,4 +49,5 @@ void rpp::setup_module() {
     rpp::Transport::setup_python();
     rpp::Core::setup_python();
     rpp::CoreV2::setup_python();
+    rpp::Crc32::setup_python();
 }
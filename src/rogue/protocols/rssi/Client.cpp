@@ -39,15 +39,15 @@ namespace bp = boost::python;
 #endif
 
 //! Class creation
-rpr::ClientPtr rpr::Client::create(uint32_t segSize) {
-    rpr::ClientPtr r = std::make_shared<rpr::Client>(segSize);
+rpr::ClientPtr rpr::Client::create(uint32_t segSize, bool lockFree) {
+    rpr::ClientPtr r = std::make_shared<rpr::Client>(segSize, lockFree);
     return (r);
 }
 
 void rpr::Client::setup_python() {
 #ifndef NO_PYTHON
 
-    bp::class_<rpr::Client, rpr::ClientPtr, boost::noncopyable>("Client", bp::init<uint32_t>())
+    bp::class_<rpr::Client, rpr::ClientPtr, boost::noncopyable>("Client", bp::init<uint32_t, bp::optional<bool>>())
         .def("transport", &rpr::Client::transport)
         .def("application", &rpr::Client::application)
         .def("getOpen", &rpr::Client::getOpen)
@@ -74,6 +74,7 @@ void rpr::Client::setup_python() {
         .def("getLocMaxRetran", &rpr::Client::getLocMaxRetran)
         .def("setLocMaxCumAck", &rpr::Client::setLocMaxCumAck)
         .def("getLocMaxCumAck", &rpr::Client::getLocMaxCumAck)
+        .def("getLockFreeQueue", &rpr::Client::getLockFreeQueue)
         .def("curMaxBuffers", &rpr::Client::curMaxBuffers)
         .def("curMaxSegment", &rpr::Client::curMaxSegment)
         .def("curCumAckTout", &rpr::Client::curCumAckTout)
@@ -89,10 +90,10 @@ void rpr::Client::setup_python() {
 }
 
 //! Creator
-rpr::Client::Client(uint32_t segSize) {
+rpr::Client::Client(uint32_t segSize, bool lockFree) {
     app_  = rpr::Application::create();
     tran_ = rpr::Transport::create();
-    cntl_ = rpr::Controller::create(segSize, tran_, app_, false);
+    cntl_ = rpr::Controller::create(segSize, tran_, app_, false, lockFree);
 
     app_->setController(cntl_);
     tran_->setController(cntl_);
@@ -217,6 +218,10 @@ uint8_t rpr::Client::getLocMaxCumAck() {
     return cntl_->getLocMaxCumAck();
 }
 
+bool rpr::Client::getLockFreeQueue() {
+    return cntl_->getLockFreeQueue();
+}
+
 uint8_t rpr::Client::curMaxBuffers() {
     return cntl_->curMaxBuffers();
 }
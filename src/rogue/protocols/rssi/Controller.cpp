@@ -49,21 +49,28 @@ namespace ris = rogue::interfaces::stream;
 rpr::ControllerPtr rpr::Controller::create(uint32_t segSize,
                                            rpr::TransportPtr tran,
                                            rpr::ApplicationPtr app,
-                                           bool server) {
-    rpr::ControllerPtr r = std::make_shared<rpr::Controller>(segSize, tran, app, server);
+                                           bool server,
+                                           bool lockFree) {
+    rpr::ControllerPtr r = std::make_shared<rpr::Controller>(segSize, tran, app, server, lockFree);
     return (r);
 }
 
 //! Creator
-rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::ApplicationPtr app, bool server) {
-    app_    = app;
-    tran_   = tran;
-    server_ = server;
+rpr::Controller::Controller(uint32_t segSize,
+                            rpr::TransportPtr tran,
+                            rpr::ApplicationPtr app,
+                            bool server,
+                            bool lockFree) {
+    app_      = app;
+    tran_     = tran;
+    server_   = server;
+    lockFree_ = lockFree;
 
     locTryPeriod_ = 100;
 
     // Busy after two entries
     appQueue_.setThold(2);
+    appRing_.setThold(2);
 
     dropCount_ = 0;
     nextSeqRx_ = 0;
@@ -130,6 +137,34 @@ rpr::Controller::~Controller() {
 //! Stop queues
 void rpr::Controller::stopQueue() {
     appQueue_.stop();
+    appRing_.stop();
+}
+
+//! Add a received header to the application queue
+void rpr::Controller::appPush(rpr::HeaderPtr head) {
+    if (lockFree_)
+        appRing_.push(head);
+    else
+        appQueue_.push(head);
+}
+
+//! Add a received header to the state queue
+void rpr::Controller::stPush(rpr::HeaderPtr head) {
+    if (lockFree_)
+        stRing_.push(head);
+    else
+        stQueue_.push(head);
+}
+
+//! Get the next pending header from the state queue, NULL if empty
+rpr::HeaderPtr rpr::Controller::stPop() {
+    rpr::HeaderPtr head;
+
+    if (lockFree_)
+        stRing_.tryPop(head);
+    else if (!stQueue_.empty())
+        head = stQueue_.pop();
+    return head;
 }
 
 //! Close
@@ -240,7 +275,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
 
     // Reset
     if (head->rst) {
-        if (state_ == StOpen || state_ == StWaitSyn) { stQueue_.push(head); }
+        if (state_ == StOpen || state_ == StWaitSyn) { stPush(head); }
     }
 
     // Syn frame goes to state machine if state = open
@@ -249,7 +284,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
         if (state_ == StOpen || state_ == StWaitSyn) {
             lastSeqRx_ = head->sequence;
             nextSeqRx_ = lastSeqRx_ + 1;
-            stQueue_.push(head);
+            stPush(head);
         }
     }
 
@@ -261,7 +296,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
 
             lastSeqRx_ = nextSeqRx_;
             nextSeqRx_ = nextSeqRx_ + 1;
-            appQueue_.push(head);
+            appPush(head);
 
             // There are elements in ooo (out-of-order) queue
             if (!oooQueue_.empty()) {
@@ -283,7 +318,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
                     lastSeqRx_ = nextSeqRx_;
                     nextSeqRx_ = nextSeqRx_ + 1;
 
-                    appQueue_.push(it->second);
+                    appPush(it->second);
                     log_->info("Using frame from ooo queue. server=%" PRIu8 ", head->sequence=%" PRIu32,
                                server_,
                                (it->second)->sequence);
@@ -347,7 +382,7 @@ ris::FramePtr rpr::Controller::applicationTx() {
     rogue::GilRelease noGil;
 
     do {
-        if ((head = appQueue_.pop()) == NULL) return (frame);
+        if ((head = (lockFree_ ? appRing_.pop() : appQueue_.pop())) == NULL) return (frame);
         stCond_.notify_all();
 
         frame                   = head->getFrame();
@@ -437,7 +472,7 @@ uint32_t rpr::Controller::getRetranCount() {
 
 //! Get locBusy
 bool rpr::Controller::getLocBusy() {
-    bool queueBusy = appQueue_.busy();
+    bool queueBusy = lockFree_ ? appRing_.busy() : appQueue_.busy();
     if (!locBusy_ && queueBusy) locBusyCnt_++;
     locBusy_ = queueBusy;
     return (locBusy_);
@@ -775,9 +810,7 @@ struct timeval& rpr::Controller::stateClosedWait() {
     rpr::HeaderPtr head;
 
     // got syn or reset
-    if (!stQueue_.empty()) {
-        head = stQueue_.pop();
-
+    if ((head = stPop()) != NULL) {
         // Reset
         if (head->rst) {
             state_ = StClosed;
@@ -910,9 +943,7 @@ struct timeval& rpr::Controller::stateOpen() {
     struct timeval locTime;
 
     // Pending frame may be reset
-    while (!stQueue_.empty()) {
-        head = stQueue_.pop();
-
+    while ((head = stPop()) != NULL) {
         // Reset or syn without ack is an error
         if ((head->rst) || (head->syn && (!head->ack))) {
             state_ = StError;
@@ -974,13 +1005,19 @@ struct timeval& rpr::Controller::stateError() {
 
     // Reset queues
     appQueue_.reset();
+    appRing_.reset();
     oooQueue_.clear();
     stQueue_.reset();
+    stRing_.reset();
 
     gettimeofday(&stTime_, NULL);
     return (tryPeriodD1_);
 }
 
+bool rpr::Controller::getLockFreeQueue() {
+    return lockFree_;
+}
+
 //! Set timeout for frame transmits in microseconds
 void rpr::Controller::setTimeout(uint32_t timeout) {
     div_t divResult  = div(timeout, 1000000);
@@ -35,15 +35,15 @@ namespace bp = boost::python;
 #endif
 
 //! Class creation
-rpr::ServerPtr rpr::Server::create(uint32_t segSize) {
-    rpr::ServerPtr r = std::make_shared<rpr::Server>(segSize);
+rpr::ServerPtr rpr::Server::create(uint32_t segSize, bool lockFree) {
+    rpr::ServerPtr r = std::make_shared<rpr::Server>(segSize, lockFree);
     return (r);
 }
 
 void rpr::Server::setup_python() {
 #ifndef NO_PYTHON
 
-    bp::class_<rpr::Server, rpr::ServerPtr, boost::noncopyable>("Server", bp::init<uint32_t>())
+    bp::class_<rpr::Server, rpr::ServerPtr, boost::noncopyable>("Server", bp::init<uint32_t, bp::optional<bool>>())
         .def("transport", &rpr::Server::transport)
         .def("application", &rpr::Server::application)
         .def("getOpen", &rpr::Server::getOpen)
@@ -70,6 +70,7 @@ void rpr::Server::setup_python() {
         .def("getLocMaxRetran", &rpr::Server::getLocMaxRetran)
         .def("setLocMaxCumAck", &rpr::Server::setLocMaxCumAck)
         .def("getLocMaxCumAck", &rpr::Server::getLocMaxCumAck)
+        .def("getLockFreeQueue", &rpr::Server::getLockFreeQueue)
         .def("curMaxBuffers", &rpr::Server::curMaxBuffers)
         .def("curMaxSegment", &rpr::Server::curMaxSegment)
         .def("curCumAckTout", &rpr::Server::curCumAckTout)
@@ -85,10 +86,10 @@ void rpr::Server::setup_python() {
 }
 
 //! Creator
-rpr::Server::Server(uint32_t segSize) {
+rpr::Server::Server(uint32_t segSize, bool lockFree) {
     app_  = rpr::Application::create();
     tran_ = rpr::Transport::create();
-    cntl_ = rpr::Controller::create(segSize, tran_, app_, true);
+    cntl_ = rpr::Controller::create(segSize, tran_, app_, true, lockFree);
 
     app_->setController(cntl_);
     tran_->setController(cntl_);
@@ -213,6 +214,10 @@ uint8_t rpr::Server::getLocMaxCumAck() {
     return cntl_->getLocMaxCumAck();
 }
 
+bool rpr::Server::getLockFreeQueue() {
+    return cntl_->getLockFreeQueue();
+}
+
 uint8_t rpr::Server::curMaxBuffers() {
     return cntl_->curMaxBuffers();
 }
@@ -149,6 +149,12 @@ void rpu::Client::acceptFrame(ris::FramePtr frame) {
         return;
     }
 
+    // Send multi-buffer frames with a single sendmmsg call
+    if (batchSize_ > 1 && frame->bufferCount() > 1) {
+        sendBatch(frame, "Client");
+        return;
+    }
+
     // Go through each buffer in the frame
     for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
         if ((*it)->getPayload() == 0) break;
@@ -190,6 +196,9 @@ void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
     int32_t res;
     struct timeval tout;
     uint32_t avail;
+    uint32_t batch;
+    uint32_t x;
+    std::vector<ris::FramePtr> frames;
 
     // Wait until constructor completes
     while (!lockPtr.expired()) continue;
@@ -200,23 +209,39 @@ void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
     frame = reqLocalFrame(maxPayload(), false);
 
     while (threadEn_) {
-        // Attempt receive
-        buff  = *(frame->beginBuffer());
-        avail = buff->getAvailable();
-        res   = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC, NULL, 0);
-
-        if (res > 0) {
-            // Message was too big
-            if (res > avail)
-                udpLog_->warning("Receive data was too large. Dropping.");
-            else {
-                buff->setPayload(res);
-                sendFrame(frame);
+        // Batched receive, fill up to batchSize_ frames per call
+        if ((batch = batchSize_) > 1) {
+            while (frames.size() < batch) frames.push_back(reqLocalFrame(maxPayload(), false));
+            frames.resize(batch);
+
+            if ((res = recvBatch(frames, NULL)) > 0) {
+                for (x = 0; x < (uint32_t)res; x++) {
+                    if (frames[x]->getPayload() > 0) sendFrame(frames[x]);
+                    frames[x] = reqLocalFrame(maxPayload(), false);
+                }
             }
 
-            // Get new frame
-            frame = reqLocalFrame(maxPayload(), false);
+        // Attempt receive
         } else {
+            buff  = *(frame->beginBuffer());
+            avail = buff->getAvailable();
+            res   = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC, NULL, 0);
+
+            if (res > 0) {
+                // Message was too big
+                if (res > avail)
+                    udpLog_->warning("Receive data was too large. Dropping.");
+                else {
+                    buff->setPayload(res);
+                    sendFrame(frame);
+                }
+
+                // Get new frame
+                frame = reqLocalFrame(maxPayload(), false);
+            }
+        }
+
+        if (res <= 0) {
             // Setup fds for select call
             FD_ZERO(&fds);
             FD_SET(fd_, &fds);
@@ -22,13 +22,19 @@
 #include "rogue/protocols/udp/Core.h"
 
 #include <inttypes.h>
+#include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "rogue/GeneralError.h"
 #include "rogue/Helpers.h"
 #include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Buffer.h"
+#include "rogue/interfaces/stream/Frame.h"
 
 namespace rpu = rogue::protocols::udp;
+namespace ris = rogue::interfaces::stream;
 
 #ifndef NO_PYTHON
 #include <boost/python.hpp>
@@ -37,8 +43,10 @@ namespace bp = boost::python;
 
 //! Creator
 rpu::Core::Core(bool jumbo) {
-    jumbo_ = jumbo;
+    jumbo_     = jumbo;
+    batchSize_ = 1;
     rogue::defaultTimeout(timeout_);
+    resetBatchCounters();
 }
 
 //! Destructor
@@ -78,11 +86,181 @@ void rpu::Core::setTimeout(uint32_t timeout) {
     timeout_.tv_usec = divResult.rem;
 }
 
+//! Set number of datagrams per receive and transmit call
+void rpu::Core::setBatchSize(uint32_t size) {
+    if (size == 0 || size > MaxBatchSize)
+        throw(rogue::GeneralError::create("Core::setBatchSize",
+                                          "Invalid batch size %" PRIu32 ", must be between 1 and %" PRIu32,
+                                          size,
+                                          MaxBatchSize));
+#ifdef __MACH__
+    if (size > 1) {
+        udpLog_->warning("Batched receive and transmit are not supported on this platform");
+        size = 1;
+    }
+#endif
+    batchSize_ = size;
+}
+
+//! Get number of datagrams per receive and transmit call
+uint32_t rpu::Core::getBatchSize() {
+    return batchSize_;
+}
+
+//! Get number of batched receive calls which returned data
+uint64_t rpu::Core::getRxBatchCount() {
+    return rxBatchCount_;
+}
+
+//! Get average number of datagrams returned per batched receive call
+double rpu::Core::getRxBatchAvg() {
+    uint64_t count = rxBatchCount_;
+    return (count == 0) ? 0.0 : (double)rxBatchTotal_ / (double)count;
+}
+
+//! Get number of batched transmit calls
+uint64_t rpu::Core::getTxBatchCount() {
+    return txBatchCount_;
+}
+
+//! Get average number of datagrams sent per batched transmit call
+double rpu::Core::getTxBatchAvg() {
+    uint64_t count = txBatchCount_;
+    return (count == 0) ? 0.0 : (double)txBatchTotal_ / (double)count;
+}
+
+//! Reset batch counters
+void rpu::Core::resetBatchCounters() {
+    rxBatchCount_ = 0;
+    rxBatchTotal_ = 0;
+    txBatchCount_ = 0;
+    txBatchTotal_ = 0;
+}
+
+//! Receive a batch of datagrams
+int32_t rpu::Core::recvBatch(std::vector<ris::FramePtr>& frames, struct sockaddr_in* addr) {
+#ifdef __MACH__
+    return 0;
+#else
+    ris::BufferPtr buff;
+    uint32_t count;
+    uint32_t x;
+    int32_t res;
+
+    count = frames.size();
+
+    if (rxMsgs_.size() < count) {
+        rxMsgs_.resize(count);
+        rxIovs_.resize(count);
+        rxAddrs_.resize(count);
+    }
+
+    for (x = 0; x < count; x++) {
+        buff = *(frames[x]->beginBuffer());
+
+        rxIovs_[x].iov_base = buff->begin();
+        rxIovs_[x].iov_len  = buff->getAvailable();
+
+        memset(&rxMsgs_[x], 0, sizeof(struct mmsghdr));
+        rxMsgs_[x].msg_hdr.msg_name    = &rxAddrs_[x];
+        rxMsgs_[x].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        rxMsgs_[x].msg_hdr.msg_iov     = &rxIovs_[x];
+        rxMsgs_[x].msg_hdr.msg_iovlen  = 1;
+    }
+
+    // Return immediately with whatever is queued in the socket
+    if ((res = recvmmsg(fd_, rxMsgs_.data(), count, MSG_DONTWAIT, NULL)) <= 0) return res;
+
+    for (x = 0; x < (uint32_t)res; x++) {
+        buff = *(frames[x]->beginBuffer());
+
+        // Message was too big
+        if (rxMsgs_[x].msg_hdr.msg_flags & MSG_TRUNC) {
+            udpLog_->warning("Receive data was too large. Dropping.");
+            buff->setPayload(0);
+        } else {
+            buff->setPayload(rxMsgs_[x].msg_len);
+        }
+    }
+
+    if (addr != NULL) *addr = rxAddrs_[res - 1];
+
+    rxBatchCount_++;
+    rxBatchTotal_ += res;
+    return res;
+#endif
+}
+
+//! Transmit all buffers of a frame with sendmmsg
+void rpu::Core::sendBatch(ris::FramePtr frame, const char* name) {
+#ifndef __MACH__
+    ris::Frame::BufferIterator it;
+    struct timeval tout;
+    uint32_t count;
+    uint32_t pos;
+    fd_set fds;
+    int32_t res;
+
+    if (txMsgs_.size() < frame->bufferCount()) {
+        txMsgs_.resize(frame->bufferCount());
+        txIovs_.resize(frame->bufferCount());
+    }
+
+    // Setup one message per buffer
+    count = 0;
+    for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
+        if ((*it)->getPayload() == 0) break;
+
+        txIovs_[count].iov_base = (*it)->begin();
+        txIovs_[count].iov_len  = (*it)->getPayload();
+
+        memset(&txMsgs_[count], 0, sizeof(struct mmsghdr));
+        txMsgs_[count].msg_hdr.msg_name    = &remAddr_;
+        txMsgs_[count].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        txMsgs_[count].msg_hdr.msg_iov     = &txIovs_[count];
+        txMsgs_[count].msg_hdr.msg_iovlen  = 1;
+        ++count;
+    }
+
+    pos = 0;
+    while (pos < count) {
+        // Setup fds for select call
+        FD_ZERO(&fds);
+        FD_SET(fd_, &fds);
+
+        // Setup select timeout
+        tout = timeout_;
+
+        if (select(fd_ + 1, NULL, &fds, NULL, &tout) <= 0) {
+            udpLog_->critical("%s::acceptFrame: Timeout waiting for outbound transmit after %" PRIuLEAST32
+                              ".%" PRIuLEAST32 " seconds! May be caused by outbound backpressure.",
+                              name,
+                              timeout_.tv_sec,
+                              timeout_.tv_usec);
+        } else if ((res = sendmmsg(fd_, &txMsgs_[pos], std::min(count - pos, (uint32_t)batchSize_), 0)) < 0) {
+            udpLog_->warning("UDP Write Call Failed");
+            ++pos;  // Skip the failed datagram, matching the single send path
+        } else {
+            pos += res;
+            txBatchCount_++;
+            txBatchTotal_ += res;
+        }
+    }
+#endif
+}
+
 void rpu::Core::setup_python() {
 #ifndef NO_PYTHON
     bp::class_<rpu::Core, rpu::CorePtr, boost::noncopyable>("Core", bp::no_init)
         .def("maxPayload", &rpu::Core::maxPayload)
         .def("setRxBufferCount", &rpu::Core::setRxBufferCount)
-        .def("setTimeout", &rpu::Core::setTimeout);
+        .def("setTimeout", &rpu::Core::setTimeout)
+        .def("setBatchSize", &rpu::Core::setBatchSize)
+        .def("getBatchSize", &rpu::Core::getBatchSize)
+        .def("getRxBatchCount", &rpu::Core::getRxBatchCount)
+        .def("getRxBatchAvg", &rpu::Core::getRxBatchAvg)
+        .def("getTxBatchCount", &rpu::Core::getTxBatchCount)
+        .def("getTxBatchAvg", &rpu::Core::getTxBatchAvg)
+        .def("resetBatchCounters", &rpu::Core::resetBatchCounters);
 #endif
 }
@@ -141,6 +141,12 @@ void rpu::Server::acceptFrame(ris::FramePtr frame) {
         return;
     }
 
+    // Send multi-buffer frames with a single sendmmsg call
+    if (batchSize_ > 1 && frame->bufferCount() > 1) {
+        sendBatch(frame, "Server");
+        return;
+    }
+
     // Setup message header
     msg.msg_name       = &remAddr_;
     msg.msg_namelen    = sizeof(struct sockaddr_in);
@@ -193,6 +199,9 @@ void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
     struct sockaddr_in tmpAddr;
     uint32_t tmpLen;
     uint32_t avail;
+    uint32_t batch;
+    uint32_t x;
+    std::vector<ris::FramePtr> frames;
 
     // Wait until constructor completes
     while (!lockPtr.expired()) continue;
@@ -203,24 +212,40 @@ void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
     frame = reqLocalFrame(maxPayload(), false);
 
     while (threadEn_) {
-        // Attempt receive
-        buff   = *(frame->beginBuffer());
-        avail  = buff->getAvailable();
-        tmpLen = sizeof(struct sockaddr_in);
-        res    = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC, (struct sockaddr*)&tmpAddr, &tmpLen);
-
-        if (res > 0) {
-            // Message was too big
-            if (res > avail)
-                udpLog_->warning("Receive data was too large. Dropping.");
-            else {
-                buff->setPayload(res);
-                sendFrame(frame);
+        // Batched receive, fill up to batchSize_ frames per call
+        if ((batch = batchSize_) > 1) {
+            while (frames.size() < batch) frames.push_back(reqLocalFrame(maxPayload(), false));
+            frames.resize(batch);
+
+            if ((res = recvBatch(frames, &tmpAddr)) > 0) {
+                for (x = 0; x < (uint32_t)res; x++) {
+                    if (frames[x]->getPayload() > 0) sendFrame(frames[x]);
+                    frames[x] = reqLocalFrame(maxPayload(), false);
+                }
             }
 
-            // Get new frame
-            frame = reqLocalFrame(maxPayload(), false);
+        // Attempt receive
+        } else {
+            buff   = *(frame->beginBuffer());
+            avail  = buff->getAvailable();
+            tmpLen = sizeof(struct sockaddr_in);
+            res    = recvfrom(fd_, buff->begin(), avail, MSG_TRUNC, (struct sockaddr*)&tmpAddr, &tmpLen);
+
+            if (res > 0) {
+                // Message was too big
+                if (res > avail)
+                    udpLog_->warning("Receive data was too large. Dropping.");
+                else {
+                    buff->setPayload(res);
+                    sendFrame(frame);
+                }
+
+                // Get new frame
+                frame = reqLocalFrame(maxPayload(), false);
+            }
+        }
 
+        if (res > 0) {
             // Lock before updating address
             if (memcmp(&remAddr_, &tmpAddr, sizeof(remAddr_)) != 0) {
                 std::lock_guard<std::mutex> lock(udpMtx_);
@@ -29,6 +29,8 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <exception>
 #include <memory>
 
 #include "rogue/GeneralError.h"
@@ -57,13 +59,13 @@ ru::PrbsPtr ru::Prbs::create() {
 
 //! Creator with default taps and size
 ru::Prbs::Prbs() {
-    txThread_   = NULL;
     rxSeq_      = 0;
     rxErrCount_ = 0;
     rxCount_    = 0;
     rxBytes_    = 0;
     rxEnable_   = true;
     txSeq_      = 0;
+    txSend_     = 0;
     txSize_     = 0;
     txErrCount_ = 0;
     txCount_    = 0;
@@ -79,6 +81,8 @@ ru::Prbs::Prbs() {
     minSize_   = 12;
     sendCount_ = false;
 
+    txThreadCount_ = 1;
+
     // Init 4 taps
     tapCnt_  = 4;
     taps_    = (uint8_t*)malloc(sizeof(uint8_t) * tapCnt_);
@@ -177,32 +181,13 @@ void ru::Prbs::sendCount(bool state) {
     sendCount_ = state;
 }
 
-void ru::Prbs::flfsr(uint8_t* data) {
-    uint32_t iByte;
-    uint32_t iBit;
-    uint32_t x;
-    bool msbOut;
-    bool lsbIn = false;
-
-    for (x = 0; x < tapCnt_; x++) {
-        iByte = taps_[x] / 8;
-        iBit  = taps_[x] % 8;
-        lsbIn ^= ((data[iByte] >> iBit) & 0x1);
-    }
-
-    for (x = 0; x < byteWidth_; x++) {
-        msbOut = data[x] & 0x80;
-        data[x] <<= 1;
-        data[x] |= lsbIn;
-        lsbIn = msbOut;
-    }
-}
-
 //! Thread background
 void ru::Prbs::runThread() {
+    ru::PrbsEngine eng;
+
     txLog_->logThreadId();
 
-    while (threadEn_) { genFrame(txSize_); }
+    while (threadEn_) { txFrame(txSize_, eng); }
 }
 
 //! Auto run data generation
@@ -210,29 +195,56 @@ void ru::Prbs::enable(uint32_t size) {
     // Verify size first
     if (((size % byteWidth_) != 0) || size < minSize_) throw rogue::GeneralError("Prbs::enable", "Invalid frame size");
 
-    if (txThread_ == NULL) {
+    if (txThreads_.empty()) {
         txSize_   = size;
         threadEn_ = true;
-        txThread_ = new std::thread(&Prbs::runThread, this);
 
-        // Set a thread name
+        for (uint32_t x = 0; x < txThreadCount_; x++) {
+            std::thread* thread = new std::thread(&Prbs::runThread, this);
+            txThreads_.push_back(thread);
+
+            // Set a thread name
 #ifndef __MACH__
-        pthread_setname_np(txThread_->native_handle(), "PrbsTx");
+            pthread_setname_np(thread->native_handle(), "PrbsTx");
 #endif
+        }
     }
 }
 
 //! Disable auto generation
 void ru::Prbs::disable() {
-    if (txThread_ != NULL) {
+    std::vector<std::thread*>::iterator it;
+
+    if (!txThreads_.empty()) {
         rogue::GilRelease noGil;
         threadEn_ = false;
-        txThread_->join();
-        delete txThread_;
-        txThread_ = NULL;
+
+        for (it = txThreads_.begin(); it != txThreads_.end(); ++it) {
+            (*it)->join();
+            delete (*it);
+        }
+        txThreads_.clear();
     }
 }
 
+//! Set the number of auto generation threads
+void ru::Prbs::setTxThreads(uint32_t count) {
+    if (count == 0) throw(rogue::GeneralError("Prbs::setTxThreads", "Thread count must be at least 1"));
+
+    if (txThreads_.empty()) {
+        txThreadCount_ = count;
+    } else {
+        disable();
+        txThreadCount_ = count;
+        enable(txSize_);
+    }
+}
+
+//! Get the number of auto generation threads
+uint32_t ru::Prbs::getTxThreads() {
+    return txThreadCount_;
+}
+
 //! Get rx enable
 bool ru::Prbs::getRxEnable() {
     return rxEnable_;
@@ -309,82 +321,128 @@ void ru::Prbs::genPayload(bool state) {
 //! Reset counters
 // Counters should really be locked!
 void ru::Prbs::resetCount() {
-    pMtx_.lock();
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(pMtx_);
+    std::lock_guard<std::mutex> txLock(txMtx_);
+
     txErrCount_ = 0;
     txCount_    = 0;
     txBytes_    = 0;
     rxErrCount_ = 0;
     rxCount_    = 0;
     rxBytes_    = 0;
-    pMtx_.unlock();
 }
 
 //! Generate a data frame
 void ru::Prbs::genFrame(uint32_t size) {
+    ru::PrbsEngine eng;
+    txFrame(size, eng);
+}
+
+//! Generate a data frame with the passed payload engine
+void ru::Prbs::txFrame(uint32_t size, ru::PrbsEngine& eng) {
     ris::FrameIterator frIter;
     ris::FrameIterator frEnd;
     uint32_t frSeq[MaxBytes / 4];
     uint32_t frSize[MaxBytes / 4];
     uint32_t wCount[MaxBytes / 4];
     uint8_t data[MaxBytes];
+    uint32_t byteWidth;
+    uint32_t rem;
+    uint32_t n;
+    bool sendCount;
+    bool genPl;
     double per;
     ris::FramePtr fr;
+    std::exception_ptr err;
 
     rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(pMtx_);
 
-    // Verify size first
-    if (((size % byteWidth_) != 0) || size < minSize_)
-        throw rogue::GeneralError("Prbs::genFrame", "Invalid frame size");
+    {
+        std::lock_guard<std::mutex> lock(pMtx_);
+
+        // Verify size first
+        if (((size % byteWidth_) != 0) || size < minSize_)
+            throw rogue::GeneralError("Prbs::genFrame", "Invalid frame size");
+
+        byteWidth = byteWidth_;
+        sendCount = sendCount_;
+        genPl     = genPl_;
+        eng.setup(width_, tapCnt_, taps_);
+
+        // Setup sequence
+        memset(frSeq, 0, MaxBytes);
+        frSeq[0] = txSeq_++;
+    }
 
     // Setup size
     memset(frSize, 0, MaxBytes);
-    frSize[0] = (size / byteWidth_) - 1;
-
-    // Setup sequence
-    memset(frSeq, 0, MaxBytes);
-    frSeq[0] = txSeq_;
+    frSize[0] = (size / byteWidth) - 1;
 
     // Setup counter
     memset(wCount, 0, MaxBytes);
 
-    // Get frame
-    fr = reqFrame(size, true);
-    fr->setPayload(size);
+    // Payloads are generated outside of the lock, a failed frame still gives up its turn below
+    try {
+        // Get frame
+        fr = reqFrame(size, true);
+        fr->setPayload(size);
 
-    frIter = fr->begin();
-    frEnd  = frIter + size;
+        frIter = fr->begin();
+        frEnd  = frIter + size;
 
-    // First word is sequence
-    ris::toFrame(frIter, byteWidth_, frSeq);
-    ++wCount[0];
+        // First word is sequence
+        ris::toFrame(frIter, byteWidth, frSeq);
+        ++wCount[0];
 
-    // Second word is size
-    ris::toFrame(frIter, byteWidth_, frSize);
-    ++wCount[0];
-
-    if (genPl_) {
-        // Init data
-        std::memcpy(data, frSeq, byteWidth_);
+        // Second word is size
+        ris::toFrame(frIter, byteWidth, frSize);
+        ++wCount[0];
 
         // Generate payload
-        while (frIter != frEnd) {
-            if (sendCount_)
-                ris::toFrame(frIter, byteWidth_, wCount);
-            else {
-                flfsr(data);
-                ris::toFrame(frIter, byteWidth_, data);
+        if (genPl && sendCount) {
+            while (frIter != frEnd) {
+                ris::toFrame(frIter, byteWidth, wCount);
+                ++wCount[0];
+            }
+        } else if (genPl) {
+            eng.seed(reinterpret_cast<uint8_t*>(frSeq));
+
+            // Fill whole buffers, a word spanning buffers is generated on its own
+            while (frIter != frEnd) {
+                rem = std::min(frIter.remBuffer(), (uint32_t)(frEnd - frIter));
+
+                if (rem >= byteWidth) {
+                    n = rem / byteWidth;
+                    eng.fill(frIter.ptr(), n);
+                    frIter += n * byteWidth;
+                } else {
+                    eng.fill(data, 1);
+                    ris::toFrame(frIter, byteWidth, data);
+                }
             }
-            ++wCount[0];
         }
+    } catch (...) {
+        fr.reset();
+        err = std::current_exception();
     }
 
-    sendFrame(fr);
+    // Frames are sent in sequence order
+    std::unique_lock<std::mutex> lock(txMtx_);
+    while (txSend_ != frSeq[0]) txCond_.wait(lock);
+
+    if (fr) {
+        try {
+            sendFrame(fr);
+
+            // Update counters
+            txCount_++;
+            txBytes_ += size;
+        } catch (...) { err = std::current_exception(); }
+    }
 
-    // Update counters
-    txSeq_++;
-    txCount_++;
-    txBytes_ += size;
+    txSend_++;
+    txCond_.notify_all();
 
     if ((per = updateTime(&lastTxTime_)) > 0.0) {
         txRate_      = (float)(txCount_ - lastTxCount_) / per;
@@ -392,6 +450,9 @@ void ru::Prbs::genFrame(uint32_t size) {
         lastTxCount_ = txCount_;
         lastTxBytes_ = txBytes_;
     }
+    lock.unlock();
+
+    if (err) std::rethrow_exception(err);
 }
 
 //! Accept a frame from master
@@ -404,11 +465,14 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
     uint32_t expSize;
     uint32_t size;
     uint32_t pos;
+    uint32_t rem;
+    uint32_t n;
     uint32_t x;
     uint8_t expData[MaxBytes];
+    uint8_t gotData[MaxBytes];
+    uint8_t expBuff[CheckBytes];
+    uint8_t* got;
     double per;
-    char debugA[10000];
-    char debugB[1000];
 
     rogue::GilRelease noGil;
 
@@ -463,34 +527,36 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
     // Is payload checking enabled
     if (checkPl_) {
         // Init data
-        std::memcpy(expData, frSeq, byteWidth_);
+        rxEng_.setup(width_, tapCnt_, taps_);
+        rxEng_.seed(reinterpret_cast<uint8_t*>(frSeq));
         pos = 0;
 
-        // Read payload
+        // Compare whole buffers, a word spanning buffers is compared on its own
         while (frIter != frEnd) {
-            flfsr(expData);
-
-            if (!std::equal(frIter, frIter + byteWidth_, expData)) {
-                sprintf(debugA,
-                        "Bad value at index %" PRIu32 ". count=%" PRIu32 ", size=%" PRIu32,
-                        pos,
-                        rxCount_,
-                        (size / byteWidth_) - 1);
-                for (x = 0; x < byteWidth_; x++) {
-                    sprintf(debugB,
-                            "\n   %" PRIu32 ":%" PRIu32 " Got=0x%" PRIx8 " Exp=0x%" PRIx8,
-                            pos,
-                            x,
-                            *(frIter + x),
-                            *(expData + x));
-                    strcat(debugA, debugB);
+            rem = std::min(frIter.remBuffer(), (uint32_t)(frEnd - frIter));
+
+            if (rem >= byteWidth_) {
+                n   = std::min(rem, (uint32_t)CheckBytes) / byteWidth_;
+                got = frIter.ptr();
+                rxEng_.fill(expBuff, n);
+
+                if (memcmp(got, expBuff, n * byteWidth_) != 0) {
+                    for (x = 0; memcmp(got + x * byteWidth_, expBuff + x * byteWidth_, byteWidth_) == 0; x++) {}
+                    payloadError(pos + x, size, got + x * byteWidth_, expBuff + x * byteWidth_);
+                    return;
+                }
+                frIter += n * byteWidth_;
+                pos += n;
+            } else {
+                rxEng_.fill(expData, 1);
+                ris::fromFrame(frIter, byteWidth_, gotData);
+
+                if (memcmp(gotData, expData, byteWidth_) != 0) {
+                    payloadError(pos, size, gotData, expData);
+                    return;
                 }
-                rxLog_->warning(debugA);
-                rxErrCount_++;
-                return;
+                ++pos;
             }
-            frIter += byteWidth_;
-            ++pos;
         }
     }
 
@@ -505,6 +571,25 @@ void ru::Prbs::acceptFrame(ris::FramePtr frame) {
     }
 }
 
+//! Log a payload mismatch
+void ru::Prbs::payloadError(uint32_t pos, uint32_t size, const uint8_t* got, const uint8_t* exp) {
+    char debugA[10000];
+    char debugB[1000];
+    uint32_t x;
+
+    sprintf(debugA,
+            "Bad value at index %" PRIu32 ". count=%" PRIu32 ", size=%" PRIu32,
+            pos,
+            rxCount_,
+            (size / byteWidth_) - 1);
+    for (x = 0; x < byteWidth_; x++) {
+        sprintf(debugB, "\n   %" PRIu32 ":%" PRIu32 " Got=0x%" PRIx8 " Exp=0x%" PRIx8, pos, x, got[x], exp[x]);
+        strcat(debugA, debugB);
+    }
+    rxLog_->warning(debugA);
+    rxErrCount_++;
+}
+
 void ru::Prbs::setup_python() {
 #ifndef NO_PYTHON
 
@@ -512,6 +597,8 @@ void ru::Prbs::setup_python() {
         .def("genFrame", &ru::Prbs::genFrame)
         .def("enable", &ru::Prbs::enable)
         .def("disable", &ru::Prbs::disable)
+        .def("setTxThreads", &ru::Prbs::setTxThreads)
+        .def("getTxThreads", &ru::Prbs::getTxThreads)
         .def("setWidth", &ru::Prbs::setWidth)
         .def("setTaps", &ru::Prbs::setTaps)
         .def("getRxEnable", &ru::Prbs::getRxEnable)
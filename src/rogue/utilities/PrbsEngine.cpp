@@ -0,0 +1,269 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title      : Word Parallel PRBS Engine
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/utilities/PrbsEngine.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define ROGUE_PRBS_X86
+#endif
+
+namespace ru = rogue::utilities;
+
+// Blocks hold the sequence with the newest bit at bit 0, older bits continue
+// into the previous block at blk[-1]. Word x of a run starts at bit i - x of
+// blk[0] and the 64-bit words of wider data start in the previous blocks.
+namespace {
+
+inline uint64_t window(const uint64_t* blk, uint32_t shift) {
+    return (blk[0] >> shift) | ((blk[-1] << 1) << (63 - shift));
+}
+
+void extractDefault(uint8_t* dst, const uint64_t* blk, uint32_t i, uint32_t count, uint32_t byteWidth) {
+    uint32_t full = byteWidth / 8;
+    uint32_t half = byteWidth % 8;
+    uint32_t shift;
+    uint32_t x;
+    uint32_t l;
+    uint64_t v;
+
+    for (x = 0; x < count; x++) {
+        shift = i - x;
+
+        for (l = 0; l < full; l++) {
+            v = window(blk - l, shift);
+            memcpy(dst, &v, 8);
+            dst += 8;
+        }
+
+        if (half != 0) {
+            v = window(blk - full, shift);
+            memcpy(dst, &v, half);
+            dst += half;
+        }
+    }
+}
+
+#ifdef ROGUE_PRBS_X86
+// Four words per step for 32 and 64 bit widths
+__attribute__((target("avx2"))) void extractAvx2(uint8_t* dst,
+                                                 const uint64_t* blk,
+                                                 uint32_t i,
+                                                 uint32_t count,
+                                                 uint32_t byteWidth) {
+    if (byteWidth == 4 || byteWidth == 8) {
+        __m256i lo    = _mm256_set1_epi64x((int64_t)blk[0]);
+        __m256i hi    = _mm256_set1_epi64x((int64_t)(blk[-1] << 1));
+        __m256i c63   = _mm256_set1_epi64x(63);
+        __m256i step  = _mm256_set1_epi64x(4);
+        __m256i pack  = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+        __m256i shift = _mm256_setr_epi64x(i, i - 1, i - 2, i - 3);
+        __m256i v;
+
+        while (count >= 4) {
+            v = _mm256_or_si256(_mm256_srlv_epi64(lo, shift), _mm256_sllv_epi64(hi, _mm256_sub_epi64(c63, shift)));
+
+            if (byteWidth == 8) {
+                _mm256_storeu_si256((__m256i*)dst, v);
+            } else {
+                v = _mm256_permutevar8x32_epi32(v, pack);
+                _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(v));
+            }
+
+            shift = _mm256_sub_epi64(shift, step);
+            dst += 4 * byteWidth;
+            count -= 4;
+            i -= 4;
+        }
+
+        // The remainder and the caller use SSE
+        _mm256_zeroupper();
+    }
+    extractDefault(dst, blk, i, count, byteWidth);
+}
+#endif
+
+typedef void (*ExtractFunc)(uint8_t*, const uint64_t*, uint32_t, uint32_t, uint32_t);
+
+// Select the extract routine for the running CPU
+ExtractFunc selectExtract() {
+#ifdef ROGUE_PRBS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return extractAvx2;
+#endif
+    return extractDefault;
+}
+}  // namespace
+
+//! Create an engine with the default 32-bit width and taps
+ru::PrbsEngine::PrbsEngine() {
+    uint8_t taps[4] = {1, 2, 6, 31};
+
+    width_ = 0;
+    setup(32, 4, taps);
+}
+
+//! Set the width and taps
+void ru::PrbsEngine::setup(uint32_t width, uint32_t tapCnt, const uint8_t* taps) {
+    uint64_t mask[MaxLimbs];
+    uint8_t zero[MaxLimbs * 8];
+    uint32_t limbs;
+    uint32_t tMax;
+    uint32_t x;
+
+    // Repeated taps cancel as they do in the feedback XOR
+    memset(mask, 0, sizeof(mask));
+    for (x = 0; x < tapCnt; x++)
+        if (taps[x] < width) mask[taps[x] / 64] ^= 1ULL << (taps[x] % 64);
+
+    if (width == width_ && memcmp(mask, tapMask_, sizeof(mask)) == 0) return;
+
+    width_     = width;
+    byteWidth_ = width / 8;
+    memcpy(tapMask_, mask, sizeof(mask));
+
+    taps_.clear();
+    for (x = 0; x < width; x++)
+        if ((mask[x / 64] >> (x % 64)) & 1) taps_.push_back(x);
+
+    limbs = (width + 63) / 64;
+    tMax  = taps_.empty() ? 0 : taps_.back();
+
+    // Block m holds sequence bits 64 * (m - limbs) + 1 to 64 * (m - limbs + 1),
+    // the seed is held in the blocks before. The polynomial step holds once the
+    // sequence is 63 * (tMax + 1) bits past the seed.
+    polyBlock_ = tMax + 2 + limbs;
+    hist_      = std::max(tMax + 1, limbs) + 1;
+
+    blk_.assign(std::max(polyBlock_, (uint64_t)hist_) + ChunkBlocks, 0);
+    genTables();
+
+    memset(zero, 0, sizeof(zero));
+    seed(zero);
+}
+
+//! Build the tables
+void ru::PrbsEngine::genTables() {
+    std::vector<uint64_t> basis(width_);
+    uint32_t limbs = (width_ + 63) / 64;
+    uint64_t top   = (width_ % 64) ? 0xFFFFFFFFULL : ~0ULL;
+    uint64_t state[MaxLimbs];
+    uint64_t fb;
+    uint32_t val;
+    uint32_t x;
+    uint32_t r;
+    uint32_t l;
+
+    // Next 64 bits from each single bit state, the first bit is the block MSB
+    for (x = 0; x < width_; x++) {
+        memset(state, 0, sizeof(state));
+        state[x / 64] = 1ULL << (x % 64);
+
+        for (r = 1; r <= 64; r++) {
+            fb = 0;
+            for (l = 0; l < limbs; l++) fb ^= state[l] & tapMask_[l];
+            fb = __builtin_parityll(fb);
+
+            for (l = limbs - 1; l > 0; l--) state[l] = (state[l] << 1) | (state[l - 1] >> 63);
+            state[0] = (state[0] << 1) | fb;
+            state[limbs - 1] &= top;
+
+            basis[x] |= fb << (64 - r);
+        }
+    }
+
+    // Each entry adds one bit to an earlier one
+    table_.assign(byteWidth_ * 256, 0);
+    for (x = 0; x < byteWidth_; x++) {
+        for (val = 1; val < 256; val++)
+            table_[x * 256 + val] = table_[x * 256 + (val & (val - 1))] ^ basis[x * 8 + __builtin_ctz(val)];
+    }
+}
+
+//! Start a sequence
+void ru::PrbsEngine::seed(const uint8_t* data) {
+    uint32_t limbs = (width_ + 63) / 64;
+    uint32_t l;
+    uint64_t v;
+
+    // The newest seed bit is the LSB of the block before the sequence
+    for (l = 0; l < limbs; l++) {
+        v = 0;
+        memcpy(&v, data + l * 8, std::min(8U, byteWidth_ - l * 8));
+        blk_[limbs - 1 - l] = v;
+    }
+
+    base_ = 0;
+    next_ = limbs;
+    word_ = 1;
+}
+
+//! Generate the next block
+void ru::PrbsEngine::genBlock() {
+    std::vector<uint32_t>::iterator it;
+    uint64_t* cur;
+    uint64_t v;
+    uint32_t x;
+
+    // Move the history to the front of the buffer
+    if (next_ - base_ == blk_.size()) {
+        memmove(blk_.data(), blk_.data() + (next_ - hist_ - base_), hist_ * sizeof(uint64_t));
+        base_ = next_ - hist_;
+    }
+
+    cur = blk_.data() + (next_ - base_);
+    v   = 0;
+
+    // The state is the previous width bits, newest at bit 0
+    if (next_ < polyBlock_) {
+        for (x = 0; x < byteWidth_; x++) v ^= table_[x * 256 + ((cur[-1 - (int64_t)(x / 8)] >> ((x % 8) * 8)) & 0xFF)];
+    } else {
+        for (it = taps_.begin(); it != taps_.end(); ++it) v ^= cur[-1 - (int64_t)*it];
+    }
+
+    *cur = v;
+    next_++;
+}
+
+//! Generate the next words of the sequence
+void ru::PrbsEngine::fill(uint8_t* dst, uint32_t count) {
+    static const ExtractFunc func = selectExtract();
+    uint64_t origin = ((width_ + 63) / 64) * 64 - 1;
+    uint64_t q;
+    uint64_t m;
+    uint32_t i;
+    uint32_t n;
+
+    while (count > 0) {
+        q = word_ + origin;
+        m = q / 64;
+        i = 63 - (q % 64);
+
+        if (m == next_) genBlock();
+
+        n = std::min(count, i + 1);
+        func(dst, blk_.data() + (m - base_), i, n, byteWidth_);
+
+        dst += n * byteWidth_;
+        count -= n;
+        word_ += n;
+    }
+}
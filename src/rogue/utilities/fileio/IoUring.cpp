@@ -0,0 +1,279 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : io_uring submission helper.
+ * ----------------------------------------------------------------------------
+ * File          : IoUring.cpp
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Minimal wrapper around the Linux io_uring interface used by the file
+ *    reader and writer to keep multiple reads or writes in flight.
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/utilities/fileio/IoUring.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <memory>
+
+#include "rogue/GeneralError.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <linux/version.h>
+#include <sys/syscall.h>
+// IORING_OP_READ and IORING_OP_WRITE were added in 5.6
+#if defined(__NR_io_uring_setup) && LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+#define ROGUE_IO_URING
+#endif
+#endif
+#endif
+
+namespace ruf = rogue::utilities::fileio;
+
+//! Return true if io_uring is supported by this build and the running kernel
+bool ruf::IoUring::isSupported() {
+#ifdef ROGUE_IO_URING
+    static int32_t supported = -1;
+
+    if (supported < 0) {
+        try {
+            ruf::IoUring ring(2);
+            supported = 1;
+        } catch (rogue::GeneralError& e) {
+            supported = 0;
+        }
+    }
+    return (supported == 1);
+#else
+    return false;
+#endif
+}
+
+//! Class creation
+ruf::IoUringPtr ruf::IoUring::create(uint32_t depth) {
+    ruf::IoUringPtr r = std::make_shared<ruf::IoUring>(depth);
+    return (r);
+}
+
+//! Creator
+ruf::IoUring::IoUring(uint32_t depth) {
+    fd_         = -1;
+    sqMap_      = MAP_FAILED;
+    cqMap_      = MAP_FAILED;
+    sqes_       = MAP_FAILED;
+    sqMapSize_  = 0;
+    cqMapSize_  = 0;
+    sqesSize_   = 0;
+    depth_      = 0;
+    toSubmit_   = 0;
+    registered_ = false;
+
+#ifdef ROGUE_IO_URING
+    struct io_uring_params p;
+    uint8_t* sq;
+    uint8_t* cq;
+
+    memset(&p, 0, sizeof(p));
+
+    if ((fd_ = syscall(__NR_io_uring_setup, depth, &p)) < 0)
+        throw(rogue::GeneralError::create("IoUring::IoUring", "Failed to create ring. Errno = %" PRIi32, errno));
+
+    sqMapSize_ = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    cqMapSize_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    sqesSize_  = p.sq_entries * sizeof(struct io_uring_sqe);
+
+    // Kernel may provide both rings in a single mapping
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (cqMapSize_ > sqMapSize_) sqMapSize_ = cqMapSize_;
+        cqMapSize_ = sqMapSize_;
+    }
+
+    sqMap_ = mmap(NULL, sqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+
+    if (sqMap_ != MAP_FAILED && (p.features & IORING_FEAT_SINGLE_MMAP) == 0)
+        cqMap_ = mmap(NULL, cqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+    else
+        cqMap_ = sqMap_;
+
+    if (sqMap_ != MAP_FAILED && cqMap_ != MAP_FAILED)
+        sqes_ = mmap(NULL, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+
+    if (sqes_ == MAP_FAILED) {
+        release();
+        throw(rogue::GeneralError::create("IoUring::IoUring", "Failed to map ring. Errno = %" PRIi32, errno));
+    }
+
+    sq       = (uint8_t*)sqMap_;
+    cq       = (uint8_t*)cqMap_;
+    sqHead_  = (uint32_t*)(sq + p.sq_off.head);
+    sqTail_  = (uint32_t*)(sq + p.sq_off.tail);
+    sqMask_  = (uint32_t*)(sq + p.sq_off.ring_mask);
+    sqArray_ = (uint32_t*)(sq + p.sq_off.array);
+    cqHead_  = (uint32_t*)(cq + p.cq_off.head);
+    cqTail_  = (uint32_t*)(cq + p.cq_off.tail);
+    cqMask_  = (uint32_t*)(cq + p.cq_off.ring_mask);
+    cqes_    = (void*)(cq + p.cq_off.cqes);
+    depth_   = p.sq_entries;
+#else
+    throw(rogue::GeneralError("IoUring::IoUring", "io_uring is not supported on this platform"));
+#endif
+}
+
+//! Deconstructor
+ruf::IoUring::~IoUring() {
+    release();
+}
+
+//! Unmap rings and close descriptor
+void ruf::IoUring::release() {
+    if (sqes_ != MAP_FAILED) munmap(sqes_, sqesSize_);
+    if (cqMap_ != MAP_FAILED && cqMap_ != sqMap_) munmap(cqMap_, cqMapSize_);
+    if (sqMap_ != MAP_FAILED) munmap(sqMap_, sqMapSize_);
+    if (fd_ >= 0) ::close(fd_);
+
+    sqes_  = MAP_FAILED;
+    cqMap_ = MAP_FAILED;
+    sqMap_ = MAP_FAILED;
+    fd_    = -1;
+}
+
+//! Get ring depth
+uint32_t ruf::IoUring::depth() {
+    return depth_;
+}
+
+//! Register fixed buffers, returns false if registration failed
+bool ruf::IoUring::registerBuffers(struct iovec* iov, uint32_t count) {
+#ifdef ROGUE_IO_URING
+    // Locked memory limits may prevent registration, unregistered operations are used instead
+    registered_ = (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, iov, count) == 0);
+#endif
+    return registered_;
+}
+
+//! Queue a read or write
+bool ruf::IoUring::queue(uint8_t op,
+                         int32_t fd,
+                         void* data,
+                         uint32_t size,
+                         uint64_t offset,
+                         int32_t index,
+                         uint64_t tag) {
+#ifdef ROGUE_IO_URING
+    struct io_uring_sqe* sqe;
+    uint32_t tail;
+    uint32_t idx;
+
+    tail = *sqTail_;
+
+    // Ring is full
+    if ((tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE)) >= depth_) return false;
+
+    idx = tail & *sqMask_;
+    sqe = &((struct io_uring_sqe*)sqes_)[idx];
+
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode    = op;
+    sqe->fd        = fd;
+    sqe->off       = offset;
+    sqe->addr      = (uint64_t)(uintptr_t)data;
+    sqe->len       = size;
+    sqe->user_data = tag;
+
+    if (registered_ && index >= 0) {
+        sqe->opcode    = (op == IORING_OP_WRITE) ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->buf_index = index;
+    }
+
+    sqArray_[idx] = idx;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    toSubmit_++;
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! Queue a write, index is the registered buffer index or -1
+bool ruf::IoUring::write(int32_t fd, void* data, uint32_t size, uint64_t offset, int32_t index, uint64_t tag) {
+#ifdef ROGUE_IO_URING
+    return queue(IORING_OP_WRITE, fd, data, size, offset, index, tag);
+#else
+    return false;
+#endif
+}
+
+//! Queue a read, index is the registered buffer index or -1
+bool ruf::IoUring::read(int32_t fd, void* data, uint32_t size, uint64_t offset, int32_t index, uint64_t tag) {
+#ifdef ROGUE_IO_URING
+    return queue(IORING_OP_READ, fd, data, size, offset, index, tag);
+#else
+    return false;
+#endif
+}
+
+//! Submit queued entries to the kernel
+void ruf::IoUring::submit() {
+#ifdef ROGUE_IO_URING
+    int32_t ret;
+
+    while (toSubmit_ > 0) {
+        ret = syscall(__NR_io_uring_enter, fd_, toSubmit_, 0, 0, NULL, 0);
+
+        if (ret > 0)
+            toSubmit_ -= ret;
+        else if (ret == 0 || (errno != EINTR && errno != EAGAIN && errno != EBUSY))
+            break;
+    }
+#endif
+}
+
+//! Get a completion, optionally blocking until one is available
+bool ruf::IoUring::complete(uint64_t& tag, int32_t& result, bool wait) {
+#ifdef ROGUE_IO_URING
+    struct io_uring_cqe* cqe;
+    uint32_t head;
+    int32_t ret;
+
+    for (;;) {
+        head = *cqHead_;
+
+        if (head != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+            cqe    = &((struct io_uring_cqe*)cqes_)[head & *cqMask_];
+            tag    = cqe->user_data;
+            result = cqe->res;
+            __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        if (!wait) return false;
+
+        // Submit anything pending and wait for a completion
+        ret = syscall(__NR_io_uring_enter, fd_, toSubmit_, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+
+        if (ret > 0)
+            toSubmit_ -= ret;
+        else if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            return false;
+    }
+#else
+    return false;
+#endif
+}
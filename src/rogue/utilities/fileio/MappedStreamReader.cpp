@@ -0,0 +1,518 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Title         : Indexed data file reader utility.
+ * ----------------------------------------------------------------------------
+ * File          : MappedStreamReader.cpp
+ *-----------------------------------------------------------------------------
+ * Description :
+ *    Class to read data files written by StreamWriter with random access.
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/utilities/fileio/MappedStreamReader.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/interfaces/stream/Buffer.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/FrameIterator.h"
+
+namespace ris = rogue::interfaces::stream;
+namespace ruf = rogue::utilities::fileio;
+
+#ifndef NO_PYTHON
+#include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+namespace {
+// Sidecar index header
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t fileCount;
+    uint64_t entryCount;
+};
+
+// Sidecar file record, one per data file
+struct IndexFile {
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+};
+
+const char IndexMagic[8]    = {'R', 'O', 'G', 'U', 'E', 'I', 'D', 'X'};
+const uint32_t IndexVersion = 2;
+
+// Bytes at each end of a data file covered by the content hash
+const uint64_t HashSpan = 4096;
+
+// FNV-1a hash of a block of data
+uint64_t hashBlock(uint64_t hash, const uint8_t* data, uint64_t size) {
+    uint64_t x;
+
+    for (x = 0; x < size; x++) {
+        hash ^= data[x];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+}  // namespace
+
+//! Map a file, throws on error
+ruf::MappedStreamReader::MappedFile::MappedFile(std::string file) {
+    struct stat st;
+    int32_t fd;
+
+    name = file;
+    data = NULL;
+
+    if ((fd = ::open(file.c_str(), O_RDONLY)) < 0)
+        throw(rogue::GeneralError::create("MappedStreamReader::open", "Failed to open data file: %s", file.c_str()));
+
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw(rogue::GeneralError::create("MappedStreamReader::open", "Failed to stat data file: %s", file.c_str()));
+    }
+
+    size = st.st_size;
+    hash = 0;
+
+    // Nanosecond modification time so a file rewritten within a second is detected
+#ifndef __MACH__
+    mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#else
+    mtime = (int64_t)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#endif
+
+    // Read only mapping, it is not charged against the commit limit
+    if (size > 0) {
+        data = (uint8_t*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) {
+            data = NULL;
+            ::close(fd);
+            throw(
+                rogue::GeneralError::create("MappedStreamReader::open", "Failed to map data file: %s", file.c_str()));
+        }
+        madvise(data, size, MADV_SEQUENTIAL);
+
+        // Hash the start and end of the file, checked against the sidecar index
+        hash = hashBlock(0xCBF29CE484222325ULL, data, (size < HashSpan) ? size : HashSpan);
+        if (size > HashSpan) {
+            uint64_t tail = (size < HashSpan * 2) ? (size - HashSpan) : HashSpan;
+            hash          = hashBlock(hash, data + size - tail, tail);
+        }
+    }
+    ::close(fd);
+}
+
+//! Unmap the file
+ruf::MappedStreamReader::MappedFile::~MappedFile() {
+    if (data != NULL) munmap(data, size);
+}
+
+//! Create a frame referencing the mapped data
+ris::FramePtr ruf::MappedStreamReader::MappedFile::mapFrame(uint64_t offset, uint32_t size) {
+    ris::FramePtr frame;
+    ris::BufferPtr buff;
+
+    frame = ris::Frame::create();
+    buff  = createBuffer(data + offset, 0, size, size);
+    buff->setPayload(size);
+    frame->appendBuffer(buff);
+    return frame;
+}
+
+//! Buffers reference the mapping, nothing to free
+void ruf::MappedStreamReader::MappedFile::retBuffer(uint8_t*, uint32_t, uint32_t size) {
+    decCounter(size);
+}
+
+//! Class creation
+ruf::MappedStreamReaderPtr ruf::MappedStreamReader::create() {
+    ruf::MappedStreamReaderPtr s = std::make_shared<ruf::MappedStreamReader>();
+    return (s);
+}
+
+//! Setup class in python
+void ruf::MappedStreamReader::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ruf::MappedStreamReader, ruf::MappedStreamReaderPtr, bp::bases<ris::Master>, boost::noncopyable>(
+        "MappedStreamReader",
+        bp::init<>())
+        .def("open", &ruf::MappedStreamReader::open)
+        .def("close", &ruf::MappedStreamReader::close)
+        .def("isOpen", &ruf::MappedStreamReader::isOpen)
+        .def("getIndexCached", &ruf::MappedStreamReader::getIndexCached)
+        .def("setChannelFilter", &ruf::MappedStreamReader::setChannelFilter)
+        .def("getChannelFilter", &ruf::MappedStreamReader::getChannelFilter)
+        .def("setZeroCopy", &ruf::MappedStreamReader::setZeroCopy)
+        .def("getZeroCopy", &ruf::MappedStreamReader::getZeroCopy)
+        .def("getFrameCount", &ruf::MappedStreamReader::getFrameCount)
+        .def("getFrameSize", &ruf::MappedStreamReader::getFrameSize)
+        .def("getFrameChannel", &ruf::MappedStreamReader::getFrameChannel)
+        .def("getFrameFlags", &ruf::MappedStreamReader::getFrameFlags)
+        .def("getFrameError", &ruf::MappedStreamReader::getFrameError)
+        .def("readFrame", &ruf::MappedStreamReader::readFrame)
+        .def("readRange", &ruf::MappedStreamReader::readRange);
+    bp::implicitly_convertible<ruf::MappedStreamReaderPtr, ris::MasterPtr>();
+#endif
+}
+
+//! Creator
+ruf::MappedStreamReader::MappedStreamReader() {
+    filter_      = -1;
+    zeroCopy_    = false;
+    indexCached_ = false;
+
+    log_ = rogue::Logging::create("fileio.MappedStreamReader");
+}
+
+//! Deconstructor
+ruf::MappedStreamReader::~MappedStreamReader() {
+    close();
+}
+
+//! Open a data file, a file ending in .1 opens the complete group of files
+void ruf::MappedStreamReader::open(std::string file) {
+    std::vector<IndexEntry>::iterator it;
+    std::string baseName;
+    std::string name;
+    uint32_t idx;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    files_.clear();
+    index_.clear();
+    chanIndex_.clear();
+
+    files_.push_back(std::make_shared<MappedFile>(file));
+
+    // Determine if we read a group of files
+    if (file.find_last_of(".") != std::string::npos && file.substr(file.find_last_of(".")) == ".1") {
+        baseName = file.substr(0, file.find_last_of("."));
+
+        for (idx = 2;; idx++) {
+            name = baseName + "." + std::to_string(idx);
+            if (access(name.c_str(), R_OK) != 0) break;
+            files_.push_back(std::make_shared<MappedFile>(name));
+        }
+    }
+
+    // Use cached index if it matches the data files
+    name         = file + ".idx";
+    indexCached_ = loadIndex(name);
+
+    if (!indexCached_) {
+        buildIndex();
+        saveIndex(name);
+    }
+
+    // Per channel lists
+    for (it = index_.begin(); it != index_.end(); ++it)
+        chanIndex_[(it->meta >> 24) & 0xFF].push_back(it - index_.begin());
+
+    log_->info("Opened %s with %" PRIu64 " frames in %" PRIu32 " files",
+               file.c_str(),
+               (uint64_t)index_.size(),
+               (uint32_t)files_.size());
+}
+
+//! Close data files
+void ruf::MappedStreamReader::close() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // Mappings are released once all zero copy frames are freed
+    files_.clear();
+    index_.clear();
+    chanIndex_.clear();
+}
+
+//! Get open status
+bool ruf::MappedStreamReader::isOpen() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (!files_.empty());
+}
+
+//! Get status of the sidecar index, true if the index was loaded from the cache
+bool ruf::MappedStreamReader::getIndexCached() {
+    return indexCached_;
+}
+
+//! Set channel filter, -1 to select all channels
+void ruf::MappedStreamReader::setChannelFilter(int32_t channel) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    filter_ = (channel < 0) ? -1 : (channel & 0xFF);
+}
+
+//! Get channel filter
+int32_t ruf::MappedStreamReader::getChannelFilter() {
+    return filter_;
+}
+
+//! Set zero copy mode
+void ruf::MappedStreamReader::setZeroCopy(bool enable) {
+    zeroCopy_ = enable;
+}
+
+//! Get zero copy mode
+bool ruf::MappedStreamReader::getZeroCopy() {
+    return zeroCopy_;
+}
+
+//! Get number of frames, after channel filter
+uint64_t ruf::MappedStreamReader::getFrameCount() {
+    std::map<uint8_t, std::vector<uint64_t>>::iterator it;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (filter_ < 0) return index_.size();
+    if ((it = chanIndex_.find(filter_)) == chanIndex_.end()) return 0;
+    return it->second.size();
+}
+
+//! Get frame payload size
+uint32_t ruf::MappedStreamReader::getFrameSize(uint64_t index) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return getEntry(index)->size;
+}
+
+//! Get frame channel
+uint8_t ruf::MappedStreamReader::getFrameChannel(uint64_t index) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (getEntry(index)->meta >> 24) & 0xFF;
+}
+
+//! Get frame flags
+uint16_t ruf::MappedStreamReader::getFrameFlags(uint64_t index) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return getEntry(index)->meta & 0xFFFF;
+}
+
+//! Get frame error
+uint8_t ruf::MappedStreamReader::getFrameError(uint64_t index) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (getEntry(index)->meta >> 16) & 0xFF;
+}
+
+//! Send a single frame to the attached slaves
+void ruf::MappedStreamReader::readFrame(uint64_t index) {
+    IndexEntry entry;
+
+    rogue::GilRelease noGil;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        entry = *getEntry(index);
+    }
+    emitEntry(&entry);
+}
+
+//! Send a range of frames to the attached slaves
+void ruf::MappedStreamReader::readRange(uint64_t start, uint64_t count) {
+    IndexEntry entry;
+    uint64_t x;
+
+    rogue::GilRelease noGil;
+    for (x = start; x < (start + count); x++) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            entry = *getEntry(x);
+        }
+        emitEntry(&entry);
+    }
+}
+
+//! Convert a frame number in the filtered view to an index entry
+ruf::MappedStreamReader::IndexEntry* ruf::MappedStreamReader::getEntry(uint64_t index) {
+    std::map<uint8_t, std::vector<uint64_t>>::iterator it;
+
+    if (filter_ < 0) {
+        if (index >= index_.size())
+            throw(rogue::GeneralError::create("MappedStreamReader::getEntry",
+                                              "Frame %" PRIu64 " is out of range, count = %" PRIu64,
+                                              index,
+                                              (uint64_t)index_.size()));
+        return &(index_[index]);
+    }
+
+    if ((it = chanIndex_.find(filter_)) == chanIndex_.end() || index >= it->second.size())
+        throw(rogue::GeneralError::create("MappedStreamReader::getEntry",
+                                          "Frame %" PRIu64 " is out of range for channel %" PRIi32,
+                                          index,
+                                          filter_));
+    return &(index_[it->second[index]]);
+}
+
+//! Emit an index entry
+void ruf::MappedStreamReader::emitEntry(IndexEntry* entry) {
+    ris::FramePtr frame;
+    MappedFilePtr file;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (entry->file >= files_.size())
+            throw(rogue::GeneralError("MappedStreamReader::emitEntry", "Data file is not open"));
+        file = files_[entry->file];
+    }
+
+    if (zeroCopy_) {
+        frame = file->mapFrame(entry->offset, entry->size);
+    } else {
+        frame = reqFrame(entry->size, true);
+        frame->setPayload(entry->size);
+
+        ris::FrameIterator it = frame->begin();
+        ris::toFrame(it, entry->size, file->data + entry->offset);
+    }
+
+    frame->setFlags(entry->meta & 0xFFFF);
+    frame->setError((entry->meta >> 16) & 0xFF);
+    frame->setChannel((entry->meta >> 24) & 0xFF);
+    sendFrame(frame);
+}
+
+//! Build index by scanning the mapped files
+void ruf::MappedStreamReader::buildIndex() {
+    IndexEntry entry;
+    uint64_t offset;
+    uint32_t size;
+    uint32_t x;
+
+    memset(&entry, 0, sizeof(entry));
+
+    for (x = 0; x < files_.size(); x++) {
+        offset = 0;
+
+        while ((offset + 8) <= files_[x]->size) {
+            memcpy(&size, files_[x]->data + offset, 4);
+
+            if (size == 0) {
+                log_->warning("Bad size read in %s at offset %" PRIu64, files_[x]->name.c_str(), offset);
+                break;
+            }
+
+            if ((offset + 4 + size) > files_[x]->size) {
+                log_->warning("Truncated frame in %s at offset %" PRIu64, files_[x]->name.c_str(), offset);
+                break;
+            }
+
+            // Empty frames are skipped, matching StreamReader
+            if (size > 4) {
+                memcpy(&entry.meta, files_[x]->data + offset + 4, 4);
+                entry.offset = offset + 8;
+                entry.size   = size - 4;
+                entry.file   = x;
+                index_.push_back(entry);
+            }
+            offset += 4 + size;
+        }
+    }
+}
+
+//! Load index from sidecar file, returns false if missing or stale
+bool ruf::MappedStreamReader::loadIndex(std::string name) {
+    IndexHeader header;
+    IndexFile ifile;
+    uint64_t bytes;
+    int32_t fd;
+    uint32_t x;
+    bool valid;
+
+    if ((fd = ::open(name.c_str(), O_RDONLY)) < 0) return false;
+
+    valid = (read(fd, &header, sizeof(header)) == sizeof(header) && memcmp(header.magic, IndexMagic, 8) == 0 &&
+             header.version == IndexVersion && header.fileCount == files_.size());
+
+    // Data files must be unchanged
+    for (x = 0; valid && x < files_.size(); x++) {
+        valid = (read(fd, &ifile, sizeof(ifile)) == sizeof(ifile) && ifile.size == files_[x]->size &&
+                 ifile.mtime == files_[x]->mtime && ifile.hash == files_[x]->hash);
+    }
+
+    if (valid) {
+        index_.resize(header.entryCount);
+        bytes = header.entryCount * sizeof(IndexEntry);
+        valid = (bytes == 0 || read(fd, index_.data(), bytes) == (ssize_t)bytes);
+    }
+
+    ::close(fd);
+
+    if (!valid) index_.clear();
+    return valid;
+}
+
+//! Save index to sidecar file
+void ruf::MappedStreamReader::saveIndex(std::string name) {
+    IndexHeader header;
+    IndexFile ifile;
+    std::string tmp;
+    uint64_t bytes;
+    int32_t fd;
+    uint32_t x;
+    bool valid;
+
+    memcpy(header.magic, IndexMagic, 8);
+    header.version    = IndexVersion;
+    header.fileCount  = files_.size();
+    header.entryCount = index_.size();
+
+    // Write to a temporary file and rename so readers never see a partial index
+    tmp = name + ".tmp";
+
+    if ((fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)) < 0) {
+        log_->info("Unable to create index file %s", name.c_str());
+        return;
+    }
+
+    valid = (write(fd, &header, sizeof(header)) == sizeof(header));
+
+    for (x = 0; valid && x < files_.size(); x++) {
+        ifile.size  = files_[x]->size;
+        ifile.mtime = files_[x]->mtime;
+        ifile.hash  = files_[x]->hash;
+        valid       = (write(fd, &ifile, sizeof(ifile)) == sizeof(ifile));
+    }
+
+    bytes = index_.size() * sizeof(IndexEntry);
+    if (valid && bytes > 0) valid = (write(fd, index_.data(), bytes) == (ssize_t)bytes);
+
+    ::close(fd);
+
+    if (!valid || rename(tmp.c_str(), name.c_str()) != 0) {
+        log_->info("Unable to write index file %s", name.c_str());
+        unlink(tmp.c_str());
+    }
+}
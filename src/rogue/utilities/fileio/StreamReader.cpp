@@ -23,9 +23,13 @@
 
 #include "rogue/utilities/fileio/StreamReader.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <memory>
@@ -61,7 +65,9 @@ void ruf::StreamReader::setup_python() {
         .def("close", &ruf::StreamReader::close)
         .def("isOpen", &ruf::StreamReader::isOpen)
         .def("closeWait", &ruf::StreamReader::closeWait)
-        .def("isActive", &ruf::StreamReader::isActive);
+        .def("isActive", &ruf::StreamReader::isActive)
+        .def("setIoUring", &ruf::StreamReader::setIoUring)
+        .def("getIoUring", &ruf::StreamReader::getIoUring);
 #endif
 }
 
@@ -70,6 +76,10 @@ ruf::StreamReader::StreamReader() {
     baseName_   = "";
     readThread_ = NULL;
     active_     = false;
+    fd_         = -1;
+    chunkIdx_   = 0;
+    rdOffset_   = 0;
+    ioUring_    = false;
 }
 
 //! Deconstructor
@@ -95,6 +105,8 @@ void ruf::StreamReader::open(std::string file) {
     if ((fd_ = ::open(file.c_str(), O_RDONLY)) < 0)
         throw(rogue::GeneralError::create("StreamReader::open", "Failed to open data file: %s", file.c_str()));
 
+    allocChunks();
+
     active_     = true;
     threadEn_   = true;
     readThread_ = new std::thread(&StreamReader::runThread, this);
@@ -146,6 +158,8 @@ void ruf::StreamReader::intClose() {
         readThread_ = NULL;
     }
     if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    freeChunks();
 }
 
 //! Close when done
@@ -162,6 +176,179 @@ bool ruf::StreamReader::isActive() {
     return (active_);
 }
 
+//! Set io_uring flag, takes effect on the next open
+void ruf::StreamReader::setIoUring(bool enable) {
+    ioUring_ = enable;
+}
+
+//! Get io_uring state, true if reads are using io_uring
+bool ruf::StreamReader::getIoUring() {
+    rogue::GilRelease noGil;
+    std::unique_lock<std::mutex> lock(mtx_);
+    return (ring_ != NULL);
+}
+
+//! Allocate read ahead chunks and ring
+void ruf::StreamReader::allocChunks() {
+    std::vector<struct iovec> iov;
+    uint32_t depth;
+    uint32_t x;
+    void* ptr;
+
+    freeChunks();
+
+    if (ioUring_) {
+        try {
+            ring_ = ruf::IoUring::create(ChunkDepth);
+        } catch (rogue::GeneralError& e) {
+            rogue::Logging log("streamReader");
+            log.warning("io_uring not available, using blocking reads: %s", e.what());
+        }
+    }
+
+    depth = (ring_ != NULL) ? ChunkDepth : 1;
+    chunks_.resize(depth);
+    iov.resize(depth);
+
+    for (x = 0; x < depth; x++) {
+        if (posix_memalign(&ptr, 4096, ChunkSize) != 0) {
+            chunks_.resize(x);
+            freeChunks();
+            throw(rogue::GeneralError::create("StreamReader::allocChunks",
+                                              "Failed to allocate buffer with size = %" PRIu32,
+                                              ChunkSize));
+        }
+        chunks_[x].data    = (uint8_t*)ptr;
+        chunks_[x].offset  = 0;
+        chunks_[x].size    = 0;
+        chunks_[x].pos     = 0;
+        chunks_[x].pending = false;
+        iov[x].iov_base    = ptr;
+        iov[x].iov_len     = ChunkSize;
+    }
+
+    if (ring_ != NULL) ring_->registerBuffers(iov.data(), depth);
+}
+
+//! Free read ahead chunks and ring
+void ruf::StreamReader::freeChunks() {
+    std::vector<ReadChunk>::iterator it;
+
+    ring_.reset();
+    for (it = chunks_.begin(); it != chunks_.end(); ++it) free(it->data);
+    chunks_.clear();
+}
+
+//! Start reading a new file
+void ruf::StreamReader::startRead() {
+    std::vector<ReadChunk>::iterator it;
+
+    chunkIdx_ = 0;
+    rdOffset_ = 0;
+
+    for (it = chunks_.begin(); it != chunks_.end(); ++it) {
+        it->size    = 0;
+        it->pos     = 0;
+        it->pending = false;
+        readChunk(&(*it));
+    }
+    if (ring_ != NULL) ring_->submit();
+}
+
+//! Wait for outstanding reads before the file is closed
+void ruf::StreamReader::stopRead() {
+    std::vector<ReadChunk>::iterator it;
+    uint64_t tag;
+    int32_t res;
+
+    if (ring_ == NULL) return;
+
+    for (it = chunks_.begin(); it != chunks_.end(); ++it) {
+        while (it->pending && ring_->complete(tag, res, true)) ((ReadChunk*)(uintptr_t)tag)->pending = false;
+        it->pending = false;
+    }
+}
+
+//! Issue a read for a chunk
+void ruf::StreamReader::readChunk(ReadChunk* chunk) {
+    chunk->pos    = 0;
+    chunk->size   = 0;
+    chunk->offset = rdOffset_;
+    rdOffset_ += ChunkSize;
+
+    // Queue read, completion is collected in readData
+    if (ring_ != NULL) {
+        chunk->pending = ring_->read(fd_,
+                                     chunk->data,
+                                     ChunkSize,
+                                     chunk->offset,
+                                     chunk - chunks_.data(),
+                                     (uint64_t)(uintptr_t)chunk);
+        if (chunk->pending) return;
+    }
+    fillChunk(chunk);
+}
+
+//! Complete a chunk with blocking reads, stops at the end of the file
+void ruf::StreamReader::fillChunk(ReadChunk* chunk) {
+    ssize_t ret;
+
+    while (chunk->size < ChunkSize) {
+        ret = ::pread(fd_, chunk->data + chunk->size, ChunkSize - chunk->size, chunk->offset + chunk->size);
+
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret <= 0) break;
+        chunk->size += ret;
+    }
+}
+
+//! Copy data from the read ahead chunks, returns number of bytes copied
+uint32_t ruf::StreamReader::readData(void* data, uint32_t size) {
+    ReadChunk* chunk;
+    ReadChunk* done;
+    uint32_t count;
+    uint32_t copy;
+    uint64_t tag;
+    int32_t res;
+
+    count = 0;
+
+    while (count < size && !chunks_.empty()) {
+        chunk = &chunks_[chunkIdx_];
+
+        // Wait for the chunk, other chunks may complete first
+        while (chunk->pending) {
+            if (!ring_->complete(tag, res, true)) return count;
+            done          = (ReadChunk*)(uintptr_t)tag;
+            done->pending = false;
+            done->size    = (res > 0) ? res : 0;
+
+            // Short or failed reads are retried, only the end of the file returns less than a chunk
+            if (done->size < ChunkSize) fillChunk(done);
+        }
+
+        // Chunk is consumed, a short chunk marks the end of the file
+        if (chunk->pos == chunk->size) {
+            if (chunk->size < ChunkSize) break;
+
+            readChunk(chunk);
+            if (ring_ != NULL) {
+                ring_->submit();
+                chunkIdx_ = (chunkIdx_ + 1) % chunks_.size();
+            }
+            continue;
+        }
+
+        copy = chunk->size - chunk->pos;
+        if (copy > (size - count)) copy = size - count;
+
+        memcpy((uint8_t*)data + count, chunk->data + chunk->pos, copy);
+        chunk->pos += copy;
+        count += copy;
+    }
+    return count;
+}
+
 //! Thread background
 void ruf::StreamReader::runThread() {
     int32_t ret;
@@ -180,8 +367,10 @@ void ruf::StreamReader::runThread() {
     ret = 0;
     err = false;
     do {
+        startRead();
+
         // Read size of each frame
-        while ((fd_ >= 0) && (read(fd_, &size, 4) == 4)) {
+        while ((fd_ >= 0) && (readData(&size, 4) == 4)) {
             if (size == 0) {
                 log.warning("Bad size read %" PRIu32, size);
                 err = true;
@@ -189,7 +378,7 @@ void ruf::StreamReader::runThread() {
             }
 
             // Read flags
-            if (read(fd_, &meta, 4) != 4) {
+            if (readData(&meta, 4) != 4) {
                 log.warning("Failed to read flags");
                 err = true;
                 break;
@@ -217,11 +406,12 @@ void ruf::StreamReader::runThread() {
                 // Adjust to buffer size, if necessary
                 if (bSize > (*it)->getSize()) bSize = (*it)->getSize();
 
-                if ((ret = read(fd_, (*it)->begin(), bSize)) != bSize) {
+                if ((ret = readData((*it)->begin(), bSize)) != bSize) {
                     log.warning("Short read. Ret = %" PRId32 " Req = %" PRIu32 " after %" PRIu32 " bytes",
                                 ret,
                                 bSize,
                                 frame->getPayload());
+                    stopRead();
                     ::close(fd_);
                     fd_ = -1;
                     frame->setError(0x1);
@@ -234,6 +424,7 @@ void ruf::StreamReader::runThread() {
             }
             sendFrame(frame);
         }
+        stopRead();
     } while (threadEn_ && (err == false) && nextFile());
 
     std::unique_lock<std::mutex> lock(mtx_);
@@ -37,15 +37,20 @@
 
 #include "rogue/utilities/fileio/StreamWriter.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <thread>
 
 #include "rogue/GeneralError.h"
@@ -78,6 +83,18 @@ void ruf::StreamWriter::setup_python() {
         .def("setBufferSize", &ruf::StreamWriter::setBufferSize)
         .def("setMaxSize", &ruf::StreamWriter::setMaxSize)
         .def("setDropErrors", &ruf::StreamWriter::setDropErrors)
+        .def("setAsync", &ruf::StreamWriter::setAsync)
+        .def("getAsync", &ruf::StreamWriter::getAsync)
+        .def("setDirectIo", &ruf::StreamWriter::setDirectIo)
+        .def("setSyncInterval", &ruf::StreamWriter::setSyncInterval)
+        .def("getWriteQueueDepth", &ruf::StreamWriter::getWriteQueueDepth)
+        .def("getWriteQueuePeak", &ruf::StreamWriter::getWriteQueuePeak)
+        .def("getStallCount", &ruf::StreamWriter::getStallCount)
+        .def("getStallTime", &ruf::StreamWriter::getStallTime)
+        .def("getWriteBandwidth", &ruf::StreamWriter::getWriteBandwidth)
+        .def("resetStats", &ruf::StreamWriter::resetStats)
+        .def("setIoUring", &ruf::StreamWriter::setIoUring)
+        .def("getIoUring", &ruf::StreamWriter::getIoUring)
         .def("getChannel", &ruf::StreamWriter::getChannel)
         .def("getTotalSize", &ruf::StreamWriter::getTotalSize)
         .def("getCurrentSize", &ruf::StreamWriter::getCurrentSize)
@@ -100,12 +117,32 @@ ruf::StreamWriter::StreamWriter() {
     dropErrors_ = false;
     isOpen_     = false;
 
+    asyncDepth_   = 0;
+    asyncSize_    = 0;
+    active_       = NULL;
+    writeThread_  = NULL;
+    threadEn_     = false;
+    writerBusy_   = false;
+    writeError_   = false;
+    directIo_     = false;
+    syncInterval_ = 0;
+    wrFd_         = -1;
+    wrOffset_     = 0;
+    wrSync_       = 0;
+    wrDirect_     = false;
+    ioUring_      = false;
+    ringCount_    = 0;
+
+    resetStats();
+
     log_ = rogue::Logging::create("fileio.StreamWriter");
 }
 
 //! Deconstructor
 ruf::StreamWriter::~StreamWriter() {
     this->close();
+    this->setAsync(0);
+    this->setBufferSize(0);
 }
 
 //! Open a data file
@@ -115,11 +152,9 @@ void ruf::StreamWriter::open(std::string file) {
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(mtx_);
     isOpen_ = false;
-    flush();
 
     // Close if open
-    if (fd_ >= 0) ::close(fd_);
-    fd_ = -1;
+    closeFile();
 
     baseName_ = file;
     name      = file;
@@ -127,9 +162,7 @@ void ruf::StreamWriter::open(std::string file) {
 
     if (sizeLimit_ > 0) name.append(".1");
 
-    if ((fd_ = ::open(name.c_str(),
-                      O_RDWR | O_CREAT | O_APPEND,
-                      S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH)) < 0)
+    if ((fd_ = openFile(name)) < 0)
         throw(rogue::GeneralError::create("StreamWriter::open", "Failed to open data file: %s", name.c_str()));
 
     totSize_    = 0;
@@ -150,9 +183,7 @@ void ruf::StreamWriter::close() {
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(mtx_);
     isOpen_ = false;
-    flush();
-    if (fd_ >= 0) ::close(fd_);
-    fd_ = -1;
+    closeFile();
 }
 
 //! Get open status
@@ -166,24 +197,7 @@ void ruf::StreamWriter::setBufferSize(uint32_t size) {
     std::lock_guard<std::mutex> lock(mtx_);
 
     // No change
-    if (size != buffSize_) {
-        // Flush data out of current buffer
-        flush();
-
-        // Free old buffer
-        if (buffer_ != NULL) free(buffer_);
-        buffSize_ = 0;
-
-        // Buffer is enabled
-        if (size != 0) {
-            // Create new buffer
-            if ((buffer_ = (uint8_t*)malloc(size)) == NULL)
-                throw(rogue::GeneralError::create("StreamWriter::setBufferSize",
-                                                  "Failed to allocate buffer with size = %" PRIu32,
-                                                  size));
-            buffSize_ = size;
-        }
-    }
+    if (size != buffSize_) allocBuffers(size, asyncDepth_);
 }
 
 //! Set max file size, 0 for unlimited
@@ -198,6 +212,115 @@ void ruf::StreamWriter::setDropErrors(bool drop) {
     dropErrors_ = drop;
 }
 
+//! Set number of buffers for asynchronous writes, 0 to disable
+void ruf::StreamWriter::setAsync(uint32_t depth) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (depth == 1) depth = 2;
+    if (depth == asyncDepth_) return;
+
+    allocBuffers(buffSize_, depth);
+
+    // Start writer thread
+    if (asyncDepth_ > 0 && writeThread_ == NULL) {
+        threadEn_    = true;
+        writeThread_ = new std::thread(&StreamWriter::runThread, this);
+
+        // Set a thread name
+#ifndef __MACH__
+        pthread_setname_np(writeThread_->native_handle(), "StreamWriter");
+#endif
+    }
+
+    // Stop writer thread
+    else if (asyncDepth_ == 0 && writeThread_ != NULL) {
+        {
+            std::lock_guard<std::mutex> qLock(queueMtx_);
+            threadEn_ = false;
+            queueCond_.notify_all();
+        }
+        writeThread_->join();
+        delete writeThread_;
+        writeThread_ = NULL;
+    }
+}
+
+//! Get number of asynchronous buffers, 0 if disabled
+uint32_t ruf::StreamWriter::getAsync() {
+    return asyncDepth_;
+}
+
+//! Set O_DIRECT flag, takes effect on the next file open
+void ruf::StreamWriter::setDirectIo(bool enable) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    directIo_ = enable;
+}
+
+//! Set number of bytes between fdatasync calls, 0 to disable
+void ruf::StreamWriter::setSyncInterval(uint64_t bytes) {
+    syncInterval_ = bytes;
+}
+
+//! Set io_uring flag, used in asynchronous mode when supported
+void ruf::StreamWriter::setIoUring(bool enable) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (enable == ioUring_) return;
+    ioUring_ = enable;
+
+    // Rebuild buffers and ring
+    if (asyncDepth_ > 0) allocBuffers(buffSize_, asyncDepth_);
+}
+
+//! Get io_uring state, true if writes are using io_uring
+bool ruf::StreamWriter::getIoUring() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(queueMtx_);
+    return (ring_ != NULL);
+}
+
+//! Get number of buffers waiting to be written
+uint32_t ruf::StreamWriter::getWriteQueueDepth() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(queueMtx_);
+    return fullQueue_.size();
+}
+
+//! Get peak number of buffers waiting to be written
+uint32_t ruf::StreamWriter::getWriteQueuePeak() {
+    return queuePeak_;
+}
+
+//! Get number of times a write blocked waiting for a free buffer
+uint32_t ruf::StreamWriter::getStallCount() {
+    return stallCount_;
+}
+
+//! Get total time in seconds spent waiting for a free buffer
+double ruf::StreamWriter::getStallTime() {
+    return (double)stallTime_ / 1e6;
+}
+
+//! Get disk write bandwidth in bytes per second
+double ruf::StreamWriter::getWriteBandwidth() {
+    uint64_t time = writeTime_;
+
+    if (time == 0) return 0.0;
+    return ((double)writeBytes_ * 1e6) / (double)time;
+}
+
+//! Reset write statistics
+void ruf::StreamWriter::resetStats() {
+    queuePeak_  = 0;
+    stallCount_ = 0;
+    stallTime_  = 0;
+    writeBytes_ = 0;
+    writeTime_  = 0;
+}
+
 //! Get a slave port
 ruf::StreamWriterChannelPtr ruf::StreamWriter::getChannel(uint8_t channel) {
     rogue::GilRelease noGil;
@@ -295,17 +418,41 @@ void ruf::StreamWriter::writeFile(uint8_t channel, std::shared_ptr<rogue::interf
 
 //! Internal method for file writing with buffer and auto close and reopen
 void ruf::StreamWriter::intWrite(void* data, uint32_t size) {
+    uint8_t* src;
+    uint32_t chunk;
+
     if (fd_ < 0) return;
 
+    // Asynchronous mode, fill each buffer completely so full buffers stay aligned
+    if (asyncDepth_ > 0) {
+        src = (uint8_t*)data;
+
+        while (size > 0 && fd_ >= 0) {
+            if (active_ == NULL) acquireBuffer();
+
+            chunk = asyncSize_ - currBuffer_;
+            if (chunk > size) chunk = size;
+
+            std::memcpy(buffer_ + currBuffer_, src, chunk);
+            currBuffer_ += chunk;
+            src += chunk;
+            size -= chunk;
+
+            if (currBuffer_ == asyncSize_) flush();
+        }
+        return;
+    }
+
     // New size is larger than buffer size, flush
     if ((size + currBuffer_) > buffSize_) flush();
 
     // Attempted write is larger than buffer, raw write
     // This is called if buffer is disabled
     if (size > buffSize_) {
-        if (write(fd_, data, size) != (int32_t)size) {
+        if (!writeBlock(fd_, (uint8_t*)data, size)) {
             ::close(fd_);
-            fd_ = -1;
+            fd_   = -1;
+            wrFd_ = -1;
             log_->error("Write failed, closing file!");
             return;
         }
@@ -333,18 +480,14 @@ void ruf::StreamWriter::checkSize(uint32_t size) {
 
     // File size (including buffer) is larger than max size
     if ((size + currBuffer_ + currSize_) > sizeLimit_) {
-        flush();
-
         // Close and update index
-        ::close(fd_);
+        closeFile();
         fdIdx_++;
 
         name = baseName_ + "." + std::to_string(fdIdx_);
 
         // Open new file
-        if ((fd_ = ::open(name.c_str(),
-                          O_RDWR | O_CREAT | O_APPEND,
-                          S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH)) < 0)
+        if ((fd_ = openFile(name)) < 0)
             throw(rogue::GeneralError::create("StreamWriter::checkSize", "Failed to open file %s", name.c_str()));
 
         currSize_ = 0;
@@ -353,10 +496,41 @@ void ruf::StreamWriter::checkSize(uint32_t size) {
 
 //! Flush file
 void ruf::StreamWriter::flush() {
+    // Writer thread failed, stop writing to this file
+    if (writeError_ && fd_ >= 0) {
+        drain();
+        ::close(fd_);
+        fd_         = -1;
+        wrFd_       = -1;
+        writeError_ = false;
+
+        // Discard partially filled buffer
+        if (active_ != NULL) {
+            std::lock_guard<std::mutex> lock(queueMtx_);
+            freeQueue_.push_back(active_);
+            active_     = NULL;
+            buffer_     = NULL;
+            currBuffer_ = 0;
+        }
+    }
+
     if (currBuffer_ > 0) {
-        if (write(fd_, buffer_, currBuffer_) != (int32_t)currBuffer_) {
+        // Hand buffer to writer thread
+        if (asyncDepth_ > 0) {
+            active_->size = currBuffer_;
+            active_->fd   = fd_;
+            {
+                std::lock_guard<std::mutex> lock(queueMtx_);
+                fullQueue_.push_back(active_);
+                if (fullQueue_.size() > queuePeak_) queuePeak_ = fullQueue_.size();
+                queueCond_.notify_all();
+            }
+            active_ = NULL;
+            buffer_ = NULL;
+        } else if (!writeBlock(fd_, buffer_, currBuffer_)) {
             ::close(fd_);
-            fd_ = -1;
+            fd_   = -1;
+            wrFd_ = -1;
             log_->error("Write failed, closing file!");
             currBuffer_ = 0;
             return;
@@ -366,3 +540,371 @@ void ruf::StreamWriter::flush() {
         currBuffer_ = 0;
     }
 }
+
+//! Open a file with the configured flags
+int32_t ruf::StreamWriter::openFile(std::string name) {
+    int32_t flags;
+    int32_t fd;
+
+    flags = O_RDWR | O_CREAT;
+
+#ifdef O_DIRECT
+    if (directIo_) flags |= O_DIRECT;
+#endif
+
+    fd = ::open(name.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+
+#ifdef O_DIRECT
+    // File system does not support direct IO
+    if (fd < 0 && directIo_ && errno == EINVAL) {
+        log_->warning("O_DIRECT not supported for %s, using cached writes", name.c_str());
+        fd = ::open(name.c_str(), flags & ~O_DIRECT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    }
+#endif
+    return fd;
+}
+
+//! Flush, wait for pending writes and close the current file
+void ruf::StreamWriter::closeFile() {
+    flush();
+    drain();
+
+    if (fd_ >= 0) {
+        if (syncInterval_ > 0) fdatasync(fd_);
+        ::close(fd_);
+    }
+    fd_   = -1;
+    wrFd_ = -1;
+}
+
+//! Track descriptor state before a write, returns the write offset
+uint64_t ruf::StreamWriter::prepareWrite(int32_t fd, uint8_t* data, uint32_t size) {
+    uint64_t offset;
+
+    // New descriptor, writes are positioned explicitly starting at the end of the file
+    if (fd != wrFd_) {
+        wrFd_     = fd;
+        wrOffset_ = lseek(fd, 0, SEEK_END);
+        wrSync_   = 0;
+        wrDirect_ = false;
+#ifdef O_DIRECT
+        wrDirect_ = ((fcntl(fd, F_GETFL) & O_DIRECT) != 0);
+#endif
+    }
+
+#ifdef O_DIRECT
+    // Direct writes require aligned memory, size and file offset
+    if ((directIo_ || wrDirect_) && wantDirect(data, size) != wrDirect_) {
+        int32_t flags;
+
+        if ((flags = fcntl(fd, F_GETFL)) >= 0 &&
+            fcntl(fd, F_SETFL, wrDirect_ ? (flags & ~O_DIRECT) : (flags | O_DIRECT)) == 0)
+            wrDirect_ = !wrDirect_;
+    }
+#endif
+
+    offset = wrOffset_;
+    wrOffset_ += size;
+    return offset;
+}
+
+//! Return true if a write is eligible for O_DIRECT
+bool ruf::StreamWriter::wantDirect(uint8_t* data, uint32_t size) {
+    return (directIo_ && ((uintptr_t)data % Alignment) == 0 && (size % Alignment) == 0 &&
+            (wrOffset_ % Alignment) == 0);
+}
+
+//! Write a complete block at an offset
+bool ruf::StreamWriter::writeAll(int32_t fd, uint8_t* data, uint32_t size, uint64_t offset) {
+    ssize_t ret;
+    uint32_t pos;
+
+    for (pos = 0; pos < size; pos += ret) {
+        if ((ret = ::pwrite(fd, data + pos, size - pos, offset + pos)) <= 0) {
+            if (ret < 0 && errno == EINTR) {
+                ret = 0;
+                continue;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Update counters after a write and apply the sync policy
+void ruf::StreamWriter::writeDone(int32_t fd, uint32_t size) {
+    uint64_t interval;
+
+    wrSync_ += size;
+    writeBytes_ += size;
+
+    interval = syncInterval_;
+    if (interval > 0 && wrSync_ >= interval) {
+        fdatasync(fd);
+        wrSync_ = 0;
+    }
+}
+
+//! Write a block to a descriptor, handles O_DIRECT and sync policy
+bool ruf::StreamWriter::writeBlock(int32_t fd, uint8_t* data, uint32_t size) {
+    std::chrono::steady_clock::time_point stm;
+    uint64_t offset;
+
+    offset = prepareWrite(fd, data, size);
+    stm    = std::chrono::steady_clock::now();
+
+    if (!writeAll(fd, data, size, offset)) return false;
+
+    writeTime_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stm).count();
+    writeDone(fd, size);
+    return true;
+}
+
+//! Queue a buffer to the io_uring, called from writer thread
+void ruf::StreamWriter::ringWrite(AsyncBuffer* buff) {
+    // Skip remaining buffers after a failure, cleared when the file is closed
+    if (writeError_) {
+        returnBuffer(buff);
+        return;
+    }
+
+    // Changing O_DIRECT state requires the outstanding writes to complete
+    if (ringCount_ > 0 && buff->fd == wrFd_ && wantDirect(buff->data, buff->size) != wrDirect_)
+        while (ringCount_ > 0) ringComplete();
+
+    buff->offset = prepareWrite(buff->fd, buff->data, buff->size);
+
+    if (!ring_->write(buff->fd, buff->data, buff->size, buff->offset, buff->index, (uint64_t)(uintptr_t)buff)) {
+        if (!writeAll(buff->fd, buff->data, buff->size, buff->offset)) {
+            log_->error("Write failed, closing file!");
+            writeError_ = true;
+        } else {
+            writeDone(buff->fd, buff->size);
+        }
+        returnBuffer(buff);
+        return;
+    }
+
+    if (ringCount_ == 0) ringStart_ = std::chrono::steady_clock::now();
+    buff->pending = true;
+    ringCount_++;
+    ring_->submit();
+}
+
+//! Wait for an io_uring write completion, called from writer thread
+void ruf::StreamWriter::ringComplete() {
+    std::vector<AsyncBuffer>::iterator it;
+    AsyncBuffer* buff;
+    uint64_t tag;
+    int32_t res;
+
+    // Ring failed, recover all outstanding buffers
+    if (!ring_->complete(tag, res, true)) {
+        log_->error("io_uring wait failed, closing file!");
+        writeError_ = true;
+        for (it = asyncBuffers_.begin(); it != asyncBuffers_.end(); ++it)
+            if (it->pending) returnBuffer(&(*it));
+        ringCount_ = 0;
+        return;
+    }
+
+    buff = (AsyncBuffer*)(uintptr_t)tag;
+
+    // Complete short writes synchronously
+    if (res >= 0 && (uint32_t)res < buff->size)
+        if (!writeAll(buff->fd, buff->data + res, buff->size - res, buff->offset + res)) res = -1;
+
+    if (res < 0) {
+        if (!writeError_) log_->error("Write failed, closing file!");
+        writeError_ = true;
+    } else {
+        writeDone(buff->fd, buff->size);
+    }
+
+    if (--ringCount_ == 0)
+        writeTime_ +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - ringStart_)
+                .count();
+
+    returnBuffer(buff);
+}
+
+//! Return a buffer to the free list
+void ruf::StreamWriter::returnBuffer(AsyncBuffer* buff) {
+    std::lock_guard<std::mutex> lock(queueMtx_);
+    buff->pending = false;
+    freeQueue_.push_back(buff);
+    queueCond_.notify_all();
+}
+
+//! Allocate write buffers, call with lock held
+void ruf::StreamWriter::allocBuffers(uint32_t size, uint32_t depth) {
+    std::vector<struct iovec> iov;
+    ruf::IoUringPtr ring;
+    uint32_t alloc;
+    uint32_t x;
+    void* ptr;
+
+    // Flush data out of current buffer and wait for the writer
+    flush();
+    drain();
+    freeBuffers();
+
+    // Asynchronous buffers, rounded up to the alignment
+    if (depth > 0) {
+        asyncSize_ = (size == 0) ? DefaultAsyncSize : size;
+        alloc      = ((asyncSize_ + Alignment - 1) / Alignment) * Alignment;
+
+        asyncBuffers_.resize(depth);
+        iov.resize(depth);
+        for (x = 0; x < depth; x++) {
+            if (posix_memalign(&ptr, Alignment, alloc) != 0) {
+                asyncBuffers_.resize(x);
+                freeBuffers();
+                throw(rogue::GeneralError::create("StreamWriter::allocBuffers",
+                                                  "Failed to allocate buffer with size = %" PRIu32,
+                                                  alloc));
+            }
+            asyncBuffers_[x].data    = (uint8_t*)ptr;
+            asyncBuffers_[x].size    = 0;
+            asyncBuffers_[x].fd      = -1;
+            asyncBuffers_[x].offset  = 0;
+            asyncBuffers_[x].index   = x;
+            asyncBuffers_[x].pending = false;
+            freeQueue_.push_back(&asyncBuffers_[x]);
+            iov[x].iov_base = ptr;
+            iov[x].iov_len  = alloc;
+        }
+        asyncDepth_ = depth;
+        buffSize_   = size;
+
+        // Keep one write in flight per buffer
+        if (ioUring_) {
+            try {
+                ring = ruf::IoUring::create(depth);
+                if (!ring->registerBuffers(iov.data(), depth))
+                    log_->info("Failed to register io_uring buffers, using unregistered writes");
+
+                std::lock_guard<std::mutex> lock(queueMtx_);
+                ring_ = ring;
+            } catch (rogue::GeneralError& e) {
+                log_->warning("io_uring not available, using blocking writes: %s", e.what());
+            }
+        }
+    }
+
+    // Synchronous buffer
+    else if (size != 0) {
+        if (posix_memalign(&ptr, Alignment, size) != 0)
+            throw(rogue::GeneralError::create("StreamWriter::setBufferSize",
+                                              "Failed to allocate buffer with size = %" PRIu32,
+                                              size));
+        buffer_   = (uint8_t*)ptr;
+        buffSize_ = size;
+    }
+}
+
+//! Free write buffers, call with lock held
+void ruf::StreamWriter::freeBuffers() {
+    std::vector<AsyncBuffer>::iterator it;
+
+    if (asyncDepth_ == 0 && buffer_ != NULL) free(buffer_);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMtx_);
+        ring_.reset();
+        for (it = asyncBuffers_.begin(); it != asyncBuffers_.end(); ++it) free(it->data);
+        asyncBuffers_.clear();
+        freeQueue_.clear();
+        fullQueue_.clear();
+    }
+
+    buffer_     = NULL;
+    active_     = NULL;
+    currBuffer_ = 0;
+    buffSize_   = 0;
+    asyncSize_  = 0;
+    asyncDepth_ = 0;
+}
+
+//! Wait for a free asynchronous buffer
+void ruf::StreamWriter::acquireBuffer() {
+    std::chrono::steady_clock::time_point stm;
+
+    std::unique_lock<std::mutex> lock(queueMtx_);
+
+    if (freeQueue_.empty()) {
+        stm = std::chrono::steady_clock::now();
+        while (freeQueue_.empty()) queueCond_.wait(lock);
+
+        stallCount_++;
+        stallTime_ +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stm).count();
+    }
+
+    active_ = freeQueue_.front();
+    freeQueue_.pop_front();
+    buffer_     = active_->data;
+    currBuffer_ = 0;
+}
+
+//! Wait for the writer thread to become idle
+void ruf::StreamWriter::drain() {
+    std::unique_lock<std::mutex> lock(queueMtx_);
+    while (writeThread_ != NULL && (writerBusy_ || !fullQueue_.empty())) queueCond_.wait(lock);
+}
+
+//! Asynchronous writer thread
+void ruf::StreamWriter::runThread() {
+    AsyncBuffer* buff;
+
+    std::unique_lock<std::mutex> lock(queueMtx_);
+
+    while (threadEn_) {
+        // Keep queuing writes while the ring has space
+        if (ring_ != NULL && !fullQueue_.empty() && ringCount_ < ring_->depth()) {
+            buff = fullQueue_.front();
+            fullQueue_.pop_front();
+            writerBusy_ = true;
+            lock.unlock();
+            ringWrite(buff);
+            lock.lock();
+            writerBusy_ = (ringCount_ > 0);
+            queueCond_.notify_all();
+            continue;
+        }
+
+        // Wait for the oldest outstanding write
+        if (ringCount_ > 0) {
+            lock.unlock();
+            ringComplete();
+            lock.lock();
+            writerBusy_ = (ringCount_ > 0);
+            queueCond_.notify_all();
+            continue;
+        }
+
+        if (fullQueue_.empty()) {
+            queueCond_.wait(lock);
+            continue;
+        }
+
+        buff = fullQueue_.front();
+        fullQueue_.pop_front();
+        writerBusy_ = true;
+        lock.unlock();
+
+        // Skip remaining buffers after a failure, cleared when the file is closed
+        if (!writeError_ && !writeBlock(buff->fd, buff->data, buff->size)) {
+            log_->error("Write failed, closing file!");
+            wrFd_       = -1;
+            writeError_ = true;
+        }
+
+        lock.lock();
+        freeQueue_.push_back(buff);
+        writerBusy_ = false;
+        queueCond_.notify_all();
+    }
+}
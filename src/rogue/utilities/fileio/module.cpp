@@ -28,6 +28,7 @@
 
 #include "rogue/utilities/fileio/LegacyStreamReader.h"
 #include "rogue/utilities/fileio/LegacyStreamWriter.h"
+#include "rogue/utilities/fileio/MappedStreamReader.h"
 #include "rogue/utilities/fileio/StreamReader.h"
 #include "rogue/utilities/fileio/StreamWriter.h"
 #include "rogue/utilities/fileio/StreamWriterChannel.h"
@@ -47,6 +48,7 @@ void ruf::setup_module() {
 
     ruf::StreamReader::setup_python();
     ruf::LegacyStreamReader::setup_python();
+    ruf::MappedStreamReader::setup_python();
     ruf::StreamWriter::setup_python();
     ruf::LegacyStreamWriter::setup_python();
     ruf::StreamWriterChannel::setup_python();
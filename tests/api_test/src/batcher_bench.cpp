@@ -0,0 +1,115 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Batcher splitter benchmark. Splits 1MB version 1 super frames holding
+ * records of several sizes, with and without zero copy mode. The parse rate
+ * covers only the time spent in the batcher parser.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <rogue/interfaces/stream/Frame.h>
+#include <rogue/interfaces/stream/FrameIterator.h>
+#include <rogue/interfaces/stream/FrameLock.h>
+#include <rogue/interfaces/stream/Master.h>
+#include <rogue/interfaces/stream/Slave.h>
+#include <rogue/protocols/batcher/SplitterV1.h>
+
+namespace ris = rogue::interfaces::stream;
+namespace rpb = rogue::protocols::batcher;
+
+// Counts received records and bytes
+class RecordSink : public ris::Slave {
+  public:
+    uint64_t count;
+    uint64_t bytes;
+
+    RecordSink() : count(0), bytes(0) {}
+
+    void acceptFrame(ris::FramePtr frame) {
+        count++;
+        bytes += frame->getPayload();
+    }
+};
+
+// Build a super frame with a 64-bit width holding records of the passed size
+std::vector<uint8_t> superFrame(uint32_t total, uint32_t recSize) {
+    std::vector<uint8_t> data;
+    uint32_t pad = (8 - recSize % 8) % 8;
+    uint32_t x;
+    uint8_t tail[8];
+
+    data.resize(8, 0);
+    data[0] = 0x21;
+
+    memcpy(tail, &recSize, 4);
+    tail[4] = 0;
+    tail[5] = 0;
+    tail[6] = 0;
+    tail[7] = 8 - pad;
+
+    for (x = 0; (data.size() + recSize + pad + 8) <= total; x++) {
+        data.resize(data.size() + recSize + pad, x & 0xFF);
+        data.insert(data.end(), tail, tail + 8);
+    }
+    return data;
+}
+
+void measure(uint32_t recSize, bool zeroCopy, uint32_t count) {
+    std::vector<uint8_t> data = superFrame(0x100000, recSize);
+    std::shared_ptr<RecordSink> sink = std::make_shared<RecordSink>();
+    rpb::SplitterV1Ptr split         = rpb::SplitterV1::create();
+    ris::MasterPtr mast              = ris::Master::create();
+    ris::FramePtr frame;
+    uint32_t x;
+
+    split->setZeroCopy(zeroCopy);
+    mast->addSlave(split);
+    split->addSlave(sink);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) {
+        frame = mast->reqFrame(data.size(), true);
+        frame->setPayload(data.size());
+
+        ris::FrameIterator it = frame->begin();
+        ris::toFrame(it, data.size(), data.data());
+        mast->sendFrame(frame);
+    }
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    printf("record=%6u zeroCopy=%u : %8.3f Mrec/s, %8.1f MB/s, parse %8.3f Mrec/s\n",
+           recSize,
+           zeroCopy,
+           (double)sink->count / dur.count() / 1.0e6,
+           (double)sink->bytes / dur.count() / 1.0e6,
+           split->getCore()->getParseRate() / 1.0e6);
+}
+
+int main(int argc, char** argv) {
+    uint32_t sizes[4] = {32, 96, 1024, 65536};
+    uint32_t count    = 500;
+    uint32_t x;
+
+    if (argc > 1) count = atoi(argv[1]);
+
+    for (x = 0; x < 4; x++) {
+        measure(sizes[x], false, count);
+        measure(sizes[x], true, count);
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Bit field benchmark. Checks the memory Master bit helpers against a bit
+ * serial reference and compares their speed for unaligned fields, and
+ * compares a single window extract/deposit against per field copies.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstring>
+
+#include <rogue/interfaces/memory/Master.h>
+
+namespace rim = rogue::interfaces::memory;
+
+// Bit serial copy used before word copies were added
+void legacyCopyBits(uint8_t* dstData, uint32_t dstLsb, uint8_t* srcData, uint32_t srcLsb, uint32_t size) {
+    uint32_t srcBit  = srcLsb % 8;
+    uint32_t srcByte = srcLsb / 8;
+    uint32_t dstBit  = dstLsb % 8;
+    uint32_t dstByte = dstLsb / 8;
+    uint32_t rem     = size;
+    uint32_t bytes;
+
+    do {
+        bytes = rem / 8;
+
+        if ((srcBit == 0) && (dstBit == 0) && (bytes > 0)) {
+            std::memcpy(&(dstData[dstByte]), &(srcData[srcByte]), bytes);
+            dstByte += bytes;
+            srcByte += bytes;
+            rem -= (bytes * 8);
+        } else {
+            dstData[dstByte] &= ((0x1 << dstBit) ^ 0xFF);
+            dstData[dstByte] |= ((srcData[srcByte] >> srcBit) & 0x1) << dstBit;
+            srcByte += (++srcBit / 8);
+            dstByte += (++dstBit / 8);
+            srcBit %= 8;
+            dstBit %= 8;
+            rem -= 1;
+        }
+    } while (rem != 0);
+}
+
+inline bool getBit(const uint8_t* data, uint32_t bit) {
+    return (data[bit / 8] >> (bit % 8)) & 0x1;
+}
+
+void fill(uint8_t* data, uint32_t size) {
+    for (uint32_t x = 0; x < size; x++) data[x] = rand() & 0xFF;
+}
+
+// Compare against the bit serial versions
+uint32_t verify(uint32_t count) {
+    uint8_t src[256];
+    uint8_t dstA[256];
+    uint8_t dstB[256];
+    uint32_t errors = 0;
+    uint32_t x;
+    uint32_t b;
+
+    for (x = 0; x < count; x++) {
+        uint32_t size   = 1 + rand() % 600;
+        uint32_t srcLsb = rand() % (2048 - size);
+        uint32_t dstLsb = rand() % (2048 - size);
+
+        fill(src, sizeof(src));
+        fill(dstA, sizeof(dstA));
+        std::memcpy(dstB, dstA, sizeof(dstA));
+
+        legacyCopyBits(dstA, dstLsb, src, srcLsb, size);
+        rim::Master::copyBits(dstB, dstLsb, src, srcLsb, size);
+        if (std::memcmp(dstA, dstB, sizeof(dstA)) != 0) errors++;
+
+        // Set bits
+        for (b = 0; b < size; b++) dstA[(dstLsb + b) / 8] |= (1 << ((dstLsb + b) % 8));
+        rim::Master::setBits(dstB, dstLsb, size);
+        if (std::memcmp(dstA, dstB, sizeof(dstA)) != 0) errors++;
+
+        // Any bits, on a sparse source
+        std::memset(src, 0, sizeof(src));
+        if (rand() % 2) src[(srcLsb + rand() % size) / 8] |= 0xFF;
+        bool any = false;
+        for (b = 0; b < size; b++) any |= getBit(src, srcLsb + b);
+        if (any != rim::Master::anyBits(src, srcLsb, size)) errors++;
+    }
+
+    // Window extract and deposit against per field copies
+    for (x = 0; x < count; x++) {
+        uint32_t offset[3] = {(uint32_t)(rand() % 8), 0, 0};
+        uint32_t size[3]   = {(uint32_t)(1 + rand() % 16), (uint32_t)(1 + rand() % 16), (uint32_t)(1 + rand() % 16)};
+        uint64_t mask      = 0;
+        uint8_t value[8];
+        uint8_t block[8];
+
+        offset[1] = offset[0] + size[0] + rand() % 4;
+        offset[2] = offset[1] + size[1] + rand() % 4;
+        if (offset[2] + size[2] > 64) continue;
+
+        for (b = 0; b < 3; b++) mask |= ((1ULL << size[b]) - 1) << offset[b];
+
+        fill(block, 8);
+        std::memset(dstA, 0, 8);
+        std::memset(dstB, 0, 8);
+        legacyCopyBits(dstA, 0, block, offset[0], size[0]);
+        legacyCopyBits(dstA, size[0], block, offset[1], size[1]);
+        legacyCopyBits(dstA, size[0] + size[1], block, offset[2], size[2]);
+        rim::Master::extractBits(dstB, 8, block, 8, mask);
+        if (std::memcmp(dstA, dstB, 8) != 0) errors++;
+
+        fill(value, 8);
+        std::memcpy(dstA, block, 8);
+        std::memcpy(dstB, block, 8);
+        legacyCopyBits(dstA, offset[0], value, 0, size[0]);
+        legacyCopyBits(dstA, offset[1], value, size[0], size[1]);
+        legacyCopyBits(dstA, offset[2], value, size[0] + size[1], size[2]);
+        rim::Master::depositBits(dstB, 8, mask, value, 8);
+        if (std::memcmp(dstA, dstB, 8) != 0) errors++;
+    }
+    return errors;
+}
+
+template <typename F>
+double measure(uint32_t count, F func) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t x = 0; x < count; x++) func(x);
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+    return (dur.count() * 1.0e9) / count;
+}
+
+int main(int argc, char** argv) {
+    static uint8_t block[4096];
+    static uint8_t value[512];
+    uint32_t sizes[] = {3, 13, 32, 61, 1000};
+    uint32_t count   = 2000000;
+    uint32_t errors;
+    double legacy;
+    double word;
+
+    fill(block, sizeof(block));
+    fill(value, sizeof(value));
+
+    errors = verify(100000);
+    printf("verify: %u errors\n", errors);
+
+    for (uint32_t s = 0; s < 5; s++) {
+        uint32_t size = sizes[s];
+        uint32_t num  = (size > 64) ? count / 16 : count;
+
+        legacy = measure(num, [&](uint32_t x) { legacyCopyBits(value, 0, block, 3 + (x & 0xFF) * 5, size); });
+        word   = measure(num, [&](uint32_t x) { rim::Master::copyBits(value, 0, block, 3 + (x & 0xFF) * 5, size); });
+
+        printf("copyBits  size=%4u : legacy %8.1f ns, word %8.1f ns, speedup %6.1fx\n",
+               size,
+               legacy,
+               word,
+               legacy / word);
+    }
+
+    // Three field variable, per field copies against one window extract
+    uint64_t mask = (0x1FULL << 3) | (0x1FFULL << 12) | (0x7FULL << 30);
+
+    legacy = measure(count, [&](uint32_t x) {
+        uint8_t* win = block + (x & 0xFF) * 8;
+        legacyCopyBits(value, 0, win, 3, 5);
+        legacyCopyBits(value, 5, win, 12, 9);
+        legacyCopyBits(value, 14, win, 30, 7);
+    });
+    word = measure(count, [&](uint32_t x) {
+        uint8_t* win = block + (x & 0xFF) * 8;
+        rim::Master::copyBits(value, 0, win, 3, 5);
+        rim::Master::copyBits(value, 5, win, 12, 9);
+        rim::Master::copyBits(value, 14, win, 30, 7);
+    });
+    double plan = measure(count, [&](uint32_t x) { rim::Master::extractBits(value, 3, block + (x & 0xFF) * 8, 5, mask); });
+
+    printf("extract 3 fields  : legacy %8.1f ns, word %8.1f ns, plan %8.1f ns\n", legacy, word, plan);
+
+    plan = measure(count, [&](uint32_t x) { rim::Master::depositBits(block + (x & 0xFF) * 8, 5, mask, value, 3); });
+    printf("deposit 3 fields  : plan %8.1f ns\n", plan);
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Packetizer CRC benchmark. Checks that each Crc32 engine is bit exact with
+ * CRC.h for all sizes up to 1100 bytes, several alignments and chained
+ * blocks, then compares the throughput of the engines.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <vector>
+
+#include <rogue/protocols/packetizer/CRC.h>
+#include <rogue/protocols/packetizer/Crc32.h>
+
+namespace rpp = rogue::protocols::packetizer;
+
+typedef uint32_t (*CrcFunc)(const void*, uint32_t, uint32_t);
+
+// Compare an engine against CRC.h, returns the number of mismatches
+uint32_t check(const char* name, CrcFunc func, const CRC::Table<uint32_t, 32>& table, std::vector<uint8_t>& data) {
+    uint32_t errors = 0;
+    uint32_t size;
+    uint32_t off;
+    uint32_t ref;
+    uint32_t crc;
+
+    for (size = 0; size <= 1100; size++) {
+        for (off = 0; off < 8; off++) {
+            ref = CRC::Calculate(data.data() + off, size, table);
+            crc = func(data.data() + off, size, 0);
+            if (crc != ref) errors++;
+
+            // Chained over two blocks, as done across packetizer segments
+            ref = CRC::Calculate(data.data() + off + size, 777, table, ref);
+            crc = func(data.data() + off + size, 777, crc);
+            if (crc != ref) errors++;
+        }
+    }
+
+    printf("%-10s check : %s (%u errors)\n", name, (errors == 0) ? "pass" : "FAIL", errors);
+    return errors;
+}
+
+template <typename F>
+void measure(const char* name, uint32_t size, std::vector<uint8_t>& data, F func) {
+    uint64_t total = (uint64_t)1 << 30;
+    uint32_t count = (total / size) + 1;
+    uint32_t crc   = 0;
+    uint32_t x;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) crc = func(data.data(), size, crc);
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    printf("%-10s size=%8u : %8.2f GB/s (0x%08x)\n",
+           name,
+           size,
+           ((double)size * count) / dur.count() / 1.0e9,
+           crc);
+}
+
+int main(int argc, char** argv) {
+    static const CRC::Table<uint32_t, 32> table(CRC::CRC_32());
+    std::vector<uint8_t> data(0x100000 + 4096);
+    uint32_t sizes[4] = {64, 1500, 9000, 0x100000};
+    uint32_t errors   = 0;
+    uint32_t x;
+
+    for (x = 0; x < data.size(); x++) data[x] = rand();
+
+    printf("PCLMULQDQ supported: %s\n", rpp::Crc32::clmulSupported() ? "yes" : "no");
+
+    errors += check("table", rpp::Crc32::calculateTable, table, data);
+    errors += check("clmul", rpp::Crc32::calculateClmul, table, data);
+    errors += check("default", rpp::Crc32::calculate, table, data);
+
+    for (x = 0; x < 4; x++) {
+        measure("CRC.h", sizes[x], data, [&](const uint8_t* d, uint32_t s, uint32_t c) {
+            return CRC::Calculate(d, s, table, c);
+        });
+        measure("table", sizes[x], data, rpp::Crc32::calculateTable);
+        measure("clmul", sizes[x], data, rpp::Crc32::calculateClmul);
+    }
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * AxiStreamDma benchmark using the DMA driver emulator. Frames are sent
+ * through an emulated loopback and received by the same instance. The send
+ * time is stored in each frame to measure the per frame latency.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <rogue/hardware/axi/AxiStreamDma.h>
+#include <rogue/hardware/axi/DmaEmulator.h>
+#include <rogue/interfaces/stream/Frame.h>
+#include <rogue/interfaces/stream/FrameIterator.h>
+#include <rogue/interfaces/stream/FrameLock.h>
+#include <rogue/interfaces/stream/Master.h>
+#include <rogue/interfaces/stream/Slave.h>
+
+namespace rha = rogue::hardware::axi;
+namespace ris = rogue::interfaces::stream;
+
+// Current time in nanoseconds
+uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Counts received frames and the latency from the send time in the frame
+class LatencySink : public ris::Slave {
+  public:
+    std::atomic<uint64_t> count;
+    uint64_t bytes;
+    uint64_t latSum;
+    uint64_t latMax;
+
+    LatencySink() : count(0), bytes(0), latSum(0), latMax(0) {}
+
+    void acceptFrame(ris::FramePtr frame) {
+        ris::FrameIterator it = frame->begin();
+        uint64_t sent;
+        uint64_t lat;
+
+        ris::fromFrame(it, 8, &sent);
+        lat = now() - sent;
+
+        latSum += lat;
+        if (lat > latMax) latMax = lat;
+        bytes += frame->getPayload();
+        count++;
+    }
+};
+
+void measure(std::string path, uint32_t size, bool zeroCopy, uint32_t thold, uint32_t count) {
+    rha::DmaEmulatorPtr emu = rha::DmaEmulator::create(path, 256, 256, 0x10000);
+    uint64_t sent;
+    uint32_t x;
+
+    if (!zeroCopy) rha::AxiStreamDma::zeroCopyDisable(path);
+
+    std::shared_ptr<LatencySink> sink = std::make_shared<LatencySink>();
+    rha::AxiStreamDmaPtr dma          = rha::AxiStreamDma::create(path, 1, true);
+    ris::MasterPtr mast               = ris::Master::create();
+    ris::FramePtr frame;
+
+    dma->setRetThold(thold);
+    mast->addSlave(dma);
+    dma->addSlave(sink);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) {
+        frame = mast->reqFrame(size, true);
+        frame->setPayload(size);
+
+        ris::FrameIterator it = frame->begin();
+        sent                  = now();
+        ris::toFrame(it, 8, &sent);
+        mast->sendFrame(frame);
+    }
+
+    while (sink->count < count) std::this_thread::sleep_for(std::chrono::microseconds(10));
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    printf("size=%6u zeroCopy=%u thold=%3u : %9.1f kframes/s, %8.1f MB/s, latency mean %8.1f us, max %8.1f us\n",
+           size,
+           zeroCopy,
+           thold,
+           (double)count / dur.count() / 1.0e3,
+           (double)sink->bytes / dur.count() / 1.0e6,
+           (double)sink->latSum / count / 1.0e3,
+           (double)sink->latMax / 1.0e3);
+
+    dma->stop();
+}
+
+int main(int argc, char** argv) {
+    uint32_t sizes[4] = {64, 1024, 0x10000, 0x100000};
+    uint32_t count    = 20000;
+    uint32_t x;
+
+    if (argc > 1) count = atoi(argv[1]);
+
+    for (x = 0; x < 4; x++) {
+        measure("/dev/emu_zc" + std::to_string(x), sizes[x], true, 1, count);
+        measure("/dev/emu_zcb" + std::to_string(x), sizes[x], true, 64, count);
+
+        // Copy mode is limited to a single buffer per frame
+        if (sizes[x] <= 0x10000) measure("/dev/emu_cp" + std::to_string(x), sizes[x], false, 1, count);
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Memory emulator benchmark. Measures random register and sequential bulk
+ * transaction throughput of a memory Emulate device from several masters.
+ * Each region is accessed several times, so most accesses hit existing pages.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <rogue/interfaces/memory/Constants.h>
+#include <rogue/interfaces/memory/Emulate.h>
+#include <rogue/interfaces/memory/Master.h>
+
+namespace rim = rogue::interfaces::memory;
+
+// Random 4 byte accesses spread over a 256MB region
+void runRandom(rim::EmulatePtr emu, uint32_t seed, uint32_t count) {
+    rim::MasterPtr mast = rim::Master::create();
+    uint32_t data       = seed;
+    uint64_t addr;
+    uint32_t x;
+
+    mast->setSlave(emu);
+
+    for (x = 0; x < count; x++) {
+        seed = seed * 1664525 + 1013904223;
+        addr = (uint64_t)(seed & 0x0FFFFFFC);
+        mast->reqTransaction(addr, 4, &data, (x & 1) ? rim::Read : rim::Write);
+        mast->waitTransaction(0);
+    }
+}
+
+// Sequential 64KB accesses over a 64MB region per master
+void runSequential(rim::EmulatePtr emu, uint32_t seed, uint32_t count) {
+    rim::MasterPtr mast = rim::Master::create();
+    std::vector<uint8_t> data(0x10000, seed & 0xFF);
+    uint64_t base = (uint64_t)seed << 26;
+    uint32_t x;
+
+    mast->setSlave(emu);
+
+    for (x = 0; x < count; x++) {
+        mast->reqTransaction(base + (x % 0x400) * 0x10000, 0x10000, data.data(), (x & 1) ? rim::Read : rim::Write);
+        mast->waitTransaction(0);
+    }
+}
+
+void measure(const char* name,
+             uint32_t threads,
+             uint32_t count,
+             uint32_t size,
+             void (*func)(rim::EmulatePtr, uint32_t, uint32_t)) {
+    rim::EmulatePtr emu = rim::Emulate::create(4, 0x10000);
+    std::vector<std::thread> pool;
+    uint32_t x;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < threads; x++) pool.push_back(std::thread(func, emu, x + 1, count));
+    for (x = 0; x < threads; x++) pool[x].join();
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    double trans = (double)threads * count;
+    printf("%-10s threads=%u : %8.3f Mtrans/s, %9.1f MB/s\n",
+           name,
+           threads,
+           trans / dur.count() / 1.0e6,
+           trans * size / dur.count() / 1.0e6);
+}
+
+int main(int argc, char** argv) {
+    uint32_t count      = 500000;
+    uint32_t threads[3] = {1, 4, 8};
+    uint32_t x;
+
+    if (argc > 1) count = atoi(argv[1]);
+
+    for (x = 0; x < 3; x++) measure("random", threads[x], count, 4, runRandom);
+    for (x = 0; x < 3; x++) measure("sequential", threads[x], count / 50, 0x10000, runSequential);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Frame copy benchmark. Compares the frame copy helpers against a per buffer
+ * memcpy loop and a copy through an iovec list, for single and multi buffer frames.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <rogue/interfaces/stream/Frame.h>
+#include <rogue/interfaces/stream/FrameIterator.h>
+#include <rogue/interfaces/stream/Pool.h>
+
+namespace ris = rogue::interfaces::stream;
+
+// Copy loop used before bulk copies were added
+void legacyFromFrame(ris::FrameIterator& iter, uint32_t size, uint8_t* dst) {
+    uint32_t csize;
+
+    do {
+        csize = (size > iter.remBuffer()) ? iter.remBuffer() : size;
+        std::memcpy(dst, iter.ptr(), csize);
+        dst += csize;
+        iter += csize;
+        size -= csize;
+    } while (size > 0 && csize > 0);
+}
+
+// Copy from a frame through an iovec list
+void iovecFromFrame(ris::FrameIterator& iter, uint32_t size, uint8_t* dst) {
+    std::vector<struct iovec> iov;
+
+    ris::toIovec(iter, size, iov);
+    for (uint32_t x = 0; x < iov.size(); x++) {
+        std::memcpy(dst, iov[x].iov_base, iov[x].iov_len);
+        dst += iov[x].iov_len;
+    }
+}
+
+template <typename F>
+double measure(uint32_t count, F func) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t x = 0; x < count; x++) func();
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+    return dur.count();
+}
+
+void report(const char* name, uint32_t size, uint32_t buffSize, uint32_t count, double time) {
+    printf("%-12s size=%9u buffer=%8u : %8.2f GB/s\n",
+           name,
+           size,
+           buffSize,
+           ((double)size * (double)count) / (time * 1.0e9));
+}
+
+int main(int argc, char** argv) {
+    uint32_t sizes[]   = {65536, 1048576, 67108864};
+    uint32_t buffers[] = {0, 8192, 1048576};
+
+    for (uint32_t s = 0; s < 3; s++) {
+        for (uint32_t b = 0; b < 3; b++) {
+            uint32_t size  = sizes[s];
+            uint32_t buff  = buffers[b];
+            uint32_t count = (uint32_t)(4294967296ULL / size);
+
+            if (buff >= size) continue;
+
+            ris::PoolPtr pool = std::make_shared<ris::Pool>();
+            pool->setFixedSize(buff);
+
+            ris::FramePtr src = pool->acceptReq(size, false);
+            ris::FramePtr dst = pool->acceptReq(size, false);
+            std::vector<uint8_t> data(size, 0x5A);
+
+            src->setPayload(size);
+            dst->setPayload(size);
+
+            report("legacy",
+                   size,
+                   buff,
+                   count,
+                   measure(count, [&]() {
+                       ris::FrameIterator it = src->begin();
+                       legacyFromFrame(it, size, data.data());
+                   }));
+
+            report("fromFrame",
+                   size,
+                   buff,
+                   count,
+                   measure(count, [&]() {
+                       ris::FrameIterator it = src->begin();
+                       ris::fromFrame(it, size, data.data());
+                   }));
+
+            report("toFrame",
+                   size,
+                   buff,
+                   count,
+                   measure(count, [&]() {
+                       ris::FrameIterator it = dst->begin();
+                       ris::toFrame(it, size, data.data());
+                   }));
+
+            report("copyFrame",
+                   size,
+                   buff,
+                   count,
+                   measure(count, [&]() {
+                       ris::FrameIterator sit = src->begin();
+                       ris::FrameIterator dit = dst->begin();
+                       ris::copyFrame(sit, size, dit);
+                   }));
+
+            report("iovec",
+                   size,
+                   buff,
+                   count,
+                   measure(count, [&]() {
+                       ris::FrameIterator it = src->begin();
+                       iovecFromFrame(it, size, data.data());
+                   }));
+        }
+    }
+    return 0;
+}
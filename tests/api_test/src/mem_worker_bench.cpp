@@ -0,0 +1,199 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Memory worker pool benchmark. Write transactions to several address
+ * regions are serviced by a MemWorkerPool whose handler blocks for a fixed
+ * time, standing in for a register access driver call. Each transaction
+ * carries a sequence number which is checked to stay in order per region.
+ * A single worker is also checked to service transactions to different
+ * regions in the order they were posted.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rogue/hardware/MemWorkerPool.h>
+#include <rogue/interfaces/memory/Constants.h>
+#include <rogue/interfaces/memory/Master.h>
+#include <rogue/interfaces/memory/Slave.h>
+#include <rogue/interfaces/memory/Transaction.h>
+#include <rogue/interfaces/memory/TransactionLock.h>
+
+namespace rh  = rogue::hardware;
+namespace rim = rogue::interfaces::memory;
+
+static const uint32_t RegionCount = 8;
+static const uint64_t RegionSize  = 0x10000;
+
+// Slave servicing transactions with a worker pool
+class PoolSlave : public rim::Slave {
+  public:
+    rh::MemWorkerPoolPtr pool;
+    std::chrono::microseconds delay;
+    uint32_t last[RegionCount];
+    uint32_t errors;
+
+    PoolSlave(uint32_t delayUs) : rim::Slave(4, 0xFFFFFFFF), delay(delayUs), errors(0) {
+        for (uint32_t x = 0; x < RegionCount; x++) last[x] = 0;
+        pool = rh::MemWorkerPool::create(std::bind(&PoolSlave::process, this, std::placeholders::_1), "bench");
+    }
+
+    ~PoolSlave() {
+        pool->stop();
+    }
+
+    void doTransaction(rim::TransactionPtr tran) {
+        pool->push(tran);
+    }
+
+    void process(rim::TransactionPtr tran) {
+        rim::TransactionLockPtr lock = tran->lock();
+        uint32_t region              = tran->address() / RegionSize;
+        uint32_t seq                 = *((uint32_t*)tran->begin());
+
+        std::this_thread::sleep_for(delay);
+
+        if (seq != last[region] + 1) errors++;
+        last[region] = seq;
+        tran->done();
+    }
+};
+
+void measure(uint32_t workers, uint32_t batch, uint32_t delayUs, uint32_t count) {
+    std::shared_ptr<PoolSlave> slave = std::make_shared<PoolSlave>(delayUs);
+    std::vector<rim::MasterPtr> mast;
+    std::vector<uint32_t> data(count * RegionCount);
+    uint32_t x;
+    uint32_t y;
+
+    slave->pool->setWorkerCount(workers);
+    slave->pool->setBatchSize(batch);
+    slave->pool->setRegionSize(RegionSize);
+
+    for (y = 0; y < RegionCount; y++) {
+        mast.push_back(rim::Master::create());
+        mast[y]->setSlave(slave);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) {
+        for (y = 0; y < RegionCount; y++) {
+            data[x * RegionCount + y] = x + 1;
+            mast[y]->reqTransaction(y * RegionSize + x * 4 % 0x100, 4, &(data[x * RegionCount + y]), rim::Write);
+        }
+    }
+    for (y = 0; y < RegionCount; y++) mast[y]->waitTransaction(0);
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    printf("workers=%2u batch=%3u : %9.1f ktran/s, queue mean %9.1f us, max %9.1f us, service %6.1f us, errors %u\n",
+           workers,
+           batch,
+           (double)count * RegionCount / dur.count() / 1.0e3,
+           slave->pool->getQueueLatency() * 1.0e6,
+           slave->pool->getQueueLatencyMax() * 1.0e6,
+           slave->pool->getServiceTime() * 1.0e6,
+           slave->errors);
+}
+
+// Slave recording the order its single worker services transactions
+class OrderSlave : public rim::Slave {
+  public:
+    rh::MemWorkerPoolPtr pool;
+    std::mutex mtx;
+    std::condition_variable cond;
+    bool gate;
+    std::vector<uint64_t> order;
+
+    OrderSlave() : rim::Slave(4, 0xFFFFFFFF), gate(false) {
+        pool = rh::MemWorkerPool::create(std::bind(&OrderSlave::process, this, std::placeholders::_1), "order");
+        pool->setRegionSize(RegionSize);
+    }
+
+    ~OrderSlave() {
+        pool->stop();
+    }
+
+    void doTransaction(rim::TransactionPtr tran) {
+        pool->push(tran);
+    }
+
+    void process(rim::TransactionPtr tran) {
+        rim::TransactionLockPtr lock = tran->lock();
+        std::unique_lock<std::mutex> gLock(mtx);
+
+        // Hold the worker until the rest of the transactions are queued
+        while (!gate) cond.wait(gLock);
+
+        order.push_back(tran->address());
+        tran->done();
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> gLock(mtx);
+        gate = true;
+        cond.notify_all();
+    }
+};
+
+// Posts A1, B1 and A2 behind a blocked transaction, expects them in post order
+bool checkOrder() {
+    std::shared_ptr<OrderSlave> slave = std::make_shared<OrderSlave>();
+    rim::MasterPtr mast               = rim::Master::create();
+    uint64_t addr[4]                  = {2 * RegionSize, 0x0, RegionSize, 0x4};
+    uint32_t data[4]                  = {0, 0, 0, 0};
+    uint32_t x;
+    bool pass;
+
+    mast->setSlave(slave);
+
+    for (x = 0; x < 4; x++) {
+        mast->reqTransaction(addr[x], 4, &(data[x]), rim::Write);
+
+        // Let the worker block on the first transaction
+        if (x == 0)
+            while (slave->pool->getQueueSize() != 0) std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+
+    slave->open();
+    mast->waitTransaction(0);
+
+    pass = (slave->order.size() == 4);
+    for (x = 0; pass && x < 4; x++) pass = (slave->order[x] == addr[x]);
+
+    printf("single worker order check : %s\n", pass ? "pass" : "fail");
+    return pass;
+}
+
+int main(int argc, char** argv) {
+    uint32_t workers[4] = {1, 2, 4, 8};
+    uint32_t count      = 500;
+    uint32_t x;
+
+    if (argc > 1) count = atoi(argv[1]);
+
+    if (!checkOrder()) return 1;
+
+    // Blocking register access
+    for (x = 0; x < 4; x++) measure(workers[x], 16, 20, count);
+
+    // Queue overhead without access time
+    measure(1, 1, 0, count * 20);
+    measure(1, 16, 0, count * 20);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * MemMap register copy benchmark. Measures MemMap::regCopy() with each access
+ * width against ordinary memory standing in for a register window. Real
+ * register space is much slower per access, so the relative access count is
+ * the figure of interest.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <rogue/hardware/MemMap.h>
+
+namespace rh = rogue::hardware;
+
+void measure(uint32_t size, uint32_t width, bool write, uint32_t count) {
+    std::vector<uint8_t> reg(size + 64);
+    std::vector<uint8_t> data(size + 1);
+    volatile uint8_t* rPtr;
+    uint32_t x;
+
+    // Register side is aligned, memory side is not
+    rPtr = (volatile uint8_t*)(((uintptr_t)reg.data() + 63) & ~(uintptr_t)63);
+    for (x = 0; x < size; x++) data[x + 1] = x & 0xFF;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) rh::MemMap::regCopy(rPtr, data.data() + 1, size, width, write);
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    printf("size=%8u width=%2u %s : %8.3f GB/s, %8.1f Maccess/s\n",
+           size,
+           width,
+           write ? "write" : "read ",
+           (double)size * count / dur.count() / 1.0e9,
+           (double)(size / width) * count / dur.count() / 1.0e6);
+}
+
+int main(int argc, char** argv) {
+    uint32_t sizes[3]  = {64, 4096, 0x100000};
+    uint32_t widths[3] = {4, 8, 16};
+    uint64_t total     = 0x40000000;
+    uint32_t x;
+    uint32_t y;
+
+    if (argc > 1) total = strtoull(argv[1], NULL, 0);
+
+    for (x = 0; x < 3; x++) {
+        for (y = 0; y < 3; y++) {
+            measure(sizes[x], widths[y], true, total / sizes[x]);
+            measure(sizes[x], widths[y], false, total / sizes[x]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * Memory transaction benchmark. Measures the cost of issuing register
+ * transactions through a memory Master, directly and through a Hub which
+ * splits each transaction, and counts heap allocations per transaction.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include <rogue/interfaces/memory/Constants.h>
+#include <rogue/interfaces/memory/Hub.h>
+#include <rogue/interfaces/memory/Master.h>
+#include <rogue/interfaces/memory/Slave.h>
+#include <rogue/interfaces/memory/Transaction.h>
+#include <rogue/interfaces/memory/TransactionLock.h>
+
+namespace rim = rogue::interfaces::memory;
+
+// Heap allocation counter
+static std::atomic<uint64_t> allocCount(0);
+
+void* operator new(std::size_t size) {
+    allocCount++;
+    void* ptr = malloc(size);
+    if (ptr == NULL) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    free(ptr);
+}
+
+// Slave which completes each transaction immediately
+class BenchSlave : public rim::Slave {
+  public:
+    BenchSlave(uint32_t min, uint32_t max) : rim::Slave(min, max) {}
+
+    void doTransaction(rim::TransactionPtr tran) {
+        rim::TransactionLockPtr lock = tran->lock();
+        if (tran->type() == rim::Read) memset(tran->begin(), 0, tran->size());
+        tran->done();
+    }
+};
+
+void run(const char* name, rim::MasterPtr mast, uint32_t size, uint32_t count) {
+    uint8_t data[64];
+    uint64_t allocs;
+    uint32_t x;
+
+    memset(data, 0, sizeof(data));
+
+    // Warm up the object caches
+    for (x = 0; x < 1000; x++) mast->reqTransaction(0, size, data, rim::Read);
+    mast->waitTransaction(0);
+
+    allocs = allocCount;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) {
+        mast->reqTransaction(0, size, data, rim::Read);
+        mast->waitTransaction(0);
+    }
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    allocs = allocCount - allocs;
+
+    printf("%-8s size=%2u : %8.1f ns/transaction, %6.3f allocations/transaction\n",
+           name,
+           size,
+           (dur.count() * 1.0e9) / count,
+           (double)allocs / count);
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = 1000000;
+
+    if (argc > 1) count = atoi(argv[1]);
+
+    std::shared_ptr<BenchSlave> slave = std::make_shared<BenchSlave>(4, 4);
+    rim::HubPtr hub                   = rim::Hub::create(0, 4, 4);
+    rim::MasterPtr direct             = rim::Master::create();
+    rim::MasterPtr split              = rim::Master::create();
+
+    direct->setSlave(slave);
+    hub->setSlave(slave);
+    split->setSlave(hub);
+
+    run("direct", direct, 4, count);
+    run("hub", split, 32, count / 8);
+    return 0;
+}
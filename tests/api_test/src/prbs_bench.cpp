@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ * PRBS benchmark. The word parallel engine is first checked against the bit
+ * serial LFSR it replaces, then its generation rate is compared with it.
+ * Finally frames are generated by a Prbs transmitter with one or more
+ * threads and checked by a Prbs receiver.
+ * ----------------------------------------------------------------------------
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <rogue/utilities/Prbs.h>
+#include <rogue/utilities/PrbsEngine.h>
+
+namespace ru = rogue::utilities;
+
+// Bit serial reference, one shift per call
+void flfsr(uint8_t* data, uint32_t byteWidth, uint32_t tapCnt, const uint8_t* taps) {
+    uint32_t x;
+    bool msbOut;
+    bool lsbIn = false;
+
+    for (x = 0; x < tapCnt; x++) lsbIn ^= ((data[taps[x] / 8] >> (taps[x] % 8)) & 0x1);
+
+    for (x = 0; x < byteWidth; x++) {
+        msbOut = data[x] & 0x80;
+        data[x] <<= 1;
+        data[x] |= lsbIn;
+        lsbIn = msbOut;
+    }
+}
+
+// Compare the engine with the reference, filling in uneven pieces
+bool verify(uint32_t width, uint32_t tapCnt, const uint8_t* taps, uint32_t seed, uint32_t count) {
+    uint32_t byteWidth = width / 8;
+    std::vector<uint8_t> exp(count * byteWidth);
+    std::vector<uint8_t> got(count * byteWidth);
+    uint8_t data[64];
+    ru::PrbsEngine eng;
+    uint32_t done;
+    uint32_t n;
+    uint32_t x;
+
+    memset(data, 0, sizeof(data));
+    memcpy(data, &seed, 4);
+
+    eng.setup(width, tapCnt, taps);
+    eng.seed(data);
+
+    for (x = 0; x < count; x++) {
+        flfsr(data, byteWidth, tapCnt, taps);
+        memcpy(&exp[x * byteWidth], data, byteWidth);
+    }
+
+    for (done = 0, n = 1; done < count; done += n, n = n * 3 + 1) {
+        if (n > count - done) n = count - done;
+        eng.fill(&got[done * byteWidth], n);
+    }
+
+    for (x = 0; x < count && memcmp(&exp[x * byteWidth], &got[x * byteWidth], byteWidth) == 0; x++) {}
+
+    printf("verify width=%3u taps=%u seed=0x%08x : %s", width, tapCnt, seed, (x == count) ? "ok\n" : "MISMATCH");
+    if (x != count) printf(" at word %u\n", x);
+    return x == count;
+}
+
+void measure(uint32_t width, uint32_t size, uint32_t count) {
+    uint8_t taps[4]    = {1, 2, 6, 31};
+    uint32_t byteWidth = width / 8;
+    uint32_t words     = size / byteWidth;
+    std::vector<uint8_t> buff(size);
+    uint8_t data[64];
+    ru::PrbsEngine eng;
+    uint32_t x;
+    uint32_t y;
+
+    memset(data, 0, sizeof(data));
+    eng.setup(width, 4, taps);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (x = 0; x < count; x++) {
+        eng.seed(data);
+        eng.fill(buff.data(), words);
+    }
+    std::chrono::duration<double> fast = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (x = 0; x < count / 16 + 1; x++) {
+        for (y = 0; y < words; y++) {
+            flfsr(data, byteWidth, 4, taps);
+            memcpy(&buff[y * byteWidth], data, byteWidth);
+        }
+    }
+    std::chrono::duration<double> ref = std::chrono::steady_clock::now() - start;
+
+    printf("width=%3u size=%8u : engine %8.2f Gb/s, bit serial %6.2f Gb/s\n",
+           width,
+           size,
+           (double)size * count * 8.0 / fast.count() / 1.0e9,
+           (double)size * (count / 16 + 1) * 8.0 / ref.count() / 1.0e9);
+}
+
+void measureFrames(uint32_t width, uint32_t size, uint32_t threads, double secs) {
+    ru::PrbsPtr tx = ru::Prbs::create();
+    ru::PrbsPtr rx = ru::Prbs::create();
+
+    tx->setWidth(width);
+    rx->setWidth(width);
+    tx->setTxThreads(threads);
+    tx->addSlave(rx);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    tx->enable(size);
+    std::this_thread::sleep_for(std::chrono::duration<double>(secs));
+    tx->disable();
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - start;
+
+    printf("frames width=%3u size=%8u threads=%u : %8.2f Gb/s, %u frames, %u rx errors\n",
+           width,
+           size,
+           threads,
+           (double)rx->getRxCount() * size * 8.0 / dur.count() / 1.0e9,
+           rx->getRxCount(),
+           rx->getRxErrors());
+}
+
+int main(int argc, char** argv) {
+    uint8_t defTaps[4]  = {1, 2, 6, 31};
+    uint8_t wideTaps[6] = {0, 5, 63, 100, 101, 127};
+    uint32_t widths[5]  = {32, 64, 128, 256, 512};
+    uint32_t sizes[3]   = {1024, 0x10000, 0x100000};
+    uint32_t threads[3] = {1, 2, 4};
+    double secs         = 1.0;
+    bool ok             = true;
+    uint32_t x;
+    uint32_t y;
+
+    if (argc > 1) secs = atof(argv[1]);
+
+    for (x = 0; x < 5; x++) {
+        ok &= verify(widths[x], 4, defTaps, 0, 20000);
+        ok &= verify(widths[x], 4, defTaps, 0x12345678, 20000);
+    }
+    ok &= verify(128, 6, wideTaps, 0xdeadbeef, 40000);
+    ok &= verify(96, 3, defTaps, 0x55, 20000);
+
+    for (x = 0; x < 3; x++) {
+        for (y = 0; y < 3; y++) measure(widths[x], sizes[y], 0x10000000 / sizes[y]);
+    }
+
+    for (x = 0; x < 3; x++) measureFrames(32, 0x100000, threads[x], secs);
+    measureFrames(128, 0x100000, 1, secs);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream as ris
+import rogue.protocols.batcher
+
+RecordCount = 50
+
+class RecordRx(ris.Slave):
+
+    def __init__(self):
+        ris.Slave.__init__(self)
+        self.records = []
+
+    def _acceptFrame(self, frame):
+        with frame.lock():
+            data = bytearray(frame.getPayload())
+            frame.read(data, 0)
+            self.records.append((frame.getChannel(), frame.getFirstUser(), frame.getLastUser(), data))
+
+def make_records():
+    return [(i % 4, i & 0xFF, (i * 3) & 0xFF, bytearray((i + j) & 0xFF for j in range(1 + (i * 37) % 200)))
+            for i in range(RecordCount)]
+
+# Build a version 1 super frame with a 64-bit width
+def super_frame(records, seq):
+    ba = bytearray([0x21, seq]) + bytearray(6)
+
+    for dest, fUser, lUser, data in records:
+        pad = (8 - len(data) % 8) % 8
+        ba += data + bytearray(pad)
+        ba += len(data).to_bytes(4, 'little') + bytes([dest, fUser, lUser, 8 - pad])
+
+    return ba
+
+def run_splitter(zeroCopy, fixedSize):
+    split = rogue.protocols.batcher.SplitterV1()
+    split.setZeroCopy(zeroCopy)
+    if fixedSize:
+        split.setFixedSize(fixedSize)
+
+    mast = ris.Master()
+    rx   = RecordRx()
+    mast >> split >> rx
+
+    records = make_records()
+    ba      = super_frame(records, 7)
+
+    frame = mast._reqFrame(len(ba), True)
+    frame.write(ba, 0)
+    mast._sendFrame(frame)
+
+    if rx.records != records:
+        raise AssertionError(f'Record mismatch with zeroCopy={zeroCopy} fixedSize={fixedSize}')
+
+    return split
+
+def test_batcher_splitter():
+    split = run_splitter(False, 0)
+    if split.getSliceCount() != 0 or split.getCopyCount() != RecordCount:
+        raise AssertionError('Unexpected slices in copy mode')
+
+    core = split.getCore()
+    if core.getFrameCount() != 1 or core.getFastCount() != 1 or core.getRecordCount() != RecordCount:
+        raise AssertionError('Unexpected parse stats for single buffer frame')
+
+    split = run_splitter(True, 0)
+    if split.getSliceCount() != RecordCount or split.getCopyCount() != 0:
+        raise AssertionError('Unexpected copies in zero copy mode')
+
+    # Records straddling buffers fall back to copies
+    split = run_splitter(True, 512)
+    if split.getCopyCount() == 0 or split.getSliceCount() + split.getCopyCount() != RecordCount:
+        raise AssertionError(f'Unexpected counts: slices={split.getSliceCount()} copies={split.getCopyCount()}')
+
+    # Multi buffer frames use the iterator parser
+    core = split.getCore()
+    if core.getFastCount() != 0 or core.getRecordCount() != RecordCount:
+        raise AssertionError('Unexpected parse stats for multi buffer frame')
+
+if __name__ == "__main__":
+    test_batcher_splitter()
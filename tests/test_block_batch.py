@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import pyrogue as pr
+import pyrogue.interfaces.simulation
+import rogue.interfaces.memory as rim
+
+NumRegs = 32
+
+class RegDevice(pr.Device):
+
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i in range(NumRegs):
+            self.add(pr.RemoteVariable(
+                name      = f'Reg[{i}]',
+                offset    = 4*i,
+                bitSize   = 32,
+                base      = pr.UInt,
+                mode      = 'RW'))
+
+# Emulator which fails merged transactions while reporting a large max access
+class SmallEmulate(pyrogue.interfaces.simulation.MemEmulate):
+
+    def __init__(self):
+        super().__init__(maxSize=4)
+
+    def _doMaxAccess(self):
+        return 0x1000
+
+class DummyTree(pr.Root):
+
+    def __init__(self, sim):
+        pr.Root.__init__(self,
+            name='dummyTree',
+            description="Dummy tree for example",
+            timeout=2.0,
+            pollEn=False)
+
+        self.addInterface(sim)
+
+        self.add(RegDevice(
+            name    = 'RegDevice',
+            offset  = 0,
+            memBase = sim))
+
+def test_block_batch():
+
+    sim = rim.Emulate(4,0x1000)
+
+    with DummyTree(sim) as root:
+        dev    = root.RegDevice
+        blocks = dev._blocks
+        batch  = rim.BlockBatch()
+
+        # Write all registers as a single merged transaction
+        for i in range(NumRegs):
+            dev.Reg[i].set(i * 0x01010101, write=False)
+
+        batch.transaction(blocks, rim.Write, False, True)
+        batch.transaction(blocks, rim.Verify, False, True)
+
+        if batch.getBlockCount() != 2 * NumRegs or batch.getTransactionCount() != 2:
+            raise AssertionError(f'Unexpected batch stats: blocks={batch.getBlockCount()} trans={batch.getTransactionCount()}')
+
+        if batch.getCoalesceRatio() != NumRegs:
+            raise AssertionError(f'Unexpected coalesce ratio {batch.getCoalesceRatio()}')
+
+        # Update memory behind the blocks and read it back through the batch
+        mast = rim.Master()
+        mast._setSlave(sim)
+        for i in range(NumRegs):
+            mast._reqTransaction(4*i, (0x1000 + i).to_bytes(4,'little'), 4, 0, rim.Write)
+        mast._waitTransaction(0)
+
+        batch.resetStats()
+        batch.transaction(blocks, rim.Read, False, True)
+
+        for i in range(NumRegs):
+            if dev.Reg[i].get(read=False) != 0x1000 + i:
+                raise AssertionError(f'Batch read mismatch for Reg[{i}]')
+
+        # Every other block is stale, merged ranges must stop at the gaps
+        for i in range(0, NumRegs, 2):
+            dev.Reg[i].set(i, write=False)
+
+        batch.resetStats()
+        batch.transaction(blocks, rim.Write, False, True)
+
+        if batch.getBlockCount() != NumRegs // 2 or batch.getMergeCount() != 0:
+            raise AssertionError(f'Unexpected merge of non contiguous blocks: merged={batch.getMergeCount()}')
+
+def test_block_batch_retry():
+
+    sim = SmallEmulate()
+
+    with DummyTree(sim) as root:
+        dev    = root.RegDevice
+        batch  = rim.BlockBatch()
+
+        for i in range(NumRegs):
+            dev.Reg[i].set(i + 7, write=False)
+
+        # Merged transaction fails and is retried per block
+        batch.transaction(dev._blocks, rim.Write, False, True)
+
+        if batch.getRetryCount() != NumRegs:
+            raise AssertionError(f'Unexpected retry count {batch.getRetryCount()}')
+
+        for i in range(NumRegs):
+            if dev.Reg[i].get() != i + 7:
+                raise AssertionError(f'Retry write mismatch for Reg[{i}]')
+
+if __name__ == "__main__":
+    test_block_batch()
+    test_block_batch_retry()
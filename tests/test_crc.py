@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import random
+import zlib
+import rogue.protocols.packetizer
+
+# zlib.crc32 computes the same CRC-32 as CRC::CRC_32() from CRC.h
+def test_crc32():
+    crc32 = rogue.protocols.packetizer.Crc32
+    rand  = random.Random(1234)
+    data  = bytes(rand.getrandbits(8) for _ in range(4096))
+
+    for engine in range(3):
+        for size in list(range(0, 300)) + [1024, 1500, 4000]:
+            for off in range(0, 4):
+                block = data[off:off+size]
+                ref   = zlib.crc32(block)
+
+                if crc32.calculate(block, 0, engine) != ref:
+                    raise AssertionError(f'CRC mismatch: engine={engine} size={size} offset={off}')
+
+                # Continue the calculation over a second block
+                if crc32.calculate(data[:77], ref, engine) != zlib.crc32(data[:77], ref):
+                    raise AssertionError(f'Chained CRC mismatch: engine={engine} size={size} offset={off}')
+
+if __name__ == "__main__":
+    test_crc32()
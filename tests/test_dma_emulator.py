@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import time
+import rogue.hardware.axi
+import rogue.interfaces.stream as ris
+
+FrameCount = 100
+
+class FrameRx(ris.Slave):
+
+    def __init__(self):
+        ris.Slave.__init__(self)
+        self.frames = []
+
+    def _acceptFrame(self, frame):
+        with frame.lock():
+            data = bytearray(frame.getPayload())
+            frame.read(data, 0)
+            self.frames.append(data)
+
+def make_frame(i, maxSize):
+    return bytearray((i + j) & 0xFF for j in range(1 + (i * 997) % maxSize))
+
+def wait_frames(rx, count):
+    for _ in range(500):
+        if len(rx.frames) >= count:
+            break
+        time.sleep(0.01)
+
+def run_loopback(path, dests, maxSize):
+    emu = rogue.hardware.axi.DmaEmulator(path, 64, 64, 4096)
+
+    mast = {}
+    rx   = {}
+    dma  = {}
+    for d in dests:
+        mast[d] = ris.Master()
+        rx[d]   = FrameRx()
+        dma[d]  = rogue.hardware.axi.AxiStreamDma(path, d, True)
+        mast[d] >> dma[d] >> rx[d]
+
+    sent = {d: [] for d in dests}
+    for i in range(FrameCount):
+        d  = dests[i % len(dests)]
+        ba = make_frame(i, maxSize)
+
+        frame = mast[d]._reqFrame(len(ba), True)
+        frame.write(ba, 0)
+        mast[d]._sendFrame(frame)
+        sent[d].append(ba)
+
+    for d in dests:
+        wait_frames(rx[d], len(sent[d]))
+        if rx[d].frames != sent[d]:
+            raise AssertionError(f'Frame mismatch on {path} dest {d}')
+
+    if emu.getDropCount() != 0 or emu.getRxCount() != emu.getTxCount():
+        raise AssertionError(f'Unexpected buffer counts on {path}')
+
+    for d in dests:
+        dma[d]._stop()
+
+def test_dma_emulator():
+    # Zero copy frames span several buffers
+    run_loopback('/dev/emu_loop', [1], 10000)
+
+    # Copy mode writes and reads through user memory, one buffer per frame
+    rogue.hardware.axi.AxiStreamDma.zeroCopyDisable('/dev/emu_copy')
+    run_loopback('/dev/emu_copy', [1], 4096)
+
+    # Shared receive engine with several destinations
+    rogue.hardware.axi.AxiStreamDma.sharedRxEnable('/dev/emu_shared')
+    run_loopback('/dev/emu_shared', [0, 5, 0x101], 10000)
+
+if __name__ == "__main__":
+    test_dma_emulator()
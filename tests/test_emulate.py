@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import os
+import tempfile
+import rogue.interfaces.memory as rim
+
+def write(mast, addr, data):
+    mast._reqTransaction(addr, bytearray(data), len(data), 0, rim.Write)
+    mast._waitTransaction(0)
+
+def read(mast, addr, size):
+    data = bytearray(size)
+    mast._reqTransaction(addr, data, size, 0, rim.Read)
+    mast._waitTransaction(0)
+    return data
+
+def test_emulate_pages():
+    emu = rim.Emulate(4, 0x10000)
+    emu.setPageSize(256)
+
+    mast = rim.Master()
+    mast._setSlave(emu)
+
+    # Transactions spanning pages, including one near the top of the address space
+    pattern = bytearray(range(256)) * 4
+    write(mast, 0x1080, pattern)
+    write(mast, 0xFFFFFFFFFFFFF000, pattern)
+
+    if read(mast, 0x1080, len(pattern)) != pattern:
+        raise AssertionError('Read back mismatch across pages')
+
+    if read(mast, 0xFFFFFFFFFFFFF000, len(pattern)) != pattern:
+        raise AssertionError('Read back mismatch at top of address space')
+
+    # Untouched memory reads as zero
+    if read(mast, 0x100000, 16) != bytearray(16):
+        raise AssertionError('Untouched memory is not zero')
+
+    if emu.getPageCount() != 10:
+        raise AssertionError(f'Unexpected page count {emu.getPageCount()}')
+
+    # Page size can not change after the first access
+    try:
+        emu.setPageSize(4096)
+        raise AssertionError('Page size changed after access')
+    except Exception as e:
+        if 'before the first access' not in str(e):
+            raise e
+
+def test_emulate_file():
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'emulate.bin')
+
+        emu = rim.Emulate(4, 0x10000)
+        emu.mapFile(path, 0x100000)
+
+        mast = rim.Master()
+        mast._setSlave(emu)
+
+        write(mast, 0x0FFFF0, bytearray(range(32)))
+        del mast, emu
+
+        # Contents persist in the file, addresses above the file use pages
+        emu = rim.Emulate(4, 0x10000)
+        emu.mapFile(path, 0x100000)
+
+        mast = rim.Master()
+        mast._setSlave(emu)
+
+        if read(mast, 0x0FFFF0, 32) != bytearray(range(16)) + bytearray(16):
+            raise AssertionError('File backed memory did not persist')
+
+        if emu.getPageCount() != 1:
+            raise AssertionError(f'Unexpected page count {emu.getPageCount()}')
+
+if __name__ == "__main__":
+    test_emulate_pages()
+    test_emulate_file()
@@ -19,14 +19,17 @@ import time
 FrameCount = 10000
 FrameSize  = 10000
 
-def fifo_path():
+def fifo_path(lockFree=False, workers=1, maxDepth=0, policy=None):
 
     # PRBS
     prbsTx = rogue.utilities.Prbs()
     prbsRx = rogue.utilities.Prbs()
 
     # FIFO
-    fifo = rogue.interfaces.stream.Fifo(0,0,False)
+    fifo = rogue.interfaces.stream.Fifo(maxDepth,0,False,lockFree,workers,workers > 1)
+
+    if policy is not None:
+        fifo.setDropPolicy(policy)
 
     # Client stream
     prbsTx >> fifo >> prbsRx
@@ -51,8 +54,60 @@ def fifo_path():
 
     print("Done testing")
 
+def fifo_attach():
+
+    # PRBS
+    prbsTx = rogue.utilities.Prbs()
+    prbsA  = rogue.utilities.Prbs()
+    prbsB  = rogue.utilities.Prbs()
+
+    # Ordered FIFO with several workers
+    fifo = rogue.interfaces.stream.Fifo(0,0,False,False,4,True)
+
+    prbsTx >> fifo >> prbsA
+
+    prbsA.checkPayload(True)
+    prbsB.checkPayload(True)
+
+    print("Generating Frames")
+    for _ in range(FrameCount // 2):
+        prbsTx.genFrame(FrameSize)
+
+    # Attach a second slave while frames are in flight
+    fifo >> prbsB
+
+    for _ in range(FrameCount // 2):
+        prbsTx.genFrame(FrameSize)
+
+    # Wait at least 30 seconds for frames to go through
+    for i in range(300):
+        if prbsA.getRxCount() == FrameCount:
+            break
+        time.sleep(.1)
+
+    # Frames are checked to arrive in sequence by each slave
+    for prbsRx in [prbsA, prbsB]:
+        if prbsRx.getRxErrors() != 0:
+            raise AssertionError('PRBS Frame errors detected! Errors = {}'.format(prbsRx.getRxErrors()))
+
+    if prbsA.getRxCount() != FrameCount:
+        raise AssertionError('Frame count error. Got = {} expected = {}'.format(prbsA.getRxCount(),FrameCount))
+
+    if prbsB.getRxCount() < FrameCount // 2:
+        raise AssertionError('Frame count error. Got = {} expected at least = {}'.format(prbsB.getRxCount(),FrameCount // 2))
+
+    print("Done testing")
+
 def test_fifo_path():
     fifo_path()
+    fifo_path(True)
+    fifo_path(False, 4)
+    fifo_path(True, 4)
+    fifo_path(False, 1, 100, rogue.interfaces.stream.Fifo.Block)
+
+def test_fifo_attach():
+    fifo_attach()
 
 if __name__ == "__main__":
     test_fifo_path()
+    test_fifo_attach()
@@ -19,6 +19,8 @@ import pyrogue.utilities.fileio
 import pyrogue
 import time
 import rogue
+import os
+import tempfile
 
 #rogue.Logging.setLevel(rogue.Logging.Debug)
 
@@ -96,6 +98,96 @@ def file_reader():
             if header.error != 0:
                 raise AssertionError('Error Flag detected in FileReader')
 
+def async_path(direct, uring):
+
+    with tempfile.TemporaryDirectory() as tmp:
+        name = os.path.join(tmp, "async.dat")
+
+        fwr = rogue.utilities.fileio.StreamWriter()
+        fwr.setBufferSize(16384)
+        fwr.setAsync(3)
+        fwr.setDirectIo(direct)
+        fwr.setIoUring(uring)
+        fwr.setSyncInterval(MaxSize)
+        fwr.setMaxSize(MaxSize)
+
+        prbsTx = rogue.utilities.Prbs()
+        prbsTx >> fwr.getChannel(0)
+
+        fwr.open(name)
+
+        for _ in range(1000):
+            prbsTx.genFrame(FrameSize)
+
+        fwr.close()
+
+        if fwr.getFrameCount() != 1000:
+            raise AssertionError('Async write error. Got = {} frames'.format(fwr.getFrameCount()))
+
+        if fwr.getWriteQueueDepth() != 0 or fwr.getWriteBandwidth() <= 0.0:
+            raise AssertionError('Async write error. Bad write statistics')
+
+        frd = rogue.utilities.fileio.StreamReader()
+        frd.setIoUring(uring)
+        prbsRx = rogue.utilities.Prbs()
+        frd >> prbsRx
+
+        frd.open(name + ".1")
+        frd.closeWait()
+
+        if prbsRx.getRxCount() != 1000 or prbsRx.getRxErrors() != 0:
+            raise AssertionError('Async read error. Got = {} frames, {} errors'.format(prbsRx.getRxCount(),prbsRx.getRxErrors()))
+
+def test_file_async():
+    async_path(False, False)
+    async_path(True, False)
+    async_path(False, True)
+    async_path(True, True)
+
+def test_file_mapped():
+
+    with tempfile.TemporaryDirectory() as tmp:
+        name = os.path.join(tmp, "mapped.dat")
+
+        fwr = rogue.utilities.fileio.StreamWriter()
+        fwr.setMaxSize(MaxSize)
+
+        prbsA = rogue.utilities.Prbs()
+        prbsB = rogue.utilities.Prbs()
+        prbsA >> fwr.getChannel(0)
+        prbsB >> fwr.getChannel(5)
+
+        fwr.open(name)
+
+        for i in range(1000):
+            prbsA.genFrame(FrameSize)
+            if i % 2 == 0:
+                prbsB.genFrame(FrameSize * 2)
+
+        fwr.close()
+
+        # First open builds the sidecar index, later opens load it
+        for chan, count, zc, cached in [(0, 1000, False, False), (5, 500, True, True), (0, 1000, True, True)]:
+            frd = rogue.utilities.fileio.MappedStreamReader()
+            prbsRx = rogue.utilities.Prbs()
+            frd >> prbsRx
+
+            frd.open(name + ".1")
+
+            if frd.getIndexCached() != cached or frd.getFrameCount() != 1500:
+                raise AssertionError('Mapped read error. Got = {} frames'.format(frd.getFrameCount()))
+
+            frd.setChannelFilter(chan)
+            if frd.getFrameCount() != count or frd.getFrameChannel(count-1) != chan:
+                raise AssertionError('Mapped read error. Bad channel index')
+
+            frd.setZeroCopy(zc)
+            frd.readRange(0, count)
+            frd.close()
+
+            if prbsRx.getRxCount() != count or prbsRx.getRxErrors() != 0:
+                raise AssertionError('Mapped read error. Got = {} frames, {} errors'.format(prbsRx.getRxCount(),prbsRx.getRxErrors()))
+
 def test_file_compress():
     return
     write_files()
@@ -143,6 +143,58 @@ class ListDevice(pr.Device):
             valueStride  = 1
         ))
 
+        self.add(pr.RemoteVariable(
+            name         = 'Int12List',
+            offset       = 0x8000,
+            bitSize      = 12 * 32,
+            bitOffset    = 0x0000,
+            base         = pr.Int,
+            mode         = 'RW',
+            disp         = '{}',
+            numValues    = 32,
+            valueBits    = 12,
+            valueStride  = 12
+        ))
+
+        self.add(pr.RemoteVariable(
+            name         = 'UInt10List',
+            offset       = 0x9000,
+            bitSize      = 13 * 32,
+            bitOffset    = 0x0003,
+            base         = pr.UInt,
+            mode         = 'RW',
+            disp         = '{}',
+            numValues    = 32,
+            valueBits    = 10,
+            valueStride  = 13
+        ))
+
+        self.add(pr.RemoteVariable(
+            name         = 'UInt16BEList',
+            offset       = 0xA000,
+            bitSize      = 32 * 32,
+            bitOffset    = 0x0000,
+            base         = pr.UIntBE,
+            mode         = 'RW',
+            disp         = '{}',
+            numValues    = 32,
+            valueBits    = 16,
+            valueStride  = 32
+        ))
+
+        self.add(pr.RemoteVariable(
+            name         = 'FixedList',
+            offset       = 0xB000,
+            bitSize      = 16 * 32,
+            bitOffset    = 0x0000,
+            base         = pr.Fixed(16,8),
+            mode         = 'RW',
+            disp         = '{}',
+            numValues    = 32,
+            valueBits    = 16,
+            valueStride  = 16
+        ))
+
 class DummyTree(pr.Root):
 
     def __init__(self):
@@ -382,6 +434,57 @@ def test_memory():
             # Test value shift
             _ = resA[0] >> 5
 
+def test_list_bulk():
+
+    Int12List    = np.array([random.randint(-2047,2047) for i in range(32)],np.int32)
+    UInt10List   = np.array([random.randint(0,1023) for i in range(32)],np.uint32)
+    UInt16BEList = np.array([random.randint(0,65535) for i in range(32)],np.uint32)
+    FixedList    = np.array([random.randint(-32768,32767) / 256.0 for i in range(32)],np.float64)
+
+    with DummyTree() as root:
+        dev = root.ListDevice
+
+        with root.updateGroup():
+            dev.Int12List.set(Int12List)
+            dev.UInt10List.set(UInt10List)
+            dev.UInt16BEList.set(UInt16BEList)
+            dev.FixedList.set(FixedList)
+
+        # Bulk decode must match the per element decode and the written values
+        for var, exp in [(dev.Int12List, Int12List), (dev.UInt10List, UInt10List),
+                         (dev.UInt16BEList, UInt16BEList), (dev.FixedList, FixedList)]:
+            res = var.get()
+
+            if res.dtype != exp.dtype:
+                raise AssertionError(f'Type mismatch for {var.name}: {res.dtype}')
+
+            for i in range(32):
+                if res[i] != exp[i] or var.get(index=i) != exp[i]:
+                    raise AssertionError(f'Bulk Verification Failure for {var.name} at position {i}')
+
+            if not np.array_equal(var._getArray(5,10), exp[5:15]):
+                raise AssertionError(f'Slice Verification Failure for {var.name}')
+
+        # Non contiguous arrays and partial updates
+        dev.UInt10List.set(np.arange(40,dtype=np.uint32)[::2],index=8)
+        UInt10List[8:28] = np.arange(40,dtype=np.uint32)[::2]
+
+        if not np.array_equal(dev.UInt10List.get(), UInt10List):
+            raise AssertionError('Strided set verification failure for UInt10List')
+
+        # Out of range values must not modify the list
+        try:
+            dev.Int12List.set(np.array([1,2,4096],np.int32),index=0)
+            raise AssertionError('Range error not raised for Int12List')
+        except pr.VariableError:
+            pass
+        except Exception as e:
+            if 'range error' not in str(e):
+                raise e
+
+        if not np.array_equal(dev.Int12List.get(), Int12List):
+            raise AssertionError('Partial update after range error for Int12List')
+
 def run_gui():
     import pyrogue.pydm
 
@@ -390,4 +493,5 @@ def run_gui():
 
 if __name__ == "__main__":
     test_memory()
+    test_list_bulk()
     #run_gui()
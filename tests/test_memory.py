@@ -79,6 +79,37 @@ class SimpleDev(pr.Device):
             mode         = "RW",
         ))
 
+        # Split fields sharing one word
+        self.add(pr.RemoteVariable(
+            name         = "SplitTestA",
+            offset       =  0x28,
+            bitSize      =  [5, 9, 7],
+            bitOffset    =  [3, 12, 30],
+            base         = pr.UInt,
+            mode         = "RW",
+            overlapEn    = True,
+        ))
+
+        self.add(pr.RemoteVariable(
+            name         = "SplitTestB",
+            offset       =  0x28,
+            bitSize      =  [6, 4],
+            bitOffset    =  [40, 33],
+            base         = pr.UInt,
+            mode         = "RW",
+            overlapEn    = True,
+        ))
+
+        self.add(pr.RemoteVariable(
+            name         = "SplitTestRaw",
+            offset       =  0x28,
+            bitSize      =  64,
+            bitOffset    =  0,
+            base         = pr.UInt,
+            mode         = "RO",
+            overlapEn    = True,
+        ))
+
 class MemDev(pr.Device):
 
     def __init__(self,modeConfig='RW',**kwargs):
@@ -127,7 +158,9 @@ class DummyTree(pr.Root):
 
         # Create a memory gateway
         ms = rogue.interfaces.memory.TcpServer("127.0.0.1",9080)
+        ms.setWindow(8)
         self.addInterface(ms)
+        self._memServer = ms
 
         # Connect the memory gateways together
         sim << ms
@@ -135,6 +168,7 @@ class DummyTree(pr.Root):
         # Create a memory gateway
         mc = rogue.interfaces.memory.TcpClient("127.0.0.1",9080)
         self.addInterface(mc)
+        self._memClient = mc
 
         # Add Device
         modeConfig = ['RW','RW','RO','RO']
@@ -198,6 +232,44 @@ def test_memory():
         if (retAA != 0x40) or (retAB != 0x80) or (retBA != 0x41) or (retBB != 0x42) or (retBC != 0x43) or (retBD != 0x44):
             raise AssertionError(f'Verification Failure: retAA={retAA}, retAB={retAB}, retBA={retBA}, retBB={retBB}, retBC={retBC}, retBD={retBD}')
 
+        # Split fields
+        root.SimpleDev.SplitTestA.set(0x15A5A3)
+        root.SimpleDev.SplitTestB.set(0x2B5)
+
+        expRaw  = (0x03 << 3) | (0x12D << 12) | (0x56 << 30)
+        expRaw |= (0x35 << 40) | (0xA << 33)
+
+        retA   = root.SimpleDev.SplitTestA.get()
+        retB   = root.SimpleDev.SplitTestB.get()
+        retRaw = root.SimpleDev.SplitTestRaw.get()
+
+        if (retA != 0x15A5A3) or (retB != 0x2B5) or (retRaw != expRaw):
+            raise AssertionError(f'Split field failure: retA={retA:#x}, retB={retB:#x}, retRaw={retRaw:#x}, expRaw={expRaw:#x}')
+
+        # Check the bridge statistics
+        ms = root._memServer
+        mc = root._memClient
+
+        if ms.getWindow() != 8 or ms.getMaxInFlight() < 1 or ms.getMaxInFlight() > 8 or ms.getInFlight() != 0:
+            raise AssertionError(f'Server window failure: maxInFlight={ms.getMaxInFlight()}, inFlight={ms.getInFlight()}')
+
+        if mc.getInFlight() != 0 or mc.getTransactionCount() != ms.getTransactionCount() or mc.getTransactionCount() == 0:
+            raise AssertionError(f'Transaction count failure: client={mc.getTransactionCount()}, server={ms.getTransactionCount()}')
+
+        if mc.getLatencyAvg() <= 0.0 or mc.getLatencyMax() < mc.getLatencyAvg():
+            raise AssertionError(f'Latency failure: avg={mc.getLatencyAvg()}, max={mc.getLatencyMax()}')
+
+        # Check the slave tracking statistics
+        hist = mc.getLatencyHistogram()
+
+        if mc.getOutstanding() != 0 or mc.getMaxOutstanding() < 1 or sum(hist) != mc.getTransactionCount():
+            raise AssertionError(f'Slave tracking failure: outstanding={mc.getOutstanding()}, completed={sum(hist)}')
+
+        mc.resetStats()
+
+        if sum(mc.getLatencyHistogram()) != 0 or mc.getTransactionCount() != 0:
+            raise AssertionError('Slave statistics reset failure')
+
 
 if __name__ == "__main__":
     test_memory()
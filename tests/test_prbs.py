@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : PRBS generator and checker test script
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.stream as ris
+import rogue.utilities
+import time
+
+FrameCount = 50
+
+class FrameRx(ris.Slave):
+
+    def __init__(self):
+        ris.Slave.__init__(self)
+        self.frames = []
+
+    def _acceptFrame(self, frame):
+        with frame.lock():
+            data = bytearray(frame.getPayload())
+            frame.read(data, 0)
+            self.frames.append(data)
+
+def check_width(width, bufferSize):
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    prbsTx.setWidth(width)
+    prbsRx.setWidth(width)
+
+    # Small buffers split words between buffers
+    prbsRx.setFixedSize(bufferSize)
+
+    prbsTx >> prbsRx
+
+    for i in range(FrameCount):
+        prbsTx.genFrame((3 + i * 37) * width // 8)
+
+    if prbsRx.getRxErrors() != 0:
+        raise AssertionError('PRBS Frame errors detected! Width = {} Errors = {}'.format(width,prbsRx.getRxErrors()))
+
+    if prbsRx.getRxCount() != FrameCount:
+        raise AssertionError('Frame count error. Got = {} expected = {}'.format(prbsRx.getRxCount(),FrameCount))
+
+def test_prbs_widths():
+    for width in [32, 64, 96, 128, 256, 512]:
+        check_width(width, 100000)
+        check_width(width, 1000)
+
+def test_prbs_threads():
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    prbsTx >> prbsRx
+
+    prbsTx.setTxThreads(3)
+    prbsTx.enable(100000)
+    time.sleep(1)
+    prbsTx.disable()
+
+    if prbsRx.getRxCount() == 0 or prbsRx.getRxCount() != prbsTx.getTxCount():
+        raise AssertionError('Frame count error. Got = {} expected = {}'.format(prbsRx.getRxCount(),prbsTx.getTxCount()))
+
+    if prbsRx.getRxErrors() != 0:
+        raise AssertionError('PRBS Frame errors detected! Errors = {}'.format(prbsRx.getRxErrors()))
+
+def test_prbs_error():
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+    frames = FrameRx()
+    mast   = ris.Master()
+
+    prbsTx >> frames
+    mast >> prbsRx
+
+    for i in range(4):
+        prbsTx.genFrame(40000)
+
+    # Flip one bit deep in the third frame
+    frames.frames[2][30001] ^= 0x10
+
+    for ba in frames.frames:
+        frame = mast._reqFrame(len(ba), True)
+        frame.write(ba, 0)
+        mast._sendFrame(frame)
+
+    if prbsRx.getRxErrors() != 1 or prbsRx.getRxCount() != 3:
+        raise AssertionError('Error count error. Errors = {} count = {}'.format(prbsRx.getRxErrors(),prbsRx.getRxCount()))
+
+if __name__ == "__main__":
+    test_prbs_widths()
+    test_prbs_threads()
+    test_prbs_error()
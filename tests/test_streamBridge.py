@@ -19,14 +19,22 @@ import time
 FrameCount = 10000
 FrameSize  = 10000
 
-def data_path():
+def data_path(frameSize, bufferSize=0, coalesce=0, zeroCopy=False):
 
-    # Bridge server
-    serv = rogue.interfaces.stream.TcpServer("127.0.0.1",9000)
+    # Bridge server, sends with the header format when zero copy is set
+    serv = rogue.interfaces.stream.TcpServer("127.0.0.1",9000,zeroCopy)
 
     # Bridge client
     client = rogue.interfaces.stream.TcpClient("127.0.0.1",9000)
 
+    # Split large frames across multiple buffers
+    if bufferSize != 0:
+        serv.setFixedSize(bufferSize)
+
+    # Pack small frames into larger messages
+    if coalesce != 0:
+        serv.setCoalesce(coalesce, 1000)
+
     # PRBS
     prbsTx = rogue.utilities.Prbs()
     prbsRx = rogue.utilities.Prbs()
@@ -41,7 +49,7 @@ def data_path():
 
     print("Generating Frames")
     for _ in range(FrameCount):
-        prbsTx.genFrame(FrameSize)
+        prbsTx.genFrame(frameSize)
 
     # Wait at least 20 seconds for frames to go through
     for i in range(200):
@@ -56,10 +64,49 @@ def data_path():
     if prbsRx.getRxErrors() != 0:
         raise AssertionError('PRBS Frame errors detected! Errors = {}'.format(prbsRx.getRxErrors()))
 
+    if coalesce != 0 and client.getRxBatchAvg() <= 1.0:
+        raise AssertionError('Frames were not coalesced. Average = {}'.format(client.getRxBatchAvg()))
+
     print("Done testing")
 
+def test_stop_flush():
+
+    serv   = rogue.interfaces.stream.TcpServer("127.0.0.1",9000)
+    client = rogue.interfaces.stream.TcpClient("127.0.0.1",9000)
+
+    # Latency long enough that only stop sends the batch
+    serv.setCoalesce(65536, 10000000)
+
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    serv << prbsTx
+    prbsRx << client
+
+    time.sleep(0.5)
+
+    for _ in range(10):
+        prbsTx.genFrame(100)
+
+    serv.close()
+
+    for i in range(50):
+        if prbsRx.getRxCount() == 10:
+            break
+        time.sleep(.1)
+
+    client.close()
+
+    if prbsRx.getRxCount() != 10:
+        raise AssertionError('Pending batch was not sent on stop. Got = {} expected = 10'.format(prbsRx.getRxCount()))
+
 def test_data_path():
-    data_path()
+    data_path(FrameSize)
+    data_path(FrameSize, 0, 0, True)
+    data_path(100, 0, 0, True)
+    data_path(FrameSize, 1024, 0, True)
+    data_path(100, 0, 65536)
 
 if __name__ == "__main__":
     test_data_path()
+    test_stop_flush()
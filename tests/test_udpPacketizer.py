@@ -67,8 +67,8 @@ class RssiOutOfOrder(rogue.interfaces.stream.Slave, rogue.interfaces.stream.Mast
                 self._sendFrame(frame)
 
 
-def data_path(ver,jumbo):
-    print("Testing ver={} jumbo={}".format(ver,jumbo))
+def data_path(ver,jumbo,batch=1):
+    print("Testing ver={} jumbo={} batch={}".format(ver,jumbo,batch))
 
     # UDP Server
     serv = rogue.protocols.udp.Server(0,jumbo)
@@ -77,9 +77,13 @@ def data_path(ver,jumbo):
     # UDP Client
     client = rogue.protocols.udp.Client("127.0.0.1",port,jumbo)
 
-    # RSSI
-    sRssi = rogue.protocols.rssi.Server(serv.maxPayload())
-    cRssi = rogue.protocols.rssi.Client(client.maxPayload())
+    # Batched receive and transmit
+    serv.setBatchSize(batch)
+    client.setBatchSize(batch)
+
+    # RSSI, lock free receive queues along with batching
+    sRssi = rogue.protocols.rssi.Server(serv.maxPayload(), batch > 1)
+    cRssi = rogue.protocols.rssi.Client(client.maxPayload(), batch > 1)
 
     # Packetizer
     if ver == 1:
@@ -146,6 +150,9 @@ def data_path(ver,jumbo):
     if prbsRx.getRxErrors() != 0:
         raise AssertionError('PRBS Frame errors detected! Ver={} Jumbo={}'.format(ver,jumbo))
 
+    if batch > 1 and serv.getRxBatchCount() == 0:
+        raise AssertionError('No batched receives recorded. Ver={} Jumbo={} Batch={}'.format(ver,jumbo,batch))
+
     print("Done testing ver={} jumbo={}".format(ver,jumbo))
 
 def test_data_path():
@@ -153,6 +160,7 @@ def test_data_path():
     data_path(2,True)
     data_path(1,False)
     data_path(2,False)
+    data_path(2,True,32)
 
 if __name__ == "__main__":
     test_data_path()